@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "../core/Core.hpp"
+#include "../core/helpers/arena.hpp"
+
+/**
+ * Allocation counts of warm queries. Every query is evaluated a few times before the measurement, then each
+ * iteration reports the calls the arenas made to malloc on behalf of GMP and MPFR (arena_system_calls, zero once
+ * the free lists are warm) and the C++ allocations (new_calls), which are the answer strings the Core returns.
+ */
+namespace {
+    std::atomic<std::uint64_t> new_calls{0};
+}
+
+void *operator new(const std::size_t size) {
+    new_calls.fetch_add(1, std::memory_order_relaxed);
+    if (void *block{std::malloc(size == 0 ? 1 : size)}; block != nullptr)
+        return block;
+    throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size) { return ::operator new(size); }
+void operator delete(void *block) noexcept { std::free(block); }
+void operator delete[](void *block) noexcept { std::free(block); }
+void operator delete(void *block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void *block, std::size_t) noexcept { std::free(block); }
+
+namespace {
+    constexpr int warm_up_queries{4};
+
+    void measure(benchmark::State &state, const auto &evaluate) {
+        for (int i = 0; i < warm_up_queries; ++i)
+            evaluate();
+        std::uint64_t system_calls{0};
+        std::uint64_t allocations{0};
+        for (auto _: state) {
+            const std::uint64_t system_before{mmqli::core::arena::system_calls()};
+            const std::uint64_t new_before{new_calls.load(std::memory_order_relaxed)};
+            evaluate();
+            system_calls += mmqli::core::arena::system_calls() - system_before;
+            allocations += new_calls.load(std::memory_order_relaxed) - new_before;
+        }
+        state.counters["arena_system_calls"] = benchmark::Counter(static_cast<double>(system_calls),
+                                                                  benchmark::Counter::kAvgIterations);
+        state.counters["new_calls"] = benchmark::Counter(static_cast<double>(allocations),
+                                                         benchmark::Counter::kAvgIterations);
+    }
+
+    void allocations_real(benchmark::State &state, const std::string &query, const double first, const double second) {
+        const mmqli::core::ParsedRealQueries queries{{query, float1000{first}, float1000{second}}};
+        measure(state, [&] {
+            mmqli::core::Core core(queries, {});
+            benchmark::DoNotOptimize(core.evaluate_all());
+        });
+    }
+
+    void allocations_complex(benchmark::State &state, const std::string &query) {
+        const mmqli::core::ParsedComplexQueries queries{
+            {query, complex1000{float1000{0.5}, float1000{0.25}}, complex1000{float1000{1.5}, float1000{-0.75}}}
+        };
+        measure(state, [&] {
+            mmqli::core::Core core({}, queries);
+            benchmark::DoNotOptimize(core.evaluate_all());
+        });
+    }
+
+    void allocations_batch(benchmark::State &state, const std::string &query) {
+        std::vector<float1000> operands(64);
+        for (std::size_t i = 0; i < operands.size(); ++i)
+            operands[i] = float1000{i};
+        const mmqli::core::ParsedRealBatches batches{{query, operands, {}}};
+        measure(state, [&] {
+            mmqli::core::Core core({}, {}, batches);
+            benchmark::DoNotOptimize(core.evaluate_all());
+        });
+    }
+
+    BENCHMARK_CAPTURE(allocations_real, ADD, std::string{"ADD"}, 1.5, 2.5)->Name("Allocations/Real/ADD");
+    BENCHMARK_CAPTURE(allocations_real, SINE, std::string{"SINE"}, 30, 0)->Name("Allocations/Real/SINE");
+    BENCHMARK_CAPTURE(allocations_real, COTANGENT, std::string{"COTANGENT"}, 30, 0)->Name("Allocations/Real/COTANGENT");
+    BENCHMARK_CAPTURE(allocations_real, FACTORIAL, std::string{"FACTORIAL"}, 20, 0)->Name("Allocations/Real/FACTORIAL");
+    BENCHMARK_CAPTURE(allocations_real, LOGARITHM, std::string{"NATURAL_LOGARITHM"}, 2.5, 0)
+        ->Name("Allocations/Real/NATURAL_LOGARITHM");
+    BENCHMARK_CAPTURE(allocations_complex, MULTIPLY, std::string{"MULTIPLY"})->Name("Allocations/Complex/MULTIPLY");
+    BENCHMARK_CAPTURE(allocations_complex, SINE, std::string{"SINE"})->Name("Allocations/Complex/SINE");
+    BENCHMARK_CAPTURE(allocations_batch, SINE, std::string{"SINE"})->Name("Allocations/RealBatch/SINE");
+} // namespace
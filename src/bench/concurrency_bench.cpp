@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/helpers/ziv.hpp"
+#include "../vresolver/VResolver.hpp"
+
+/**
+ * Benchmarks of concurrent sessions. Every benchmark thread runs a session of its own through the whole pipeline,
+ * variables included, and the items per second over the thread counts show how the throughput scales. The answers of
+ * the same sessions are checked against a single thread by concurrency_test.
+ */
+namespace {
+    const std::vector<std::string> definitions{
+        "SET x = SINE 30", "SET y = 2.5", "SET z = 1+2i", "SET v = [1,2,3,4]", "SET w = ADD x,y"
+    };
+
+    // a line of every kind of query, the batch and the integral run parallel regions of their own.
+    const std::vector<std::string> lines{
+        "ADD x,w", "MULTIPLY z,z", "SUM v", "COMBINATION 40,20", "SINE [0:360:1]", "DET [[2,1],[1,3]]",
+        "NATURAL_LOGARITHM 2.5", "SINE 1+2i", "INTEGRATE SINE,[0,90]"
+    };
+
+    // the answers of a session, the way the interpreter computes them.
+    std::vector<std::string> run_session() {
+        const auto variables{find_and_resolve_vars(definitions)};
+        if (!variables)
+            return {};
+        std::vector<std::string> answers;
+        for (const std::string &line: lines) {
+            Parser parser(tokenize({line}, *variables));
+            mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums(), parser.parse_RealBatches(),
+                                   parser.parse_cmplxBatches(), parser.parse_RealMatrices(),
+                                   parser.parse_cmplxMatrices(), parser.parse_PointSets(),
+                                   parser.parse_ExactNums());
+            for (auto &result: core.evaluate())
+                answers.push_back(result ? std::move(*result) : mmqli::core::error::describe(result.error()));
+        }
+        return answers;
+    }
+
+    void BM_ConcurrentSessions(benchmark::State &state) {
+        for (auto _: state)
+            benchmark::DoNotOptimize(run_session());
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lines.size()));
+    }
+    BENCHMARK(BM_ConcurrentSessions)->ThreadRange(1, 16)->UseRealTime();
+
+    // every thread asks for its own number of digits.
+    void BM_ConcurrentDigits(benchmark::State &state) {
+        const std::size_t digits{20 + 10 * static_cast<std::size_t>(state.thread_index())};
+        const mmqli::core::ziv::ThreadDigits scope{digits};
+        const std::vector<std::string> queries{"NATURAL_LOGARITHM 2.5"};
+        for (auto _: state) {
+            Parser parser(tokenize(queries));
+            mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums());
+            benchmark::DoNotOptimize(core.evaluate());
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ConcurrentDigits)->ThreadRange(1, 16)->UseRealTime();
+} // namespace
@@ -0,0 +1,421 @@
+#include <benchmark/benchmark.h>
+#include <complex>
+#include <functional>
+#include <string>
+#include <vector>
+#include <boost/multiprecision/mpfr.hpp>
+#include "../core/Core.hpp"
+#include "../core/helpers/radix.hpp"
+#include "../core/helpers/special.hpp"
+#include "../core/helpers/ziv.hpp"
+
+/**
+ * Benchmarks of the Core: every opcode over real and complex numbers through the whole dispatch and formatting of
+ * the result, the same math kernels at several precisions, and the formatting of the results on its own.
+ *
+ * Core evaluates at the compiled precision of float1000, so the opcodes themselves are measured at 1000 digits. The
+ * kernels are measured again with a variable precision mpfr_float at 50, 200, 1000 and 10000 digits, which tells how
+ * every opcode scales with the precision. The opcodes are measured once more in the adaptive mode of the Core, which
+ * evaluates them to 20, 100 and 1000 correct digits at the smallest working precision that certifies the digits.
+ */
+namespace {
+    using boost::multiprecision::mpfr_float;
+    using VariableComplex = std::complex<mpfr_float>;
+
+    const std::vector<std::int64_t> kernel_digits{50, 200, 1000, 10000};
+    const std::vector<std::int64_t> adaptive_digits{20, 100, 1000};
+
+    mpfr_float radians(const mpfr_float &degrees) {
+        return degrees * boost::math::constants::pi<mpfr_float>() / 180;
+    }
+
+    mpfr_float degrees(const mpfr_float &radians) {
+        return radians * 180 / boost::math::constants::pi<mpfr_float>();
+    }
+
+    struct RealOpcode {
+        const char *query;
+        double first; // the operands lie in the domain of the opcode.
+        double second;
+        std::function<mpfr_float(const mpfr_float &, const mpfr_float &)> kernel;
+    };
+
+    struct ComplexOpcode {
+        const char *query;
+        std::function<VariableComplex(const VariableComplex &, const VariableComplex &)> kernel;
+    };
+
+    // the kernels follow the formulas of Core, trigonometric functions of real numbers work in degrees.
+    const std::vector<RealOpcode> real_opcodes{
+        {"ADD", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{a + b}; }},
+        {"SUBTRACT", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{a - b}; }},
+        {"MULTIPLY", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{a * b}; }},
+        {"DIVIDE", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{a / b}; }},
+        {"POWER", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{pow(a, b)}; }},
+        {"ROOT", 1.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{pow(a, 1 / b)}; }},
+        {"LOGARITHM", 100, 10, [](const auto &a, const auto &b) { return mpfr_float{log(a) / log(b)}; }},
+        {"MODULO", 7.5, 2.5, [](const auto &a, const auto &b) { return mpfr_float{fmod(a, b)}; }},
+        {"PERMUTATION", 20, 7, [](const auto &a, const auto &b) { return mpfr_float{tgamma(a + 1) / tgamma(a - b + 1)}; }},
+        {"COMBINATION", 20, 7, [](const auto &a, const auto &b) {
+            return mpfr_float{tgamma(a + 1) / (tgamma(b + 1) * tgamma(a - b + 1))};
+        }},
+        {"FACTORIAL", 20, 0, [](const auto &a, const auto &) { return mpfr_float{tgamma(a + 1)}; }},
+        {"SINE", 30, 0, [](const auto &a, const auto &) { return mpfr_float{sin(radians(a))}; }},
+        {"COSINE", 30, 0, [](const auto &a, const auto &) { return mpfr_float{cos(radians(a))}; }},
+        {"TANGENT", 30, 0, [](const auto &a, const auto &) { return mpfr_float{tan(radians(a))}; }},
+        {"SECANT", 30, 0, [](const auto &a, const auto &) { return mpfr_float{1 / cos(radians(a))}; }},
+        {"COSECANT", 30, 0, [](const auto &a, const auto &) { return mpfr_float{1 / sin(radians(a))}; }},
+        {"COTANGENT", 30, 0, [](const auto &a, const auto &) { return mpfr_float{1 / tan(radians(a))}; }},
+        {"HYP_SINE", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{sinh(a)}; }},
+        {"HYP_COSINE", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{cosh(a)}; }},
+        {"HYP_TANGENT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{tanh(a)}; }},
+        {"HYP_SECANT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{1 / cosh(a)}; }},
+        {"HYP_COSECANT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{1 / sinh(a)}; }},
+        {"HYP_COTANGENT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{1 / tanh(a)}; }},
+        {"INVERSE_SINE", 0.5, 0, [](const auto &a, const auto &) { return degrees(asin(a)); }},
+        {"INVERSE_COSINE", 0.5, 0, [](const auto &a, const auto &) { return degrees(acos(a)); }},
+        {"INVERSE_TANGENT", 0.5, 0, [](const auto &a, const auto &) { return degrees(atan(a)); }},
+        {"INVERSE_SECANT", 2, 0, [](const auto &a, const auto &) { return degrees(acos(1 / a)); }},
+        {"INVERSE_COSECANT", 2, 0, [](const auto &a, const auto &) { return degrees(asin(1 / a)); }},
+        {"INVERSE_COTANGENT", 2, 0, [](const auto &a, const auto &) { return degrees(atan(1 / a)); }},
+        {"INVERSE_HYP_SINE", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{asinh(a)}; }},
+        {"INVERSE_HYP_COSINE", 2, 0, [](const auto &a, const auto &) { return mpfr_float{acosh(a)}; }},
+        {"INVERSE_HYP_TANGENT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{atanh(a)}; }},
+        {"INVERSE_HYP_SECANT", 0.5, 0, [](const auto &a, const auto &) { return mpfr_float{acosh(1 / a)}; }},
+        {"INVERSE_HYP_COSECANT", 2, 0, [](const auto &a, const auto &) { return mpfr_float{asinh(1 / a)}; }},
+        {"INVERSE_HYP_COTANGENT", 2, 0, [](const auto &a, const auto &) { return mpfr_float{atanh(1 / a)}; }},
+        {"FLOOR", -2.5, 0, [](const auto &a, const auto &) { return mpfr_float{floor(a)}; }},
+        {"CEILING", -2.5, 0, [](const auto &a, const auto &) { return mpfr_float{ceil(a)}; }},
+        {"ABSOLUTE", -2.5, 0, [](const auto &a, const auto &) { return mpfr_float{abs(a)}; }},
+        {"NATURAL_LOGARITHM", 2.5, 0, [](const auto &a, const auto &) { return mpfr_float{log(a)}; }},
+        {"BINARY_LOGARITHM", 2.5, 0, [](const auto &a, const auto &) { return mpfr_float{log2(a)}; }},
+        {"COMMON_LOGARITHM", 2.5, 0, [](const auto &a, const auto &) { return mpfr_float{log10(a)}; }},
+    };
+
+    // the operands of every complex opcode are 0.5+0.25i and 1.5-0.75i, both in the domain of all of them.
+    const std::vector<ComplexOpcode> complex_opcodes{
+        {"ADD", [](const auto &a, const auto &b) { return VariableComplex{a + b}; }},
+        {"SUBTRACT", [](const auto &a, const auto &b) { return VariableComplex{a - b}; }},
+        {"MULTIPLY", [](const auto &a, const auto &b) { return VariableComplex{a * b}; }},
+        {"DIVIDE", [](const auto &a, const auto &b) { return VariableComplex{a / b}; }},
+        {"POWER", [](const auto &a, const auto &b) { return std::pow(a, b); }},
+        {"ROOT", [](const auto &a, const auto &b) { return std::pow(a, VariableComplex{1} / b); }},
+        {"MODULUS", [](const auto &a, const auto &) { return VariableComplex{std::abs(a)}; }},
+        {"CONJUGATE", [](const auto &a, const auto &) { return std::conj(a); }},
+        {"ARGUMENT", [](const auto &a, const auto &) { return VariableComplex{std::arg(a)}; }},
+        {"SINE", [](const auto &a, const auto &) { return std::sin(a); }},
+        {"COSINE", [](const auto &a, const auto &) { return std::cos(a); }},
+        {"TANGENT", [](const auto &a, const auto &) { return std::tan(a); }},
+        {"SECANT", [](const auto &a, const auto &) { return VariableComplex{1} / std::cos(a); }},
+        {"COSECANT", [](const auto &a, const auto &) { return VariableComplex{1} / std::sin(a); }},
+        {"COTANGENT", [](const auto &a, const auto &) { return VariableComplex{1} / std::tan(a); }},
+        {"INVERSE_SINE", [](const auto &a, const auto &) { return std::asin(a); }},
+        {"INVERSE_COSINE", [](const auto &a, const auto &) { return std::acos(a); }},
+        {"INVERSE_TANGENT", [](const auto &a, const auto &) { return std::atan(a); }},
+        {"INVERSE_SECANT", [](const auto &a, const auto &) { return std::acos(VariableComplex{1} / a); }},
+        {"INVERSE_COSECANT", [](const auto &a, const auto &) { return std::asin(VariableComplex{1} / a); }},
+        {"INVERSE_COTANGENT", [](const auto &a, const auto &) { return std::atan(VariableComplex{1} / a); }},
+        {"HYP_SINE", [](const auto &a, const auto &) { return std::sinh(a); }},
+        {"HYP_COSINE", [](const auto &a, const auto &) { return std::cosh(a); }},
+        {"HYP_TANGENT", [](const auto &a, const auto &) { return std::tanh(a); }},
+        {"HYP_SECANT", [](const auto &a, const auto &) { return VariableComplex{1} / std::cosh(a); }},
+        {"HYP_COSECANT", [](const auto &a, const auto &) { return VariableComplex{1} / std::sinh(a); }},
+        {"HYP_COTANGENT", [](const auto &a, const auto &) { return VariableComplex{1} / std::tanh(a); }},
+        {"INVERSE_HYP_SINE", [](const auto &a, const auto &) { return std::asinh(a); }},
+        {"INVERSE_HYP_COSINE", [](const auto &a, const auto &) { return std::acosh(a); }},
+        {"INVERSE_HYP_TANGENT", [](const auto &a, const auto &) { return std::atanh(a); }},
+        {"INVERSE_HYP_SECANT", [](const auto &a, const auto &) { return std::acosh(VariableComplex{1} / a); }},
+        {"INVERSE_HYP_COSECANT", [](const auto &a, const auto &) { return std::asinh(VariableComplex{1} / a); }},
+        {"INVERSE_HYP_COTANGENT", [](const auto &a, const auto &) { return std::atanh(VariableComplex{1} / a); }},
+        {"NATURAL_LOGARITHM", [](const auto &a, const auto &) { return std::log(a); }},
+        {"POWER_E", [](const auto &a, const auto &) { return std::exp(a); }},
+    };
+
+    // the special functions have no kernel of their own in Boost at these precisions, only the Core is measured.
+    const std::vector<RealOpcode> special_opcodes{
+        {"GAMMA", 2.75, 0, nullptr}, {"LOG_GAMMA", 2.75, 0, nullptr}, {"DIGAMMA", 2.75, 0, nullptr},
+        {"ZETA", 2.75, 0, nullptr}, {"ERROR_FUNCTION", 2.75, 0, nullptr},
+        {"COMPLEMENTARY_ERROR_FUNCTION", 2.75, 0, nullptr}, {"BESSEL_J", 2, 2.75, nullptr},
+        {"BESSEL_Y", 2, 2.75, nullptr}, {"INCOMPLETE_GAMMA", 1.5, 2.75, nullptr},
+    };
+
+    const complex1000 first_complex{float1000{0.5}, float1000{0.25}};
+    const complex1000 second_complex{float1000{1.5}, float1000{-0.75}};
+
+    void core_real(benchmark::State &state, const RealOpcode &opcode) {
+        const mmqli::core::ParsedRealQueries queries{{opcode.query, float1000{opcode.first}, float1000{opcode.second}}};
+        for (auto _: state) {
+            mmqli::core::Core core(queries, {});
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    void adaptive_real(benchmark::State &state, const RealOpcode &opcode) {
+        mmqli::core::ziv::set_digits(static_cast<std::size_t>(state.range(0)));
+        core_real(state, opcode);
+        mmqli::core::ziv::set_digits(0);
+    }
+
+    void core_complex(benchmark::State &state, const ComplexOpcode &opcode) {
+        const mmqli::core::ParsedComplexQueries queries{{opcode.query, first_complex, second_complex}};
+        for (auto _: state) {
+            mmqli::core::Core core({}, queries);
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    void kernel_real(benchmark::State &state, const RealOpcode &opcode) {
+        mpfr_float::default_precision(static_cast<unsigned>(state.range(0)));
+        const mpfr_float first{opcode.first};
+        const mpfr_float second{opcode.second};
+        for (auto _: state)
+            benchmark::DoNotOptimize(opcode.kernel(first, second));
+    }
+
+    void kernel_complex(benchmark::State &state, const ComplexOpcode &opcode) {
+        mpfr_float::default_precision(static_cast<unsigned>(state.range(0)));
+        const VariableComplex first{mpfr_float{0.5}, mpfr_float{0.25}};
+        const VariableComplex second{mpfr_float{1.5}, mpfr_float{-0.75}};
+        for (auto _: state)
+            benchmark::DoNotOptimize(opcode.kernel(first, second));
+    }
+
+    const bool opcodes_registered{
+        [] {
+            for (const auto &opcode: real_opcodes) {
+                const std::string name{opcode.query};
+                benchmark::RegisterBenchmark(("Core/Real/" + name).c_str(), core_real, opcode);
+                benchmark::RegisterBenchmark(("Kernel/Real/" + name).c_str(), kernel_real, opcode)
+                        ->ArgName("digits")->ArgsProduct({kernel_digits});
+                benchmark::RegisterBenchmark(("Adaptive/Real/" + name).c_str(), adaptive_real, opcode)
+                        ->ArgName("digits")->ArgsProduct({adaptive_digits});
+            }
+            for (const auto &opcode: special_opcodes) {
+                const std::string name{opcode.query};
+                benchmark::RegisterBenchmark(("Core/Special/" + name).c_str(), core_real, opcode);
+                benchmark::RegisterBenchmark(("Adaptive/Special/" + name).c_str(), adaptive_real, opcode)
+                        ->ArgName("digits")->ArgsProduct({adaptive_digits});
+            }
+            for (const auto &opcode: complex_opcodes) {
+                const std::string name{opcode.query};
+                benchmark::RegisterBenchmark(("Core/Complex/" + name).c_str(), core_complex, opcode);
+                benchmark::RegisterBenchmark(("Kernel/Complex/" + name).c_str(), kernel_complex, opcode)
+                        ->ArgName("digits")->ArgsProduct({kernel_digits});
+            }
+            return true;
+        }()
+    };
+
+    struct ExponentCase {
+        const char *name;
+        const char *query;
+        complex1000 base;
+        complex1000 exponent;
+    };
+
+    // POWER and ROOT over every class of exponent, from the integers to the general complex pow.
+    const std::vector<ExponentCase> exponent_cases{
+        {"Real/POWER/integer", "POWER", {float1000{1.5}, float1000{0}}, {float1000{7}, float1000{0}}},
+        {"Real/POWER/half", "POWER", {float1000{1.5}, float1000{0}}, {float1000{0.5}, float1000{0}}},
+        {"Real/POWER/general", "POWER", {float1000{1.5}, float1000{0}}, {float1000{2.5}, float1000{0}}},
+        {"Real/ROOT/integer", "ROOT", {float1000{1.5}, float1000{0}}, {float1000{5}, float1000{0}}},
+        {"Real/ROOT/general", "ROOT", {float1000{1.5}, float1000{0}}, {float1000{2.5}, float1000{0}}},
+        {"Complex/POWER/integer", "POWER", first_complex, {float1000{7}, float1000{0}}},
+        {"Complex/POWER/real", "POWER", first_complex, {float1000{2.5}, float1000{0}}},
+        {"Complex/POWER/complex", "POWER", first_complex, second_complex},
+        {"Complex/ROOT/integer", "ROOT", first_complex, {float1000{5}, float1000{0}}},
+        {"Complex/ROOT/complex", "ROOT", first_complex, second_complex},
+    };
+
+    void core_exponent(benchmark::State &state, const ExponentCase &exponent_case) {
+        const bool real{exponent_case.base.imag() == 0};
+        const mmqli::core::ParsedRealQueries real_queries{
+            {exponent_case.query, exponent_case.base.real(), exponent_case.exponent.real()}
+        };
+        const mmqli::core::ParsedComplexQueries complex_queries{
+            {exponent_case.query, exponent_case.base, exponent_case.exponent}
+        };
+        for (auto _: state) {
+            mmqli::core::Core core(real ? real_queries : mmqli::core::ParsedRealQueries{},
+                                   real ? mmqli::core::ParsedComplexQueries{} : complex_queries);
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    const bool exponents_registered{
+        [] {
+            for (const auto &exponent_case: exponent_cases)
+                benchmark::RegisterBenchmark((std::string{"Exponent/"} + exponent_case.name).c_str(), core_exponent,
+                                             exponent_case);
+            return true;
+        }()
+    };
+
+    struct ExactCase {
+        const char *name;
+        const char *query;
+        long first;
+        long second;
+    };
+
+    // queries over integers, answered exactly by GMP and, written as real numbers, by float1000 and gamma.
+    const std::vector<ExactCase> exact_cases{
+        {"ADD", "ADD", 1234567890123, 987654321}, {"MODULO", "MODULO", 1234567890123, 97},
+        {"POWER", "POWER", 3, 200}, {"FACTORIAL/50", "FACTORIAL", 50, 0}, {"FACTORIAL/400", "FACTORIAL", 400, 0},
+        {"COMBINATION", "COMBINATION", 60, 30}, {"PERMUTATION", "PERMUTATION", 60, 30},
+    };
+
+    void core_exact(benchmark::State &state, const ExactCase &exact_case) {
+        const mmqli::core::ParsedExactQueries queries{
+            {exact_case.query, mpq_class{exact_case.first}, mpq_class{exact_case.second}}
+        };
+        for (auto _: state) {
+            mmqli::core::Core core({}, {}, {}, {}, {}, {}, {}, queries);
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    void core_float(benchmark::State &state, const ExactCase &exact_case) {
+        const mmqli::core::ParsedRealQueries queries{
+            {exact_case.query, float1000{exact_case.first}, float1000{exact_case.second}}
+        };
+        for (auto _: state) {
+            mmqli::core::Core core(queries, {});
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    const bool exact_registered{
+        [] {
+            for (const auto &exact_case: exact_cases) {
+                const std::string name{exact_case.name};
+                benchmark::RegisterBenchmark(("Exact/Integer/" + name).c_str(), core_exact, exact_case);
+                benchmark::RegisterBenchmark(("Exact/Float/" + name).c_str(), core_float, exact_case);
+            }
+            return true;
+        }()
+    };
+
+    struct FusedCase {
+        const char *query;
+        double operand;
+        std::vector<const char *> members; // the separate queries the fused one answers
+    };
+
+    // every fused query against the separate queries of its family, over the same operand.
+    const std::vector<FusedCase> fused_cases{
+        {"TRIG_ALL", 30.5, {"SINE", "COSINE", "TANGENT", "SECANT", "COSECANT", "COTANGENT"}},
+        {"HYP_ALL", 0.75, {"HYP_SINE", "HYP_COSINE", "HYP_TANGENT", "HYP_SECANT", "HYP_COSECANT", "HYP_COTANGENT"}},
+        {"LOG_ALL", 2.5, {"NATURAL_LOGARITHM", "BINARY_LOGARITHM", "COMMON_LOGARITHM"}},
+    };
+
+    void core_fused(benchmark::State &state, const FusedCase &fused_case) {
+        const mmqli::core::ParsedRealQueries queries{{fused_case.query, float1000{fused_case.operand}, float1000{0}}};
+        for (auto _: state) {
+            mmqli::core::Core core(queries, {});
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    void core_separate(benchmark::State &state, const FusedCase &fused_case) {
+        mmqli::core::ParsedRealQueries queries;
+        for (const char *member: fused_case.members)
+            queries.emplace_back(member, float1000{fused_case.operand}, float1000{0});
+        for (auto _: state) {
+            mmqli::core::Core core(queries, {});
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+
+    const bool fused_registered{
+        [] {
+            for (const auto &fused_case: fused_cases) {
+                const std::string name{fused_case.query};
+                benchmark::RegisterBenchmark(("Fused/" + name).c_str(), core_fused, fused_case);
+                benchmark::RegisterBenchmark(("Separate/" + name).c_str(), core_separate, fused_case);
+            }
+            return true;
+        }()
+    };
+
+    // zeta of a non-integer by the shared table of its precision against mpfr_zeta, which builds its own every call.
+    void BM_ZetaTable(benchmark::State &state) {
+        const float1000 s{2.75};
+        float1000 y;
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::special::zeta(y.backend().data(), s.backend().data()));
+    }
+    BENCHMARK(BM_ZetaTable);
+
+    void BM_ZetaMpfr(benchmark::State &state) {
+        const float1000 s{2.75};
+        float1000 y;
+        for (auto _: state)
+            benchmark::DoNotOptimize(mpfr_zeta(y.backend().data(), s.backend().data(), MPFR_RNDN));
+    }
+    BENCHMARK(BM_ZetaMpfr)->Unit(benchmark::kMillisecond);
+
+    void BM_ToStrReal(benchmark::State &state) {
+        const float1000 real{boost::math::constants::pi<float1000>()};
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::Core::to_str(real));
+    }
+    BENCHMARK(BM_ToStrReal);
+
+    void BM_ToStrComplex(benchmark::State &state) {
+        const complex1000 complex{boost::math::constants::pi<float1000>(), -boost::math::constants::e<float1000>()};
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::Core::to_str(complex));
+    }
+    BENCHMARK(BM_ToStrComplex);
+
+    void BM_ToStrBatch(benchmark::State &state) {
+        std::vector<float1000> batch(static_cast<std::size_t>(state.range(0)));
+        for (std::size_t i = 0; i < batch.size(); ++i)
+            batch[i] = sqrt(float1000{i + 2});
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::Core::to_str(batch));
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ToStrBatch)->ArgName("elements")->RangeMultiplier(8)->Range(8, 512);
+
+    void BM_ToStrDouble(benchmark::State &state) {
+        const std::vector<double> batch(static_cast<std::size_t>(state.range(0)), 3.141592653589793);
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::Core::to_str(batch));
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ToStrDouble)->ArgName("elements")->RangeMultiplier(8)->Range(8, 4096);
+
+    // the decimal digits of a random integer of range(0) digits, streamed to a sink against GMP's one string.
+    mpz_class random_integer(const std::size_t digits) {
+        gmp_randclass random(gmp_randinit_default);
+        mpz_class bound;
+        mpz_ui_pow_ui(bound.get_mpz_t(), 10, digits);
+        return random.get_z_range(bound);
+    }
+
+    void BM_RadixWrite(benchmark::State &state) {
+        const mpz_class n{random_integer(static_cast<std::size_t>(state.range(0)))};
+        for (auto _: state) {
+            std::size_t written{0};
+            mmqli::core::radix::write(n.get_mpz_t(), [&written](const std::string_view digits) { written += digits.size(); });
+            benchmark::DoNotOptimize(written);
+        }
+    }
+    BENCHMARK(BM_RadixWrite)->ArgName("digits")->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+
+    void BM_GmpGetStr(benchmark::State &state) {
+        const mpz_class n{random_integer(static_cast<std::size_t>(state.range(0)))};
+        for (auto _: state)
+            benchmark::DoNotOptimize(n.get_str(10));
+    }
+    BENCHMARK(BM_GmpGetStr)->ArgName("digits")->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+
+    void BM_RadixRead(benchmark::State &state) {
+        const std::string digits{random_integer(static_cast<std::size_t>(state.range(0))).get_str(10)};
+        for (auto _: state)
+            benchmark::DoNotOptimize(mmqli::core::radix::integer(digits));
+    }
+    BENCHMARK(BM_RadixRead)->ArgName("digits")->RangeMultiplier(10)->Range(10'000, 1'000'000)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+#include "../core/helpers/dense.hpp"
+
+/**
+ * Scaling of the blocked dense kernels (tiled product and LU factorization) with the size of the matrix, the
+ * precision and the number of workers, from one up to the configured count of @code MMQLC_THREADS @endcode. The
+ * wall clock time is reported, the CPU time of the calling thread says nothing about the other workers.
+ */
+namespace {
+    namespace Dense = mmqli::core::dense;
+    namespace Parallel = mmqli::core::parallel;
+
+    mpfr_prec_t bits_for(const std::int64_t digits) {
+        return static_cast<mpfr_prec_t>(std::ceil(static_cast<double>(digits) * 3.3219280948873623)) + 16;
+    }
+
+    // a diagonally dominant matrix, so the factorization never meets a zero pivot.
+    Dense::DenseMatrix test_matrix(const std::size_t n, const mpfr_prec_t bits) {
+        Dense::DenseMatrix matrix(n, n, bits);
+        for (std::size_t row = 0; row < n; ++row)
+            for (std::size_t col = 0; col < n; ++col)
+                mpfr_set_d(matrix(row, col), row == col ? 2.0 * static_cast<double>(n) : 1.0 / static_cast<double>(row + col + 1), MPFR_RNDN);
+        return matrix;
+    }
+
+    // 1, 2, 4, ... workers and the configured count.
+    std::vector<std::int64_t> worker_steps() {
+        std::vector<std::int64_t> steps;
+        const auto configured{static_cast<std::int64_t>(Parallel::worker_count())};
+        for (std::int64_t workers = 1; workers < configured; workers *= 2)
+            steps.push_back(workers);
+        steps.push_back(configured);
+        return steps;
+    }
+
+    void BM_DenseMultiply(benchmark::State &state) {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const Dense::DenseMatrix left{test_matrix(n, bits_for(state.range(1)))};
+        const Dense::DenseMatrix right{test_matrix(n, bits_for(state.range(1)))};
+        Parallel::limit_workers(static_cast<std::size_t>(state.range(2)));
+        for (auto _: state)
+            benchmark::DoNotOptimize(Dense::multiply(left, right));
+        Parallel::limit_workers(0);
+        state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) * state.range(0));
+    }
+
+    void BM_DenseLU(benchmark::State &state) {
+        const auto n{static_cast<std::size_t>(state.range(0))};
+        const Dense::DenseMatrix matrix{test_matrix(n, bits_for(state.range(1)))};
+        Parallel::limit_workers(static_cast<std::size_t>(state.range(2)));
+        for (auto _: state)
+            benchmark::DoNotOptimize(Dense::lu_decompose(matrix));
+        Parallel::limit_workers(0);
+        state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) * state.range(0) / 3);
+    }
+
+    const bool dense_registered{
+        [] {
+            const std::vector<std::int64_t> workers{worker_steps()};
+            benchmark::RegisterBenchmark("Dense/Multiply", BM_DenseMultiply)
+                    ->ArgNames({"n", "digits", "workers"})
+                    ->ArgsProduct({{64, 256}, {100, 1000}, workers})
+                    ->UseRealTime()
+                    ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark("Dense/LU", BM_DenseLU)
+                    ->ArgNames({"n", "digits", "workers"})
+                    ->ArgsProduct({{64, 256}, {100, 1000}, workers})
+                    ->UseRealTime()
+                    ->Unit(benchmark::kMillisecond);
+            return true;
+        }()
+    };
+} // namespace
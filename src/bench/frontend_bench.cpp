@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../vresolver/VResolver.hpp"
+
+/**
+ * Benchmarks of the front end: the regex cascade of the lexer for every shape of query, the conversion of the
+ * literals by the Parser as they grow longer, and the resolution of variables, which runs the whole pipeline.
+ */
+namespace {
+    using Tokens = std::vector<std::tuple<std::string, std::string, std::string> >;
+
+    const std::unordered_map<std::string, std::string> variables{{"x", "1.5"}, {"y", "2.5"}, {"z", "1+2i"}};
+
+    // one query of every shape the lexer tells apart, named after the shape.
+    const std::vector<std::pair<std::string, std::string> > query_shapes{
+        {"RealSingle", "SINE 30"},
+        {"RealDouble", "ADD 1.5,2.5"},
+        {"RealVariables", "ADD x,y"},
+        {"ComplexSingle", "SINE 1+2i"},
+        {"ComplexDouble", "MULTIPLY 1+2i,3-4i"},
+        {"ComplexVariable", "SINE z"},
+        {"List", "SINE [0,30,45,60,90]"},
+        {"Range", "SINE [0:360:1]"},
+        {"Matrix", "DET [[2,1],[1,3]]"},
+        {"Integral", "INTEGRATE SINE,[0,90]"},
+        {"Constant", "CONSTANT PI,100"},
+        {"Definition", "SET w = 5"},
+    };
+
+    void tokenize_query(benchmark::State &state, const std::string &query) {
+        const std::vector<std::string> queries{query};
+        for (auto _: state)
+            benchmark::DoNotOptimize(tokenize(queries, variables));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    const bool tokenize_registered{
+        [] {
+            for (const auto &[shape, query]: query_shapes)
+                benchmark::RegisterBenchmark(("Tokenize/" + shape).c_str(), tokenize_query, query);
+            return true;
+        }()
+    };
+
+    // a number of @p digits significant digits, none of them zero.
+    std::string number_literal(const std::size_t digits) {
+        std::string literal{"1."};
+        for (std::size_t i = 1; i < digits; ++i)
+            literal += static_cast<char>('1' + i % 9);
+        return literal;
+    }
+
+    // a list of @p elements numbers, written the way they are usually typed.
+    std::string list_literal(const std::size_t elements) {
+        std::string literal{"["};
+        for (std::size_t i = 0; i < elements; ++i)
+            literal += std::to_string(i) + ".25,";
+        literal.back() = ']';
+        return literal;
+    }
+
+    std::string matrix_literal(const std::size_t n) {
+        std::string literal{"["};
+        for (std::size_t row = 0; row < n; ++row) {
+            literal += '[';
+            for (std::size_t col = 0; col < n; ++col)
+                literal += std::to_string(row * n + col + 1) + ".5,";
+            literal.back() = ']';
+            literal += ',';
+        }
+        literal.back() = ']';
+        return literal;
+    }
+
+    void BM_ParseReal(benchmark::State &state) {
+        const std::string literal{number_literal(static_cast<std::size_t>(state.range(0)))};
+        const Tokens tokens{{"ADD", literal, literal}};
+        for (auto _: state) {
+            Parser parser(tokens);
+            benchmark::DoNotOptimize(parser.parse_RealNums());
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(2 * literal.size()));
+    }
+    BENCHMARK(BM_ParseReal)->ArgName("digits")->Arg(10)->Arg(100)->Arg(1000);
+
+    void BM_ParseComplex(benchmark::State &state) {
+        const std::string part{number_literal(static_cast<std::size_t>(state.range(0)))};
+        const std::string literal{part + "+" + part + "i"};
+        const Tokens tokens{{"ADD", literal, literal}};
+        for (auto _: state) {
+            Parser parser(tokens);
+            benchmark::DoNotOptimize(parser.parse_cmplxNums());
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(2 * literal.size()));
+    }
+    BENCHMARK(BM_ParseComplex)->ArgName("digits")->Arg(10)->Arg(100)->Arg(1000);
+
+    void BM_ParseList(benchmark::State &state) {
+        const std::string literal{list_literal(static_cast<std::size_t>(state.range(0)))};
+        const Tokens tokens{{"SINE", literal, ""}};
+        for (auto _: state) {
+            Parser parser(tokens);
+            benchmark::DoNotOptimize(parser.parse_RealBatches());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ParseList)->ArgName("elements")->RangeMultiplier(8)->Range(8, 4096);
+
+    void BM_ParseMatrix(benchmark::State &state) {
+        const std::string literal{matrix_literal(static_cast<std::size_t>(state.range(0)))};
+        const Tokens tokens{{"DET", literal, ""}};
+        for (auto _: state) {
+            Parser parser(tokens);
+            benchmark::DoNotOptimize(parser.parse_RealMatrices());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+    }
+    BENCHMARK(BM_ParseMatrix)->ArgName("n")->RangeMultiplier(4)->Range(4, 64);
+
+    // the definitions are resolved in order, every one of them but the literal evaluates a query.
+    void resolve_definitions(benchmark::State &state, const std::vector<std::string> &definitions) {
+        for (auto _: state)
+            benchmark::DoNotOptimize(find_and_resolve_vars(definitions));
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(definitions.size()));
+    }
+    BENCHMARK_CAPTURE(resolve_definitions, Literal, std::vector<std::string>{"SET x = 2.5"});
+    BENCHMARK_CAPTURE(resolve_definitions, Query, std::vector<std::string>{"SET x = SINE 30"});
+    BENCHMARK_CAPTURE(resolve_definitions, Chained,
+                      std::vector<std::string>{"SET x = 2.5", "SET y = SINE 30", "SET z = ADD x,y"});
+    BENCHMARK_CAPTURE(resolve_definitions, Matrix, std::vector<std::string>{"SET A = [[2,1],[1,3]]"});
+
+    // a variable is defined, then used by a query, the way the interpreter runs a session.
+    void BM_VariableRoundTrip(benchmark::State &state) {
+        for (auto _: state) {
+            const auto resolved{find_and_resolve_vars({"SET x = SINE 30"})};
+            Parser parser({"MULTIPLY x,x"}, *resolved);
+            mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums());
+            benchmark::DoNotOptimize(core.evaluate_all());
+        }
+    }
+    BENCHMARK(BM_VariableRoundTrip);
+} // namespace
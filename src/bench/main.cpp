@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../core/helpers/arena.hpp"
+#include "../core/helpers/parallel.hpp"
+#include "../core/helpers/precision.hpp"
+
+/**
+ * The entry point of mmql_bench. It takes the usual Google Benchmark flags, but writes JSON to the standard output
+ * unless @code --benchmark_format @endcode asks for another format, so the output of two builds can be diffed
+ * directly or compared with the compare.py tool of Google Benchmark.
+ */
+int main(int argc, char **argv) {
+    mmqli::core::arena::install(); // before any number is created, as in mmqlc
+    std::vector<char *> arguments(argv, argv + argc);
+    bool format_requested{false};
+    for (const char *argument: arguments)
+        format_requested = format_requested || std::string_view{argument}.starts_with("--benchmark_format");
+    static char json_format[]{"--benchmark_format=json"};
+    if (!format_requested)
+        arguments.push_back(json_format);
+    int count{static_cast<int>(arguments.size())};
+    arguments.push_back(nullptr);
+
+    benchmark::Initialize(&count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+        return 1;
+    benchmark::AddCustomContext("mmqlc_threads", std::to_string(mmqli::core::parallel::worker_count()));
+    benchmark::AddCustomContext("float1000_bits", std::to_string(mmqli::core::precision::float1000_bits));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,9 +1,191 @@
 #include "CLInterface.hpp"
 #include "../vresolver/VResolver.hpp"
+#include "../core/helpers/plugins.hpp"
+#include "../core/helpers/ziv.hpp"
+#include "../core/helpers/wire.hpp"
+#include "../core/helpers/columnar.hpp"
+#include "../core/helpers/parallel.hpp"
+#include "../core/helpers/snapshot.hpp"
+#include "../core/helpers/result_cache.hpp"
+#include "../core/helpers/cancel.hpp"
 #include "fmt/color.h"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <limits>
+#include <iostream>
+#include <sstream>
+
+namespace Profiler = mmqli::core::profiler;
+namespace Errors = mmqli::core::error;
+namespace Plugins = mmqli::core::plugins;
+namespace Ziv = mmqli::core::ziv;
+namespace Wire = mmqli::core::wire;
+namespace Columnar = mmqli::core::columnar;
+namespace Parallel = mmqli::core::parallel;
+namespace Snapshot = mmqli::core::snapshot;
+namespace ResultCache = mmqli::core::result_cache;
+namespace Cancel = mmqli::core::cancel;
+
+namespace {
+    /**
+     * @brief The answers of a line of queries: the errors of the lexer and the parser when there are some, the results
+     * of the core otherwise, with their values when they are kept.
+     */
+    struct Answers {
+        std::vector<Errors::Error> errors;
+        std::vector<Errors::Result<std::string>> results;
+        std::vector<Wire::Value> values;
+    };
+
+    // the answers kept on disk across runs, opened by --cache.
+    std::unique_ptr<ResultCache::ResultCache> result_cache;
+
+    // true while the interpreter evaluates a line, Ctrl-C then cancels the running query instead of ending mmqlc.
+    std::atomic<bool> evaluating{false};
+
+    /**
+     * @brief The handler of Ctrl-C in the interpreter. It cancels the query being evaluated and keeps the session, a
+     * second Ctrl-C before the line is answered, or one at the prompt, ends mmqlc as usual.
+     */
+    void on_interrupt(int) {
+        if (evaluating.exchange(false)) {
+            Cancel::interrupt();
+            return;
+        }
+        std::signal(SIGINT, SIG_DFL);
+        std::raise(SIGINT);
+    }
+
+    /**
+     * @brief The key of the answers of @p tokenized in the cache: the digits and the tokens, whose operands hold the
+     * values of the variables. Empty when the answers are not cached: a query that cannot be tokenized, or one that
+     * reads a file or calls a plugin function, either of which may change from run to run.
+     */
+    std::string cache_key(const TokenizedQueries &tokenized) {
+        if (!tokenized.errors.empty())
+            return {};
+        std::string key{std::to_string(Ziv::digits())};
+        for (const auto &[keyword, first, second]: tokenized.tokens) {
+            if (first.find('@') != std::string::npos || second.find('@') != std::string::npos)
+                return {};
+            // INTEGRATE and CONSTANT keep the name of their function or constant with the keyword.
+            std::istringstream words{keyword};
+            for (std::string word; words >> word;)
+                if (Plugins::find(word, Plugins::Kind::real) != nullptr ||
+                    Plugins::find(word, Plugins::Kind::complex) != nullptr)
+                    return {};
+            key += '\n';
+            key += keyword;
+            key += '\x1f';
+            key += first;
+            key += '\x1f';
+            key += second;
+        }
+        return key;
+    }
+
+    Answers answer(const std::string &query, const std::unordered_map<std::string, std::string> &variables,
+                   const bool keep_values) {
+        Answers answers;
+        auto token = tokenize({query}, variables);
+        // the binary output carries values, the cache only holds the answer strings.
+        const std::string key{result_cache && !keep_values ? cache_key(token) : std::string{}};
+        if (!key.empty()) {
+            const Profiler::Scope timer{"stage", "cache"};
+            if (auto cached{result_cache->lookup(key)}) {
+                for (std::string &text: *cached)
+                    answers.results.emplace_back(std::move(text));
+                return answers;
+            }
+        }
+        const auto core{[&]() {
+            const Profiler::Scope timer{"stage", "parse"};
+            const auto parse_ptr = std::make_unique<Parser>(std::move(token));
+            answers.errors = parse_ptr->parse_Errors();
+            auto parsed{std::make_unique<mmqli::core::Core>(
+                parse_ptr->parse_RealNums(), parse_ptr->parse_cmplxNums(),
+                parse_ptr->parse_RealBatches(), parse_ptr->parse_cmplxBatches(),
+                parse_ptr->parse_RealMatrices(), parse_ptr->parse_cmplxMatrices(),
+                parse_ptr->parse_PointSets(), parse_ptr->parse_ExactNums())};
+            parsed->locate(parse_ptr->parse_Sources());
+            return parsed;
+        }()};
+        if (!answers.errors.empty())
+            return answers;
+        if (keep_values)
+            core->keep_values();
+        answers.results = core->evaluate();
+        answers.values = core->take_values();
+        // only the lines answered without an error are kept, an error is cheap to find again.
+        if (!key.empty() && std::ranges::all_of(answers.results, [](const auto &result) { return result.has_value(); })) {
+            std::vector<std::string> texts;
+            texts.reserve(answers.results.size());
+            for (const auto &result: answers.results)
+                texts.push_back(*result);
+            result_cache->store(key, texts);
+        }
+        return answers;
+    }
+
+    /**
+     * @brief Evaluates a query decoded from a binary frame, its operands skip the lexer and the parser.
+     */
+    Answers answer(Wire::Query &&query) {
+        Answers answers;
+        using namespace mmqli::core;
+        const auto operand{
+            [&]<typename T>(const std::size_t index, const T &absent) {
+                return index < query.operands.size() ? std::get<T>(std::move(query.operands[index])) : absent;
+            }
+        };
+        const auto core{[&]() {
+            switch (query.kind) {
+                case Wire::Kind::real:
+                    return Core{{{query.keyword, operand(0, float1000{}), operand(1, float1000{})}}, {}};
+                case Wire::Kind::complex:
+                    return Core{{}, {{query.keyword, operand(0, complex1000{}), operand(1, complex1000{})}}};
+                case Wire::Kind::real_batch:
+                    return Core{{}, {}, {{query.keyword, operand(0, std::vector<float1000>{}),
+                                          operand(1, std::vector<float1000>{})}}};
+                default:
+                    return Core{{}, {}, {}, {{query.keyword, operand(0, std::vector<complex1000>{}),
+                                              operand(1, std::vector<complex1000>{})}}};
+            }
+        }};
+        Core evaluated{core()};
+        evaluated.keep_values();
+        answers.results = evaluated.evaluate();
+        answers.values = evaluated.take_values();
+        return answers;
+    }
+
+    // the text of a result, without the query and its operands.
+    std::string_view result_text(const std::string &result) {
+        std::string_view text{result};
+        text.remove_prefix(std::min(text.size(), result.find('=') + 2));
+        if (text.ends_with('\n'))
+            text.remove_suffix(1);
+        return text;
+    }
+
+    // the text of a value, empty when it only exists as text.
+    std::string value_text(const Wire::Value &value) {
+        return std::visit([]<typename T>(const T &v) -> std::string {
+            if constexpr (std::is_same_v<T, std::monostate>)
+                return {};
+            else
+                return mmqli::core::Core::to_str(v);
+        }, value);
+    }
+}
 
 #if WIN32
 #include <windows.h>
+#include <fcntl.h>
+#include <io.h>
 
 /**
  * @name enable_virtual_terminal_processing
@@ -46,15 +228,105 @@ void mmqli::cli::CLInterface::print_copyright_notice() noexcept {
  */
 void mmqli::cli::CLInterface::show_help_message() {
     fmt::println("Usage: mmqlc <[OPTION]> (binary can be started without any options)");
-    fmt::println("Options:\n{} {}\n{} {}",
+    fmt::println("Options:\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}\n{} {}",
                  "--help",
                  "show this screen",
                  "--version",
-                 "show version and copyright details"
+                 "show version and copyright details",
+                 "--profile",
+                 "time every stage and every query, the table is printed at exit",
+                 "--trace <file>",
+                 "write the timings to <file> as Chrome trace events",
+                 "--plugin <path>",
+                 "load the functions of the plugin at <path>, can be given more than once",
+                 "--digits <n>",
+                 "answer the real queries with <n> correct digits, the working precision adapts to each query",
+                 "--input <text|binary>",
+                 "read query lines, or binary query frames, from the standard input without the prompt",
+                 "--output <text|json|binary>",
+                 "write the answers as text lines, JSON Lines, or binary result frames carrying the MPFR values",
+                 "--chain <keyword>",
+                 "with --input binary, evaluate <keyword> over the values of the result frames of another mmqlc",
+                 "--map <template>",
+                 "with --input <file>, evaluate a query such as \"COMBINATION $1,$2\" over every row of a CSV or TSV file",
+                 "--cache",
+                 "keep the answers on disk and reuse them in the next runs, in MMQLC_CACHE_DIR or ~/.cache/mmqlc/results",
+                 "--cache-limit <MiB>",
+                 "evict the answers used least recently once the cache outgrows <MiB>, 256 by default",
+                 "--cache-stats",
+                 "use the cache and report its hits, misses and size at exit",
+                 "--timeout <ms>",
+                 "cancel a query still running after <ms> milliseconds, the other queries are answered",
+                 "--memory-limit <MiB>",
+                 "reject the queries estimated to need more than <MiB> of memory before they are evaluated"
     );
     exit(EXIT_SUCCESS);
 }
 
+/**
+ * @brief This prints a query that could not be answered, the session goes on with the next query.
+ */
+void mmqli::cli::CLInterface::print_error(const Errors::Error &error) {
+    fmt::print(fg(fmt::color::white) | fmt::emphasis::bold, "mmqlc: ");
+    fmt::print(fg(fmt::color::red), "error: ");
+    fmt::println("{}", Errors::describe(error));
+}
+
+/**
+ * @brief This sets the number of correct digits of the real queries from @p value, a positive count or "off".
+ * @return false when @p value is neither, the error is printed.
+ */
+bool mmqli::cli::CLInterface::set_digits(const std::string &value) {
+    if (value == "off") {
+        Ziv::set_digits(0);
+        return true;
+    }
+    std::size_t digits{0};
+    const auto [end, failure]{std::from_chars(value.data(), value.data() + value.size(), digits)};
+    if (failure != std::errc{} || end != value.data() + value.size() || digits == 0 || digits > Ziv::largest_digits) {
+        print_error({Errors::Code::invalid_number, {}, "The digits must be a count from 1 to " +
+                                                       std::to_string(Ziv::largest_digits) + " or off !"});
+        return false;
+    }
+    Ziv::set_digits(digits);
+    return true;
+}
+
+/**
+ * @brief This prints the timings recorded so far, one row per pipeline stage and per query, the durations of the
+ * stages of a query include the ones of its nested stages.
+ */
+void mmqli::cli::CLInterface::print_profile() {
+    if (!Profiler::enabled()) {
+        fmt::println("profiling is off, start mmqlc with --profile");
+        return;
+    }
+    const auto rows{Profiler::summary()};
+    if (rows.empty()) {
+        fmt::println("no timings recorded yet");
+        return;
+    }
+    fmt::print(fg(fmt::color::white) | fmt::emphasis::bold, "{:<15}{:<24}{:>8}{:>14}{:>12}{:>12}\n",
+               "kind", "name", "count", "total (ms)", "p50 (us)", "p99 (us)");
+    for (const auto &row: rows)
+        fmt::println("{:<15}{:<24}{:>8}{:>14.3f}{:>12.1f}{:>12.1f}", row.category, row.name, row.count,
+                     static_cast<double>(row.total) / 1e6, static_cast<double>(row.p50) / 1e3,
+                     static_cast<double>(row.p99) / 1e3);
+}
+
+/**
+ * @brief This reports on the standard error how the cache of answers did during the run, once it is closed.
+ */
+void mmqli::cli::CLInterface::print_cache_stats() {
+    const ResultCache::Stats stats{result_cache->stats()};
+    const std::size_t lookups{stats.hits + stats.misses};
+    fmt::print(stderr, "mmqlc: cache: {} hits, {} misses ({:.1f}% hit rate), {} stored, {} evicted, {} answers in "
+                       "{:.2f} of {:.0f} MiB\n", stats.hits, stats.misses,
+               lookups == 0 ? 0.0 : 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups),
+               stats.stored, stats.evicted, stats.entries, static_cast<double>(stats.bytes) / (1 << 20),
+               static_cast<double>(stats.limit) / (1 << 20));
+}
+
 /**
  * @brief  This clears the console screen of mmqlc. It is a platform-agnostic function, if you are on Windows,
  * it'll use the `cls` command otherwise if you are on unix like systems, it'll use the `clear` command.
@@ -75,6 +347,7 @@ void mmqli::cli::CLInterface::clear_screen_platform_agnostic() {
  * 3. or a variable declaration line
  *
  * after that it tokenize the query, parse the query and pass it to the Core class, and then it returns the result and print the calculated result.
+ * A query that cannot be answered prints its error, the session goes on.
  */
 void mmqli::cli::CLInterface::start_interpreter() {
     constexpr auto help{"help"};
@@ -87,16 +360,20 @@ void mmqli::cli::CLInterface::start_interpreter() {
     );
     std::string query{};
     std::unordered_map<std::string, std::string> variables_hashtable{};
+    std::unordered_map<std::string, std::string> definitions{}; // the SET query of every variable, kept by SAVE
+    Snapshot::Loaded loaded{}; // the variables of LOAD not used yet
+    std::signal(SIGINT, on_interrupt);
     auto empty_line { [](const std::string &q) { return q.empty(); } };
     auto commented_line { [](const std::string &q) {
         return q.rfind("%%", 0) == 0;
     } };
     auto var_declaration_line { [](const std::string &q) {
-        return q.rfind("set", 0) == 0;
+        return q.rfind("SET", 0) == 0;
     } };
     while (true) {
         fmt::print(fg(fmt::color::cyan), "|>> ");
-        std::getline(std::cin, query);
+        if (!std::getline(std::cin, query)) // end of the input
+            break;
         if (empty_line(query) || commented_line(query))
             continue;
         if (constexpr auto clear{"clear"}; query == clear) {
@@ -107,36 +384,301 @@ void mmqli::cli::CLInterface::start_interpreter() {
             break;
         if (constexpr auto flushmem {"flushmem"}; query == flushmem) {
             variables_hashtable.clear();
+            definitions.clear();
+            loaded.clear();
             clear_screen_platform_agnostic();
             continue;
         }
+        if (constexpr auto stats{"stats"}; query == stats) {
+            print_profile();
+            continue;
+        }
+        if (constexpr auto digits{"digits "}; query.starts_with(digits)) {
+            set_digits(query.substr(std::string_view{digits}.size()));
+            continue;
+        }
+        if (constexpr auto save{"SAVE "}; query.starts_with(save)) {
+            const std::string path{query.substr(std::string_view{save}.size())};
+            loaded.resolve_all(variables_hashtable, definitions);
+            const auto saved{Snapshot::save(path, variables_hashtable, definitions)};
+            if (!saved)
+                print_error(saved.error());
+            else
+                fmt::println("{} variables saved to {}", *saved, path);
+            continue;
+        }
+        if (constexpr auto load{"LOAD "}; query.starts_with(load)) {
+            const std::string path{query.substr(std::string_view{load}.size())};
+            auto snapshot{Snapshot::Snapshot::open(path)};
+            if (!snapshot) {
+                print_error(snapshot.error());
+                continue;
+            }
+            // the variables are read from the snapshot when a query first names them.
+            const std::size_t count{snapshot->size()};
+            loaded.add(std::move(*snapshot), variables_hashtable, definitions);
+            fmt::println("{} variables loaded from {}", count, path);
+            continue;
+        }
+        loaded.resolve(query, variables_hashtable, definitions);
         if (var_declaration_line(query)) {
-            for (auto kp {find_and_resolve_vars({query}, variables_hashtable)};
-                 const auto &[varName, varValue]: kp)
-                // this loop will always have one pass, because find_and_resolve_vars will return map of size 1 due to single query string containing the signs of variable.
-                variables_hashtable[varName] = varValue;
+            const Profiler::Scope timer{"stage", "resolve"};
+            evaluating.store(true);
+            auto kp {find_and_resolve_vars({query}, variables_hashtable)};
+            evaluating.store(false);
+            if (!kp) {
+                print_error(kp.error());
+                continue;
+            }
+            for (auto &[varName, varValue]: *kp)
+                variables_hashtable[varName] = std::move(varValue);
+            // SET <name> = <definition>
+            const std::size_t name_end{query.find_first_of(" =", 4)};
+            definitions[query.substr(4, name_end - 4)] = query;
             continue;
         }
         if (query == help) {
-            fmt::println("{}\t{}\n{}\t{}\n{}\t{}",
+            fmt::println("{}\t{}\n{}\t{}\n{}\t{}\n{}\t{}\n{}\t{}\n{}\t{}\n{}\t{}",
                          "clear", "Clear the console screen",
                          "flushmem", "Erase session memory",
+                         "SAVE <path>", "Write the variables of the session to a snapshot",
+                         "LOAD <path>", "Restore the variables of a snapshot into the session",
+                         "stats", "Show the timings of the session (needs --profile)",
+                         "digits <n>", "Answer with <n> correct digits, 'digits off' to stop",
                          "quit", "Exit Session"
             );
             continue;
         }
-        const auto result{  [&]() {
-            const auto token = tokenize({query}, variables_hashtable);
-            const auto parse_ptr = std::make_unique<Parser>(token);
-            const auto ansPTR = std::make_unique<Core>(
-                parse_ptr->parse_RealNums(), parse_ptr->parse_cmplxNums());
-            return ansPTR->calculateAnswers()[0];
-        }() };
-        fmt::print(fg(fmt::color::white) | fmt::emphasis::bold, "{}\n",
-                   result.substr(result.find('=') + 2)); // Skip "= "
+        evaluating.store(true);
+        const Answers answers{answer(query, variables_hashtable, false)};
+        evaluating.store(false);
+        for (const auto &error: answers.errors)
+            print_error(error);
+        for (const auto &result: answers.results) {
+            if (!result) {
+                print_error(result.error());
+                continue;
+            }
+            fmt::print(fg(fmt::color::white) | fmt::emphasis::bold, "{}\n",
+                       std::string_view{*result}.substr(result->find('=') + 2)); // Skip "= "
+        }
+    }
+}
+
+/**
+ * @brief This reads the name of a format, unknown when @p name is none.
+ */
+mmqli::cli::CLInterface::Format mmqli::cli::CLInterface::format_of(const std::string_view name) {
+    if (name == "text")
+        return Format::text;
+    if (name == "json")
+        return Format::json;
+    return name == "binary" ? Format::binary : Format::unknown;
+}
+
+/**
+ * @brief This writes one answer in the format @p output: a text line, a JSON Lines record, or a binary frame.
+ * @param answer The text of the result, without its query, or its error.
+ * @param value The result as a value, carried by the binary frames instead of the text when there is one.
+ */
+void mmqli::cli::CLInterface::write_answer(std::ostream &out, const Format output, const std::size_t id,
+                                           const std::string_view query, const Errors::Result<std::string> &answer,
+                                           const Wire::Value &value) {
+    const auto id32{static_cast<std::uint32_t>(id)};
+    if (output == Format::json) {
+        out << Wire::json_line(id, query, answer);
+    } else if (output == Format::binary) {
+        Wire::write_frame(out, answer ? Wire::result_frame(id32, value, *answer) : Wire::error_frame(id32, answer.error()));
+    } else if (answer) {
+        out << *answer << '\n';
+    } else {
+        out << "mmqlc: error: " << Errors::describe(answer.error()) << '\n';
     }
 }
 
+/**
+ * @brief This applies the template @p map, e.g. @code COMBINATION $1,$2 @endcode, to every row of the CSV or TSV file
+ * at @p path and writes one answer per row, in the order of the rows, with the line of the row as its id. The file is
+ * memory-mapped and split into chunks of whole rows, the columns are read straight into MPFR numbers, and a wave of
+ * chunks is evaluated in parallel before its answers are written. A first line none of whose columns is a number is
+ * a header and is skipped. The throughput is reported on the standard error once the file is done.
+ * @return false when the template or the file cannot be read, the error is printed.
+ */
+bool mmqli::cli::CLInterface::start_map(const std::string &map, const std::string &path, const Format output) {
+    const auto pattern{Columnar::parse_template(map)};
+    if (!pattern) {
+        print_error(pattern.error());
+        return false;
+    }
+    const auto file{Columnar::MappedFile::open(path)};
+    if (!file) {
+        print_error(file.error());
+        return false;
+    }
+#if WIN32
+    if (output == Format::binary)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    std::ios::sync_with_stdio(false);
+    const auto started{std::chrono::steady_clock::now()};
+    const std::string_view data{file->view()};
+    const char delimiter{Columnar::delimiter_of(data)};
+    const std::size_t workers{Parallel::worker_count()};
+    const auto chunks{Columnar::split(data, Columnar::chunk_size(data.size(), workers))};
+    std::atomic<std::size_t> rows{0};
+    const auto map_chunk{
+        [&](const Columnar::Chunk &chunk) {
+            const Profiler::Scope timer{"stage", "map"};
+            mmqli::core::ParsedRealQueries queries;
+            // every row in order, with the error of the rows whose operands cannot be read.
+            std::vector<std::pair<std::size_t, std::optional<Errors::Error>>> read;
+            std::string scratch;
+            Columnar::for_each_row(chunk, [&](const std::size_t line, const std::string_view row) {
+                std::array<float1000, 2> operands{};
+                const auto operands_read{Columnar::read_row(*pattern, line, row, delimiter, operands, scratch)};
+                if (!operands_read) {
+                    read.emplace_back(line, operands_read.error());
+                    return;
+                }
+                if (!*operands_read)
+                    return; // the header
+                queries.emplace_back(pattern->keyword, std::move(operands[0]), std::move(operands[1]));
+                read.emplace_back(line, std::nullopt);
+            });
+            mmqli::core::Core core{std::move(queries), {}};
+            core.keep_values(false); // only the results are formatted, never the operands
+            auto results{core.evaluate()};
+            const auto values{core.take_values()};
+            std::ostringstream out;
+            std::size_t next{0};
+            for (const auto &[line, failure]: read) {
+                if (failure) {
+                    write_answer(out, output, line, map, std::unexpected{*failure}, {});
+                    continue;
+                }
+                const auto &result{results[next]};
+                const Wire::Value &value{values[next++]};
+                if (!result)
+                    write_answer(out, output, line, map,
+                                 Errors::fail(result.error().code, result.error().message, {line, 0}), {});
+                else if (value.index() != 0)
+                    write_answer(out, output, line, map,
+                                 output == Format::binary ? std::string{} : value_text(value), value);
+                else
+                    write_answer(out, output, line, map, std::string{result_text(*result)}, value);
+            }
+            rows.fetch_add(read.size(), std::memory_order_relaxed);
+            return std::move(out).str();
+        }
+    };
+    // the chunks of a wave run in parallel, their answers are written in order before the next wave starts.
+    const std::size_t wave{workers * 4};
+    std::vector<std::string> answers(std::min(wave, chunks.size()));
+    for (std::size_t first = 0; first < chunks.size(); first += wave) {
+        const std::size_t count{std::min(wave, chunks.size() - first)};
+        Parallel::parallel_for(count, [&](const std::size_t i) { answers[i] = map_chunk(chunks[first + i]); });
+        for (std::size_t i = 0; i < count; ++i)
+            std::cout << answers[i];
+    }
+    std::cout.flush();
+    const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count()};
+    fmt::print(stderr, "mmqlc: mapped {} rows in {:.3f} s, {:.0f} rows/s\n", rows.load(), seconds,
+               seconds > 0 ? static_cast<double>(rows.load()) / seconds : 0.0);
+    return true;
+}
+
+/**
+ * @brief This answers the queries of the standard input without the banner and the prompt, for other programs: text
+ * lines or binary query frames in, text, JSON Lines or binary result frames out. The id of an answer is the line of
+ * its query, or the id of its query frame. With @p chain, the result frames of an upstream mmqlc become queries of
+ * the keyword @p chain over their value, so the stages of a pipeline never convert to decimal.
+ */
+void mmqli::cli::CLInterface::start_machine(const Format input, const Format output, const std::string &chain) {
+#if WIN32
+    if (input == Format::binary)
+        _setmode(_fileno(stdin), _O_BINARY);
+    if (output == Format::binary)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    std::ios::sync_with_stdio(false);
+    const auto emit{
+        [&](const std::size_t id, const std::string_view query, const Errors::Result<std::string> &result,
+            const Wire::Value &value) {
+            write_answer(std::cout, output, id, query,
+                         result ? Errors::Result<std::string>{result_text(*result)} : result, value);
+        }
+    };
+    const auto emit_all{
+        [&](const std::size_t id, const std::string_view query, const Answers &answers) {
+            for (const auto &error: answers.errors)
+                emit(id, query, Errors::fail(error.code, error.message, {id, error.where.column}), {});
+            for (std::size_t i = 0; i < answers.results.size(); ++i)
+                emit(id, query, answers.results[i], i < answers.values.size() ? answers.values[i] : Wire::Value{});
+        }
+    };
+    if (input == Format::text) {
+        std::unordered_map<std::string, std::string> variables;
+        std::string query;
+        for (std::size_t line = 1; std::getline(std::cin, query); ++line) {
+            if (query.empty() || query.starts_with("%%"))
+                continue;
+            if (query.starts_with("SET")) {
+                const Profiler::Scope timer{"stage", "resolve"};
+                auto resolved{find_and_resolve_vars({query}, variables)};
+                if (!resolved) {
+                    emit(line, query, Errors::fail(resolved.error().code, resolved.error().message,
+                                                   {line, resolved.error().where.column}), {});
+                    continue;
+                }
+                for (auto &[name, value]: *resolved)
+                    variables[name] = std::move(value);
+                continue;
+            }
+            emit_all(line, query, answer(query, variables, output == Format::binary));
+        }
+        std::cout.flush();
+        return;
+    }
+    while (const auto payload{Wire::read_frame(std::cin)}) {
+        const auto malformed{
+            [&] { emit(0, "", Errors::fail(Errors::Code::invalid_literal, "Malformed frame !"), {}); }
+        };
+        if (payload->empty()) {
+            malformed();
+            continue;
+        }
+        if (payload->front() == static_cast<char>(Wire::Frame::query)) {
+            auto query{Wire::read_query(*payload)};
+            if (!query) {
+                malformed();
+                continue;
+            }
+            const std::uint32_t id{query->id};
+            const std::string keyword{query->keyword};
+            emit_all(id, keyword, answer(std::move(*query)));
+            continue;
+        }
+        auto upstream{Wire::read_answer(*payload)};
+        if (!upstream) {
+            malformed();
+            continue;
+        }
+        if (!upstream->value) { // the error of an upstream stage goes on downstream
+            emit(upstream->id, chain, std::unexpected{upstream->value.error()}, {});
+            continue;
+        }
+        if (chain.empty() || upstream->value->index() == 0) {
+            emit(upstream->id, chain, Errors::fail(Errors::Code::syntax, chain.empty()
+                                                       ? "A result frame is only a query with --chain <keyword> !"
+                                                       : "A result given as text cannot be chained !"), {});
+            continue;
+        }
+        const Wire::Kind kind{Wire::kind_of(*upstream->value)};
+        emit_all(upstream->id, chain, answer(Wire::Query{upstream->id, chain, kind, {std::move(*upstream->value)}}));
+    }
+    std::cout.flush();
+}
+
 /**
  * @brief as the name suggest what it does.
  */
@@ -152,22 +694,152 @@ mmqli::cli::CLInterface::CLInterface(const int argsC, char **argvA) {
 
 /**
  * This function just emulates the mmqlc cli.
- * At first, it checks whether the cli was invoked command line arguments or not,
- * if so then it checks which flags was it called with, if an unknown flag then it print error message, otherwise it calls the attached functions
- * and if no command line arguments then it starts the interpreter.
+ * At first, it checks which flags the cli was invoked with, if an unknown flag then it print error message, otherwise it calls the attached functions.
+ * Then it starts the interpreter, with the profiler enabled when asked for, and reports the timings once the session ends.
  */
 void mmqli::cli::CLInterface::start_cli() {
-    if (argument_count == 1) {
+    bool profile{false};
+    std::string trace_path{};
+    Format input{Format::text};
+    Format output{Format::text};
+    std::string input_name{};
+    std::string chain{};
+    std::string map{};
+    bool cache{false};
+    bool cache_stats{false};
+    std::size_t cache_limit{ResultCache::default_limit};
+    for (int i = 1; i < argument_count; ++i) {
+        const std::string_view option{argument_vector[i]};
+        if (option == "--help")
+            show_help_message();
+        if (option == "--version")
+            show_version_plus_copyright();
+        if (option == "--profile") {
+            profile = true;
+            continue;
+        }
+        if (option == "--trace" && i + 1 < argument_count) {
+            trace_path = argument_vector[++i];
+            continue;
+        }
+        if (option == "--input" && i + 1 < argument_count) {
+            input_name = argument_vector[++i]; // a format, or the file of --map
+            continue;
+        }
+        if (option == "--output" && i + 1 < argument_count) {
+            output = format_of(argument_vector[++i]);
+            if (output == Format::unknown) {
+                unknown_flag_error();
+                return;
+            }
+            continue;
+        }
+        if (option == "--map" && i + 1 < argument_count) {
+            map = argument_vector[++i];
+            continue;
+        }
+        if (option == "--cache" || option == "--cache-stats") {
+            cache = true;
+            cache_stats = cache_stats || option == "--cache-stats";
+            continue;
+        }
+        if (option == "--cache-limit" && i + 1 < argument_count) {
+            const std::string_view value{argument_vector[++i]};
+            std::size_t mebibytes{0};
+            const auto [end, failure]{std::from_chars(value.data(), value.data() + value.size(), mebibytes)};
+            if (failure != std::errc{} || end != value.data() + value.size() || mebibytes == 0 ||
+                mebibytes > std::numeric_limits<std::size_t>::max() >> 20) {
+                print_error({Errors::Code::invalid_number, {}, "The limit of the cache must be a positive count of MiB !"});
+                fmt::println("failed to initialize interpreter.");
+                return;
+            }
+            cache_limit = mebibytes << 20;
+            continue;
+        }
+        if ((option == "--timeout" || option == "--memory-limit") && i + 1 < argument_count) {
+            const std::string_view value{argument_vector[++i]};
+            std::size_t amount{0};
+            const auto [end, failure]{std::from_chars(value.data(), value.data() + value.size(), amount)};
+            if (failure != std::errc{} || end != value.data() + value.size() || amount == 0 ||
+                amount > std::numeric_limits<std::size_t>::max() >> 20) {
+                print_error({Errors::Code::invalid_number, {}, option == "--timeout"
+                                                                   ? "The timeout must be a positive count of ms !"
+                                                                   : "The memory limit must be a positive count of MiB !"});
+                fmt::println("failed to initialize interpreter.");
+                return;
+            }
+            if (option == "--timeout")
+                Cancel::set_timeout(std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(amount)});
+            else
+                Cancel::set_memory_limit(amount << 20);
+            continue;
+        }
+        if (option == "--chain" && i + 1 < argument_count) {
+            chain = argument_vector[++i];
+            continue;
+        }
+        if (option == "--digits" && i + 1 < argument_count) {
+            if (!set_digits(argument_vector[++i])) {
+                fmt::println("failed to initialize interpreter.");
+                return;
+            }
+            continue;
+        }
+        if (option == "--plugin" && i + 1 < argument_count) {
+            // loaded before the first query, the worker threads only ever read the registry.
+            if (const auto loaded{Plugins::load(argument_vector[++i])}; !loaded) {
+                print_error(loaded.error());
+                fmt::println("failed to initialize interpreter.");
+                return;
+            }
+            continue;
+        }
+        unknown_flag_error();
+        return;
+    }
+    if (map.empty() && !input_name.empty()) {
+        input = format_of(input_name);
+        if (input == Format::unknown || input == Format::json) {
+            unknown_flag_error();
+            return;
+        }
+    }
+    if (!map.empty() && input_name.empty()) {
+        print_error({Errors::Code::unreadable_file, {}, "--map needs the file of its rows, --input <file> !"});
+        fmt::println("failed to initialize interpreter.");
+        return;
+    }
+    if (profile || !trace_path.empty())
+        Profiler::enable(!trace_path.empty());
+    if (cache) {
+        // the answers of another engine, or of another precision, are never reused.
+        result_cache = std::make_unique<ResultCache::ResultCache>(
+            mmqli::core::cache::directory("results"), cache_limit, mmqli::core::Core::engine());
+    }
+    if (!map.empty()) {
+        if (!start_map(map, input_name, output)) {
+            fmt::println("failed to initialize interpreter.");
+            return;
+        }
+    } else if (input != Format::text || output != Format::text) {
+        start_machine(input, output, chain);
+    } else {
 #if WIN32
         enable_virtual_terminal_processing();
 #endif
         start_interpreter();
     }
-    if (argument_count == 2) {
-        if (std::string_view(argument_vector[1]) == "--help")
-            show_help_message();
-        if (std::string_view(argument_vector[1]) == "--version")
-            show_version_plus_copyright();
-        unknown_flag_error();
+    if (result_cache) {
+        result_cache->close();
+        if (cache_stats)
+            print_cache_stats();
+        result_cache.reset();
+    }
+    if (profile)
+        print_profile();
+    if (!trace_path.empty() && !Profiler::write_trace(trace_path)) {
+        fmt::print(fg(fmt::color::white) | fmt::emphasis::bold, "mmqlc: ");
+        fmt::print(fg(fmt::color::red), "error: ");
+        fmt::println("failed to write the trace to {}", trace_path);
     }
 }
\ No newline at end of file
@@ -1,8 +1,15 @@
 #ifndef MMQLI_CLI_HPP
 #define MMQLI_CLI_HPP
 
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "../core/helpers/error.hpp"
+#include "../core/helpers/wire.hpp"
+
 namespace mmqli::cli {
     class CLInterface {
+        enum class Format : unsigned char { text, json, binary, unknown };
         int argument_count;
         char **argument_vector;
         static void unknown_flag_error() noexcept;
@@ -11,6 +18,16 @@ namespace mmqli::cli {
         static void clear_screen_platform_agnostic();
         static void start_interpreter();
         static void show_version_plus_copyright();
+        static void print_profile();
+        static void print_cache_stats();
+        static void print_error(const mmqli::core::error::Error &error);
+        static bool set_digits(const std::string &value);
+        static Format format_of(std::string_view name);
+        static void write_answer(std::ostream &out, Format output, std::size_t id, std::string_view query,
+                                 const mmqli::core::error::Result<std::string> &answer,
+                                 const mmqli::core::wire::Value &value);
+        static void start_machine(Format input, Format output, const std::string &chain);
+        static bool start_map(const std::string &map, const std::string &path, Format output);
     public:
         CLInterface(int argsC, char **argvA);
         void start_cli();
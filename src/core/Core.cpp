@@ -1,6 +1,24 @@
 #include "Core.hpp"
 #include "helpers/trigonometry.hpp"
 #include "helpers/combinatorics.hpp"
+#include "helpers/batch.hpp"
+#include "helpers/reductions.hpp"
+#include "helpers/linalg.hpp"
+#include "helpers/dense.hpp"
+#include "helpers/polynomial.hpp"
+#include "helpers/integration.hpp"
+#include "helpers/binary_splitting.hpp"
+#include "helpers/geometry.hpp"
+#include "helpers/plugins.hpp"
+#include "helpers/ziv.hpp"
+#include "helpers/powers.hpp"
+#include "helpers/special.hpp"
+#include "helpers/exact.hpp"
+#include "helpers/families.hpp"
+#include <charconv>
+#include <limits>
+#include <unordered_map>
+#include "engine.hpp"
 
 #define OPERATION_SUCCESS true
 #define OPERATION_FAILURE false
@@ -9,6 +27,60 @@ namespace RealTrig = mmqli::core::trigonometry::real;
 namespace AngleConv = mmqli::core::trigonometry::real::converters;
 namespace ComplexTrig = mmqli::core::trigonometry::complex;
 namespace Combinatorics = mmqli::core::combinatorics;
+namespace Batch = mmqli::core::batch;
+namespace Reductions = mmqli::core::reductions;
+namespace LinAlg = mmqli::core::linalg;
+namespace Dense = mmqli::core::dense;
+namespace Polynomial = mmqli::core::polynomial;
+namespace Integration = mmqli::core::integration;
+namespace Splitting = mmqli::core::binary_splitting;
+namespace Geometry = mmqli::core::geometry;
+namespace Errors = mmqli::core::error;
+namespace Plugins = mmqli::core::plugins;
+namespace Ziv = mmqli::core::ziv;
+namespace Powers = mmqli::core::powers;
+namespace Special = mmqli::core::special;
+namespace Exact = mmqli::core::exact;
+namespace Cancel = mmqli::core::cancel;
+namespace Families = mmqli::core::families;
+
+namespace {
+    std::domain_error outside_domain(const std::string& query) {
+        return std::domain_error{"The operands are outside the domain of " + query + " !"};
+    }
+
+    // evaluates a real plugin function into r, the operands are checked against its domain first.
+    void call_plugin(const Plugins::Function& function, const std::string& query, mpfr_ptr r, mpfr_srcptr first,
+                     mpfr_srcptr second) {
+        const std::array<mpfr_srcptr, 2> operands{first, second};
+        for (unsigned i = 0; i < function.arity; ++i)
+            if (!Plugins::in_domain(function.domain[i], operands[i]))
+                throw outside_domain(query);
+        if (function.real(r, operands.data()) != 0)
+            throw outside_domain(query);
+    }
+
+    // the complex counterpart, the parts of the operands are copied out of the std::complex that holds them.
+    void call_plugin(const Plugins::Function& function, const std::string& query, complex1000& r,
+                     const complex1000& first, const complex1000& second) {
+        const std::array<float1000, 4> parts{first.real(), first.imag(), second.real(), second.imag()};
+        const std::array<mpfr_srcptr, 2> real_parts{parts[0].backend().data(), parts[2].backend().data()};
+        const std::array<mpfr_srcptr, 2> imaginary_parts{parts[1].backend().data(), parts[3].backend().data()};
+        for (unsigned i = 0; i < function.arity; ++i)
+            if (!Plugins::in_domain(function.domain[i], real_parts[i], imaginary_parts[i]))
+                throw outside_domain(query);
+        float1000 real_part;
+        float1000 imaginary_part;
+        if (function.complex(real_part.backend().data(), imaginary_part.backend().data(), real_parts.data(),
+                             imaginary_parts.data()) != 0)
+            throw outside_domain(query);
+        r = complex1000{std::move(real_part), std::move(imaginary_part)};
+    }
+}
+
+std::string mmqli::core::Core::engine() {
+    return "mmqlc 3.0 (" MMQLC_ENGINE_SOURCES "), " + std::to_string(std::numeric_limits<float1000>::digits) + " bits";
+}
 
 std::string mmqli::core::Core::to_str(const complex1000& complex) {
     const std::string real_part{complex.real().str()};
@@ -22,9 +94,46 @@ std::string mmqli::core::Core::to_str(const float1000& real) {
     return real.str();
 }
 
+std::string mmqli::core::Core::to_str(const mpq_class& exact) {
+    return Exact::to_str(exact);
+}
+
+std::string mmqli::core::Core::to_str(const double real) {
+    char digits[32];
+    const auto [end, error] = std::to_chars(digits, digits + sizeof digits, real); // shortest round trip form
+    return std::string{digits, end};
+}
+
+std::string mmqli::core::Core::to_str(const std::vector<double>& batch) {
+    if (batch.empty())
+        return "[]";
+    std::string joined{"["};
+    for (const double element : batch) {
+        joined += to_str(element);
+        joined += ',';
+    }
+    joined.back() = ']';
+    return joined;
+}
+
+std::string mmqli::core::Core::to_str(const Geometry::PointSet& points) {
+    if (points.size() == 0)
+        return "[]";
+    std::string joined{"["};
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        joined += '[';
+        joined += to_str(points.x[i]);
+        joined += ',';
+        joined += to_str(points.y[i]);
+        joined += "],";
+    }
+    joined.back() = ']';
+    return joined;
+}
+
 bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string& query, const float1000& first_operand,
                                                                const float1000& second_operand) {
-    if (query == "add") {
+    if (query == "ADD") {
         results.emplace_back(
             build_output(
                 query,
@@ -37,7 +146,7 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "subtract") {
+    if (query == "SUBTRACT") {
         results.emplace_back(
             build_output(
                 query,
@@ -50,7 +159,7 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "multiply") {
+    if (query == "MULTIPLY") {
         results.emplace_back(
             build_output(
                 query,
@@ -63,8 +172,8 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "divide") {
-        if (second_operand == 0) throw std::runtime_error("Division by zero is undefined !");
+    if (query == "DIVIDE") {
+        if (second_operand == 0) return reject(Errors::Code::division_by_zero, "Division by zero is undefined !");
         results.emplace_back(
             build_output(
                 query,
@@ -77,69 +186,30 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "power") {
+    if (query == "POWER") {
         results.emplace_back(
             build_output(
                 query,
                 first_operand,
                 second_operand,
-                float1000{pow(first_operand, second_operand)}
+                Powers::power(first_operand, second_operand)
             )
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "root") {
-        if (second_operand == 0) throw std::runtime_error("Zeroeth root is undefined !");
-        if (second_operand == 1) {
-            results.emplace_back(
-                build_output(
-                    query,
-                    first_operand,
-                    second_operand,
-                    first_operand
-                )
-            );
-            return OPERATION_SUCCESS;
-        }
-        if (second_operand == 2) {
-            results.emplace_back(
-                build_output(
-                    query,
-                    first_operand,
-                    second_operand,
-                    float1000{
-                        sqrt(first_operand)
-                    }
-                )
-            );
-            return OPERATION_SUCCESS;
-        }
-        if (second_operand == 3) {
-            results.emplace_back(
-                build_output(
-                    query,
-                    first_operand,
-                    second_operand,
-                    float1000{
-                        cbrt(first_operand)
-                    }
-                )
-            );
-            return OPERATION_SUCCESS;
-        }
+    if (query == "ROOT") {
+        if (second_operand == 0) return reject(Errors::Code::domain, "Zeroeth root is undefined !");
         results.emplace_back(
             build_output(
                 query,
                 first_operand,
                 second_operand,
-                float1000{
-                    pow(first_operand, constants::real_one / second_operand)
-                }
+                Powers::root(first_operand, second_operand)
             )
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "logarithm") {
+    if (query == "LOGARITHM") {
         // using change of base formula
         results.emplace_back(
             build_output(
@@ -153,7 +223,7 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "permutation") {
+    if (query == "PERMUTATION") {
         results.emplace_back(
             build_output(
                 query,
@@ -166,7 +236,7 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return true;
     }
-    if (query == "combination") {
+    if (query == "COMBINATION") {
         results.emplace_back(
             build_output(
                 query,
@@ -179,8 +249,8 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "modulo") {
-        if (second_operand == 0) throw std::runtime_error("Cannot divide by zero");
+    if (query == "MODULO") {
+        if (second_operand == 0) return reject(Errors::Code::division_by_zero, "Cannot divide by zero");
         results.emplace_back(
             build_output(
                 query,
@@ -198,7 +268,18 @@ bool mmqli::core::Core::calculate_real_queries_double_operands(const std::string
 
 bool mmqli::core::Core::
 calculate_real_queries_single_operand(const std::string& query, const float1000& operand) {
-    if (query == "factorial") {
+    if (query.starts_with("CONSTANT ")) {
+        // the digits are written as they are, they usually exceed the precision of float1000 by far.
+        if (operand < 1 || operand != floor(operand))
+            return reject(Errors::Code::domain, "Number of digits of a constant must be a positive integer !");
+        const std::string name{query.substr(query.find(' ') + 1)};
+        if (const std::size_t bytes{Splitting::working_memory(name, operand.convert_to<std::size_t>())}; !Cancel::fits(bytes))
+            return reject(Errors::Code::memory_limit, Cancel::too_large(bytes));
+        const std::string digits{Splitting::constant(name, operand.convert_to<std::size_t>())};
+        results.emplace_back(query + " " + to_str(operand) + " = " + digits + "\n");
+        return OPERATION_SUCCESS;
+    }
+    if (query == "FACTORIAL") {
         results.emplace_back(
             build_output(
                 query,
@@ -210,7 +291,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "absolute") {
+    if (query == "ABSOLUTE") {
         results.emplace_back(
             build_output(
                 query,
@@ -222,7 +303,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "floor") {
+    if (query == "FLOOR") {
         results.emplace_back(
             build_output(
                 query,
@@ -234,7 +315,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "ceiling") {
+    if (query == "CEILING") {
         results.emplace_back(
             build_output(
                 query,
@@ -246,7 +327,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "sine") {
+    if (query == "SINE") {
         results.emplace_back(
             build_output(
                 query,
@@ -260,7 +341,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "cosine") {
+    if (query == "COSINE") {
         results.emplace_back(
             build_output(
                 query,
@@ -274,7 +355,7 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         );
         return OPERATION_SUCCESS;
     }
-    if (query == "tangent") {
+    if (query == "TANGENT") {
         if (fmod(operand, 90) == 0) {
             results.emplace_back(build_output(query, operand, constants::real_infinity));
             return true;
@@ -286,77 +367,77 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
     }
     else if (query == "COTANGENT") {
         if (operand == 90) {
-            results.emplace_back(build_output(query, operand, ZERO));
+            results.emplace_back(build_output(query, operand, constants::real_zero));
             return true;
         }
         else if (operand == 0) {
-            results.emplace_back(build_output(query, operand, infinity));
+            results.emplace_back(build_output(query, operand, constants::real_infinity));
             return true;
         }
         else {
-            float1000 rads(hf::degrees_to_radians(operand));
-            float1000 result(rt::cotangent(rads));
+            float1000 rads(AngleConv::degrees_to_radians(operand));
+            float1000 result(RealTrig::cotangent(rads));
             results.emplace_back(build_output(query, operand, result));
             return true;
         }
     }
     else if (query == "COSECANT") {
         if (operand == 0) {
-            results.emplace_back(build_output(query, operand, infinity));
+            results.emplace_back(build_output(query, operand, constants::real_infinity));
             return true;
         }
         else {
-            float1000 rads(hf::degrees_to_radians(operand));
-            float1000 result(rt::cosecant(rads));
+            float1000 rads(AngleConv::degrees_to_radians(operand));
+            float1000 result(RealTrig::cosecant(rads));
             results.emplace_back(build_output(query, operand, result));
             return true;
         }
     }
     else if (query == "SECANT") {
         if (operand == 90) {
-            results.emplace_back(build_output(query, operand, infinity));
+            results.emplace_back(build_output(query, operand, constants::real_infinity));
             return true;
         }
         else {
-            float1000 rads(hf::degrees_to_radians(operand));
-            float1000 result(rt::secant(rads));
+            float1000 rads(AngleConv::degrees_to_radians(operand));
+            float1000 result(RealTrig::secant(rads));
             results.emplace_back(build_output(query, operand, result));
             return true;
         }
     }
     else if (query == "INVERSE_SINE") {
         float1000 rads(asin(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
     else if (query == "INVERSE_COSINE") {
         float1000 rads(acos(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
     else if (query == "INVERSE_TANGENT") {
         float1000 rads(atan(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
     else if (query == "INVERSE_COTANGENT") {
-        float1000 rads(rt::inverse_cotangent(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 rads(RealTrig::inverse_cotangent(operand));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
     else if (query == "INVERSE_COSECANT") {
-        float1000 rads(rt::inverse_cosecant(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 rads(RealTrig::inverse_cosecant(operand));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
     else if (query == "INVERSE_SECANT") {
-        float1000 rads(rt::inverse_secant(operand));
-        float1000 result(hf::radians_to_degrees(rads));
+        float1000 rads(RealTrig::inverse_secant(operand));
+        float1000 result(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, result));
         return true;
     }
@@ -376,17 +457,17 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         return true;
     }
     else if (query == "HYP_COTANGENT") {
-        float1000 result_val(rt::cotangent_hyperbolic(operand));
+        float1000 result_val(RealTrig::cotangent_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
     else if (query == "HYP_COSECANT") {
-        float1000 result_val(rt::cosecant_hyperbolic(operand));
+        float1000 result_val(RealTrig::cosecant_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
     else if (query == "HYP_SECANT") {
-        float1000 result_val(rt::secant_hyperbolic(operand));
+        float1000 result_val(RealTrig::secant_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
@@ -406,17 +487,17 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         return true;
     }
     else if (query == "INVERSE_HYP_COTANGENT") {
-        float1000 result_val(rt::inverse_cotangent_hyperbolic(operand));
+        float1000 result_val(RealTrig::inverse_cotangent_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
     else if (query == "INVERSE_HYP_COSECANT") {
-        float1000 result_val(rt::inverse_cosecant_hyperbolic(operand));
+        float1000 result_val(RealTrig::inverse_cosecant_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
     else if (query == "INVERSE_HYP_SECANT") {
-        float1000 result_val(rt::inverse_secant_hyperbolic(operand));
+        float1000 result_val(RealTrig::inverse_secant_hyperbolic(operand));
         results.emplace_back(build_output(query, operand, result_val));
         return true;
     }
@@ -435,27 +516,436 @@ calculate_real_queries_single_operand(const std::string& query, const float1000&
         results.emplace_back(build_output(query, operand, res));
         return true;
     }
+    // the fused queries answer a whole family of functions at the cost of about one of them.
+    else if (query == "TRIG_ALL") {
+        results.emplace_back(build_output(query, operand, Families::circular(operand)));
+        return true;
+    }
+    else if (query == "HYP_ALL") {
+        results.emplace_back(build_output(query, operand, Families::hyperbolic(operand)));
+        return true;
+    }
+    else if (query == "LOG_ALL") {
+        if (operand <= 0)
+            return reject(Errors::Code::domain, "LOG_ALL is only defined for positive numbers !");
+        results.emplace_back(build_output(query, operand, Families::logarithms(operand)));
+        return true;
+    }
     else {
         return false;
     }
 }
 
+bool mmqli::core::Core::calculate_plugin_queries(const std::string& query, const float1000& first_operand,
+                                                  const float1000& second_operand) {
+    const Plugins::Function* function{Plugins::find(query, Plugins::Kind::real)};
+    if (function == nullptr)
+        return OPERATION_FAILURE;
+    float1000 result;
+    call_plugin(*function, query, result.backend().data(), first_operand.backend().data(),
+                second_operand.backend().data());
+    results.emplace_back(function->arity == 1
+                             ? build_output(query, first_operand, result)
+                             : build_output(query, first_operand, second_operand, result));
+    return OPERATION_SUCCESS;
+}
+
+bool mmqli::core::Core::calculate_special_queries(const std::string& query, const float1000& first_operand,
+                                                   const float1000& second_operand) {
+    mpfr_srcptr a{first_operand.backend().data()};
+    mpfr_srcptr b{second_operand.backend().data()};
+    float1000 result;
+    if (const Special::Function function{Special::unary(query)}; function != nullptr || query == "ZETA") {
+        if (Special::has_pole(query, a))
+            return reject(Errors::Code::domain, query + " has a pole at " + to_str(first_operand) + " !");
+        if (function != nullptr)
+            function(result.backend().data(), a, MPFR_RNDN);
+        else
+            Special::zeta(result.backend().data(), a);
+        results.emplace_back(build_output(query, first_operand, result));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "BESSEL_J" || query == "BESSEL_Y") {
+        const std::optional<long> order{Special::order(a)};
+        if (!order)
+            return reject(Errors::Code::domain, "The order of " + query + " must be an integer !");
+        if (query == "BESSEL_Y" && mpfr_sgn(b) <= 0)
+            return reject(Errors::Code::domain, "BESSEL_Y is only defined for positive numbers !");
+        Special::bessel(result.backend().data(), query == "BESSEL_Y", *order, b);
+        results.emplace_back(build_output(query, first_operand, second_operand, result));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "INCOMPLETE_GAMMA") {
+        if (mpfr_sgn(b) < 0)
+            return reject(Errors::Code::domain, "INCOMPLETE_GAMMA is only defined for nonnegative bounds !");
+        mpfr_gamma_inc(result.backend().data(), a, b, MPFR_RNDN);
+        results.emplace_back(build_output(query, first_operand, second_operand, result));
+        return OPERATION_SUCCESS;
+    }
+    return OPERATION_FAILURE;
+}
+
+namespace {
+    using MpfrFunction = int (*)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+    // writes f'(u) into d, a few bits of it are enough, scratch is a register of the same precision.
+    using Derivative = void (*)(mpfr_ptr d, mpfr_ptr scratch, mpfr_srcptr u);
+
+    // the bits of the derivatives, only their exponent is used.
+    constexpr mpfr_prec_t derivative_bits{32};
+
+    // the rational an operand is written with, an integer, p/q or a decimal literal, nothing when it is not known.
+    std::optional<mpq_class> operand_as_written(const std::string& literal) {
+        if (literal.empty())
+            return std::nullopt;
+        if (Exact::literal(literal))
+            return Exact::parse(literal);
+        return Exact::decimal(literal);
+    }
+
+    struct DegreeFunction {
+        MpfrFunction function;
+        Derivative derivative;
+        int zero_at; // the residue of the angle modulo 180 at which the function is 0, or -1
+        int pole_at; // the residue of the angle modulo 180 at which the function is undefined, or -1
+    };
+
+    struct InverseFunction {
+        MpfrFunction function;
+        bool reciprocal; // evaluated at 1/x
+        bool degrees; // the result is an angle in degrees
+        Derivative derivative; // of the function, at the reciprocal
+    };
+
+    const std::unordered_map<std::string_view, MpfrFunction>& correctly_rounded_unary() {
+        static const std::unordered_map<std::string_view, MpfrFunction> functions{
+            {"ABSOLUTE", mpfr_abs}, {"FLOOR", mpfr_rint_floor}, {"CEILING", mpfr_rint_ceil},
+            {"HYP_SINE", mpfr_sinh}, {"HYP_COSINE", mpfr_cosh}, {"HYP_TANGENT", mpfr_tanh},
+            {"HYP_SECANT", mpfr_sech}, {"HYP_COSECANT", mpfr_csch}, {"HYP_COTANGENT", mpfr_coth},
+            {"INVERSE_HYP_SINE", mpfr_asinh}, {"INVERSE_HYP_COSINE", mpfr_acosh},
+            {"INVERSE_HYP_TANGENT", mpfr_atanh}, {"NATURAL_LOGARITHM", mpfr_log},
+            {"BINARY_LOGARITHM", mpfr_log2}, {"COMMON_LOGARITHM", mpfr_log10}
+        };
+        return functions;
+    }
+
+    const std::unordered_map<std::string_view, DegreeFunction>& degree_functions() {
+        static const std::unordered_map<std::string_view, DegreeFunction> functions{
+            {"SINE", {mpfr_sin, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) { mpfr_cos(d, u, MPFR_RNDN); }, 0, -1}},
+            {"COSINE", {mpfr_cos, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) { mpfr_sin(d, u, MPFR_RNDN); }, 90, -1}},
+            {"TANGENT", {mpfr_tan, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sec(d, u, MPFR_RNDN);
+                mpfr_sqr(d, d, MPFR_RNDN);
+            }, 0, 90}},
+            {"SECANT", {mpfr_sec, [](mpfr_ptr d, mpfr_ptr scratch, mpfr_srcptr u) {
+                mpfr_sec(d, u, MPFR_RNDN);
+                mpfr_tan(scratch, u, MPFR_RNDN);
+                mpfr_mul(d, d, scratch, MPFR_RNDN);
+            }, -1, 90}},
+            {"COSECANT", {mpfr_csc, [](mpfr_ptr d, mpfr_ptr scratch, mpfr_srcptr u) {
+                mpfr_csc(d, u, MPFR_RNDN);
+                mpfr_cot(scratch, u, MPFR_RNDN);
+                mpfr_mul(d, d, scratch, MPFR_RNDN);
+            }, -1, 0}},
+            {"COTANGENT", {mpfr_cot, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_csc(d, u, MPFR_RNDN);
+                mpfr_sqr(d, d, MPFR_RNDN);
+            }, 90, 0}},
+        };
+        return functions;
+    }
+
+    const std::unordered_map<std::string_view, InverseFunction>& inverse_functions() {
+        // 1/sqrt(1 - u^2), the derivative of asin and, up to its sign, of acos.
+        constexpr Derivative circular{
+            [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sqr(d, u, MPFR_RNDN);
+                mpfr_ui_sub(d, 1, d, MPFR_RNDN);
+                mpfr_rec_sqrt(d, d, MPFR_RNDN);
+            }
+        };
+        static const std::unordered_map<std::string_view, InverseFunction> functions{
+            {"INVERSE_SINE", {mpfr_asin, false, true, nullptr}},
+            {"INVERSE_COSINE", {mpfr_acos, false, true, nullptr}},
+            {"INVERSE_TANGENT", {mpfr_atan, false, true, nullptr}},
+            {"INVERSE_COSECANT", {mpfr_asin, true, true, circular}},
+            {"INVERSE_SECANT", {mpfr_acos, true, true, circular}},
+            {"INVERSE_COTANGENT", {mpfr_atan, true, true, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sqr(d, u, MPFR_RNDN);
+                mpfr_add_ui(d, d, 1, MPFR_RNDN);
+                mpfr_ui_div(d, 1, d, MPFR_RNDN);
+            }}},
+            {"INVERSE_HYP_SECANT", {mpfr_acosh, true, false, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sqr(d, u, MPFR_RNDN);
+                mpfr_sub_ui(d, d, 1, MPFR_RNDN);
+                mpfr_rec_sqrt(d, d, MPFR_RNDN);
+            }}},
+            {"INVERSE_HYP_COSECANT", {mpfr_asinh, true, false, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sqr(d, u, MPFR_RNDN);
+                mpfr_add_ui(d, d, 1, MPFR_RNDN);
+                mpfr_rec_sqrt(d, d, MPFR_RNDN);
+            }}},
+            {"INVERSE_HYP_COTANGENT", {mpfr_atanh, true, false, [](mpfr_ptr d, mpfr_ptr, mpfr_srcptr u) {
+                mpfr_sqr(d, u, MPFR_RNDN);
+                mpfr_ui_sub(d, 1, d, MPFR_RNDN);
+                mpfr_ui_div(d, 1, d, MPFR_RNDN);
+            }}},
+        };
+        return functions;
+    }
+}
+
+bool mmqli::core::Core::calculate_adaptive_queries(const std::string& query, const float1000& first_operand,
+                                                    const float1000& second_operand) {
+    const std::size_t digits{Ziv::digits()};
+    mpfr_srcptr a{first_operand.backend().data()};
+    mpfr_srcptr b{second_operand.backend().data()};
+    const Ziv::Operand first{a, operand_as_written(written[0])};
+    const Ziv::Operand second{b, operand_as_written(written[1])};
+    bool unary{true};
+    bool adapted{false};
+    std::optional<Ziv::Answer> answer;
+    // the checks below look at the float1000 operands, the kernels at the ones of the working precision.
+    const auto adapt{
+        [&](auto&& kernel) {
+            adapted = true;
+            answer = Ziv::evaluate(digits, first, unary ? Ziv::Operand{} : second, kernel);
+            return true;
+        }
+    };
+    // the exact answer of the operands as written, rounded at every working precision.
+    const auto rational{
+        [&](const mpq_class& exact) {
+            adapted = true;
+            answer = Ziv::evaluate(digits, [&exact](mpfr_ptr y) {
+                return Ziv::rounded(mpfr_set_q(y, exact.get_mpq_t(), MPFR_RNDN));
+            });
+            return true;
+        }
+    };
+    const auto evaluated{
+        [&] {
+            if (const Special::Function function{Special::unary(query)}; function != nullptr || query == "ZETA") {
+                if (Special::has_pole(query, a))
+                    return reject(Errors::Code::domain, query + " has a pole at " + to_str(first_operand) + " !");
+                if (function == nullptr)
+                    return adapt([](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) { return Special::zeta(y, x); });
+                return adapt([function](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) {
+                    return Ziv::rounded(function(y, x, MPFR_RNDN));
+                });
+            }
+            if (const auto found{correctly_rounded_unary().find(query)}; found != correctly_rounded_unary().end())
+                return adapt([function{found->second}](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) {
+                    return Ziv::rounded(function(y, x, MPFR_RNDN));
+                });
+            if (const auto found{degree_functions().find(query)}; found != degree_functions().end()) {
+                const DegreeFunction& trig{found->second};
+                // the angles at which the function is 0 or has a pole are found exactly, from the degrees.
+                precision::Register residue{precision::float1000_bits};
+                mpfr_fmod_ui(residue.get(), a, 180, MPFR_RNDN);
+                mpfr_abs(residue.get(), residue.get(), MPFR_RNDN);
+                if (trig.pole_at >= 0 && mpfr_cmp_ui(residue.get(), trig.pole_at) == 0)
+                    return reject(Errors::Code::domain, query + " is undefined at " + to_str(first_operand) + " degrees !");
+                if (trig.zero_at >= 0 && mpfr_cmp_ui(residue.get(), trig.zero_at) == 0)
+                    return adapt([](mpfr_ptr y, mpfr_srcptr, mpfr_srcptr) {
+                        mpfr_set_zero(y, 1);
+                        return Ziv::Bound{true, 0};
+                    });
+                return adapt([&trig](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) {
+                    // u = pi x / 180 carries three roundings, below 2^(2 - p) relatively.
+                    precision::Register u{mpfr_get_prec(y)};
+                    mpfr_const_pi(u.get(), MPFR_RNDN);
+                    mpfr_mul(u.get(), u.get(), x, MPFR_RNDN);
+                    mpfr_div_ui(u.get(), u.get(), 180, MPFR_RNDN);
+                    trig.function(y, u.get(), MPFR_RNDN);
+                    precision::Register derivative{derivative_bits}, scratch{derivative_bits};
+                    trig.derivative(derivative.get(), scratch.get(), u.get());
+                    return Ziv::Bound{false, Ziv::condition_loss(y, u.get(), derivative.get(), 2)};
+                });
+            }
+            if (const auto found{inverse_functions().find(query)}; found != inverse_functions().end()) {
+                const InverseFunction& inverse{found->second};
+                return adapt([&inverse](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) {
+                    precision::Register u{mpfr_get_prec(y)};
+                    const int reciprocal{inverse.reciprocal ? mpfr_ui_div(u.get(), 1, x, MPFR_RNDN) : 0};
+                    mpfr_srcptr argument{inverse.reciprocal ? u.get() : x};
+                    Ziv::Bound bound{Ziv::rounded(inverse.function(y, argument, MPFR_RNDN))};
+                    if (reciprocal != 0) {
+                        // 1/x is rounded once, its error is amplified by the derivative.
+                        precision::Register derivative{derivative_bits}, scratch{derivative_bits};
+                        inverse.derivative(derivative.get(), scratch.get(), argument);
+                        bound = {false, Ziv::condition_loss(y, argument, derivative.get(), 0)};
+                    }
+                    if (!inverse.degrees || (bound.exact && mpfr_zero_p(y)))
+                        return bound;
+                    // 180 y / pi adds three roundings.
+                    precision::Register pi{mpfr_get_prec(y)};
+                    mpfr_const_pi(pi.get(), MPFR_RNDN);
+                    mpfr_mul_ui(y, y, 180, MPFR_RNDN);
+                    mpfr_div(y, y, pi.get(), MPFR_RNDN);
+                    return Ziv::Bound{false, bound.lost_bits + 3};
+                });
+            }
+            if (query == "FACTORIAL" && mpfr_integer_p(a) && mpfr_sgn(a) >= 0 && mpfr_fits_ulong_p(a, MPFR_RNDN))
+                return adapt([n{mpfr_get_ui(a, MPFR_RNDN)}](mpfr_ptr y, mpfr_srcptr, mpfr_srcptr) {
+                    return Ziv::rounded(mpfr_fac_ui(y, n, MPFR_RNDN));
+                });
+            unary = false;
+            using Binary = int (*)(mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+            const auto correctly_rounded{
+                [&](const Binary function) {
+                    return adapt([function](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr z) {
+                        return Ziv::rounded(function(y, x, z, MPFR_RNDN));
+                    });
+                }
+            };
+            // the four operations and MODULO of the operands as written are exact, ADD 0.1,0.2 is 3/10.
+            if (const auto &x{first.rational()}, &z{second.rational()}; x && z) {
+                if (query == "ADD") return rational(*x + *z);
+                if (query == "SUBTRACT") return rational(*x - *z);
+                if (query == "MULTIPLY") return rational(*x * *z);
+                if (query == "DIVIDE" && sgn(*z) != 0) return rational(*x / *z);
+                if (query == "MODULO" && sgn(*z) != 0) {
+                    // the remainder of the quotient truncated toward zero, like mpfr_fmod.
+                    const mpq_class quotient{*x / *z};
+                    mpz_class truncated;
+                    mpz_tdiv_q(truncated.get_mpz_t(), quotient.get_num_mpz_t(), quotient.get_den_mpz_t());
+                    return rational(*x - *z * truncated);
+                }
+            }
+            if (query == "ADD") return correctly_rounded(mpfr_add);
+            if (query == "SUBTRACT") return correctly_rounded(mpfr_sub);
+            if (query == "MULTIPLY") return correctly_rounded(mpfr_mul);
+            if (query == "POWER") return correctly_rounded(mpfr_pow);
+            if (query == "DIVIDE") {
+                if (mpfr_zero_p(b)) return reject(Errors::Code::division_by_zero, "Division by zero is undefined !");
+                return correctly_rounded(mpfr_div);
+            }
+            if (query == "MODULO") {
+                if (mpfr_zero_p(b)) return reject(Errors::Code::division_by_zero, "Cannot divide by zero");
+                return correctly_rounded(mpfr_fmod);
+            }
+            if (query == "ROOT") {
+                if (mpfr_zero_p(b)) return reject(Errors::Code::domain, "Zeroeth root is undefined !");
+                if (mpfr_integer_p(b) && mpfr_sgn(b) > 0 && mpfr_fits_ulong_p(b, MPFR_RNDN))
+                    return adapt([n{mpfr_get_ui(b, MPFR_RNDN)}](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr) {
+                        return Ziv::rounded(mpfr_rootn_ui(y, x, n, MPFR_RNDN));
+                    });
+                return adapt([](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr z) {
+                    // x^(1/z), the rounding of 1/z is amplified by |ln(x) / z|.
+                    precision::Register exponent{mpfr_get_prec(y)};
+                    const int reciprocal{mpfr_ui_div(exponent.get(), 1, z, MPFR_RNDN)};
+                    const Ziv::Bound bound{Ziv::rounded(mpfr_pow(y, x, exponent.get(), MPFR_RNDN))};
+                    if (reciprocal == 0)
+                        return bound;
+                    precision::Register derivative{derivative_bits};
+                    mpfr_abs(derivative.get(), x, MPFR_RNDN);
+                    mpfr_log(derivative.get(), derivative.get(), MPFR_RNDN);
+                    mpfr_mul(derivative.get(), derivative.get(), y, MPFR_RNDN);
+                    return Ziv::Bound{false, Ziv::condition_loss(y, exponent.get(), derivative.get(), 0)};
+                });
+            }
+            if (query == "BESSEL_J" || query == "BESSEL_Y") {
+                const std::optional<long> order{Special::order(a)};
+                if (!order)
+                    return reject(Errors::Code::domain, "The order of " + query + " must be an integer !");
+                if (query == "BESSEL_Y" && mpfr_sgn(b) <= 0)
+                    return reject(Errors::Code::domain, "BESSEL_Y is only defined for positive numbers !");
+                return adapt([n{*order}, second_kind{query == "BESSEL_Y"}](mpfr_ptr y, mpfr_srcptr, mpfr_srcptr z) {
+                    return Ziv::rounded(Special::bessel(y, second_kind, n, z));
+                });
+            }
+            if (query == "INCOMPLETE_GAMMA") {
+                if (mpfr_sgn(b) < 0)
+                    return reject(Errors::Code::domain, "INCOMPLETE_GAMMA is only defined for nonnegative bounds !");
+                return correctly_rounded(mpfr_gamma_inc);
+            }
+            if (query == "LOGARITHM")
+                return adapt([](mpfr_ptr y, mpfr_srcptr x, mpfr_srcptr z) {
+                    // log(x) / log(z), three roundings.
+                    precision::Register base{mpfr_get_prec(y)};
+                    const int numerator{mpfr_log(y, x, MPFR_RNDN)};
+                    const int denominator{mpfr_log(base.get(), z, MPFR_RNDN)};
+                    const int quotient{mpfr_div(y, y, base.get(), MPFR_RNDN)};
+                    return Ziv::Bound{numerator == 0 && denominator == 0 && quotient == 0, 2};
+                });
+            return OPERATION_FAILURE; // no adaptive kernel, evaluated at the precision of float1000
+        }
+    };
+    if (!evaluated())
+        return OPERATION_FAILURE;
+    if (!adapted)
+        return OPERATION_SUCCESS; // answered with its error
+    if (!answer)
+        return reject(Errors::Code::evaluation,
+                      std::to_string(digits) + " correct digits of " + query + " cannot be certified !");
+    results.emplace_back(unary
+                             ? join({query, " ", to_str(first_operand), " = ", answer->text, "\n"})
+                             : join({query, " ", to_str(first_operand), ",", to_str(second_operand), " = ",
+                                     answer->text, "\n"}));
+    return OPERATION_SUCCESS;
+}
+
 void mmqli::core::Core::process_real_queries() {
     if (parsed_reals.empty())
         return;
-    for (const auto& parsedToken : parsed_reals) {
-        std::string QUERY = std::get<0>(parsedToken);
-        if (std::smatch m; std::regex_match(QUERY, m, grammar::queries::internal::var_get_internalReal)) {
+    for (std::size_t i = 0; i < parsed_reals.size(); ++i) {
+        const auto& parsedToken = parsed_reals[i];
+        const std::string& QUERY = std::get<0>(parsedToken);
+        enter(sources.reals, i);
+        if (Ziv::digits() != 0 && i < sources.real_operands.size())
+            written = sources.real_operands[i];
+        const profiler::Scope timer{"real", QUERY};
+        // only the variable lookups start with GET, the other queries skip the regular expressions.
+        if (std::smatch m; QUERY.starts_with("GET") &&
+                           (std::regex_match(QUERY, m, grammar::queries::internal::var_get_internalReal) ||
+                            std::regex_match(QUERY, m, grammar::queries::internal::var_get_internalLiteral))) {
             results.emplace_back(QUERY + "\n");
             continue;
         }
-        const float1000 F_OPERAND = std::get<1>(parsedToken);
-        // ReSharper disable once CppTooWideScopeInitStatement
-        const float1000 S_OPERAND = std::get<2>(parsedToken);
-        if (calculate_real_queries_single_operand(QUERY, F_OPERAND) ||
-            calculate_real_queries_double_operands(QUERY, F_OPERAND, S_OPERAND)) { continue; }
-        std::string current_error = "Syntax Fault: MmQLC failed to process " + QUERY;
-        attach_error(current_error);
+        evaluate_real_query(QUERY, std::get<1>(parsedToken), std::get<2>(parsedToken));
+    }
+}
+
+void mmqli::core::Core::evaluate_real_query(const std::string& QUERY, const float1000& F_OPERAND,
+                                            const float1000& S_OPERAND) {
+    if (guarded([&] {
+        return (Ziv::digits() != 0 && calculate_adaptive_queries(QUERY, F_OPERAND, S_OPERAND)) ||
+               calculate_real_queries_single_operand(QUERY, F_OPERAND) ||
+               calculate_real_queries_double_operands(QUERY, F_OPERAND, S_OPERAND) ||
+               calculate_special_queries(QUERY, F_OPERAND, S_OPERAND) ||
+               calculate_plugin_queries(QUERY, F_OPERAND, S_OPERAND);
+    })) { return; }
+    reject(Errors::Code::syntax, "Syntax Fault: MmQLC failed to process " + QUERY);
+}
+
+bool mmqli::core::Core::calculate_exact_queries(const std::string& query, const mpq_class& first_operand,
+                                                const mpq_class& second_operand) {
+    const std::optional<mpq_class> result{Exact::evaluate(query, first_operand, second_operand)};
+    if (!result)
+        return OPERATION_FAILURE;
+    // a fraction only answers a query written with one, DIVIDE 1,3 is answered with its digits.
+    if (!Exact::integer(*result) && Exact::integer(first_operand) && Exact::integer(second_operand))
+        return OPERATION_FAILURE;
+    const profiler::Scope timer{"stage", "format"};
+    keep(*result); // the binary output has no exact numbers, the answer is only kept as text
+    if (Exact::single_operand(query))
+        results.emplace_back(join({query, " ", to_str(first_operand), " = ", to_str(*result), "\n"}));
+    else
+        results.emplace_back(join({query, " ", to_str(first_operand), ",", to_str(second_operand), " = ",
+                                   to_str(*result), "\n"}));
+    return OPERATION_SUCCESS;
+}
+
+void mmqli::core::Core::process_exact_queries() {
+    for (std::size_t i = 0; i < parsed_exact.size(); ++i) {
+        const auto& [QUERY, F_OPERAND, S_OPERAND] = parsed_exact[i];
+        const profiler::Scope timer{"exact", QUERY};
+        enter(sources.exact, i);
+        if (calculate_exact_queries(QUERY, F_OPERAND, S_OPERAND))
+            continue;
+        if (Ziv::digits() != 0)
+            written = {Exact::to_str(F_OPERAND), Exact::to_str(S_OPERAND)};
+        evaluate_real_query(QUERY, Exact::promote(F_OPERAND), Exact::promote(S_OPERAND));
     }
 }
 
@@ -478,24 +968,23 @@ bool mmqli::core::Core::calculate_complex_queries_double_operands(const std::str
         return true;
     }
     else if (query == "DIVIDE") {
-        if (second_operand == zero) {
-            throw std::runtime_error("Cannot divide complex number by zero !");
+        if (second_operand == constants::complex_zero) {
+            return reject(Errors::Code::division_by_zero, "Cannot divide complex number by zero !");
         }
         const auto result = first_operand / second_operand;
         results.emplace_back(build_output(query, first_operand, second_operand, result));
         return true;
     }
     else if (query == "POWER") {
-        auto result = std::pow(first_operand, second_operand);
+        auto result = Powers::power(first_operand, second_operand);
         results.emplace_back(build_output(query, first_operand, second_operand, result));
         return true;
     }
     else if (query == "ROOT") {
-        if (second_operand == zero) {
-            throw std::runtime_error("Zeroth root of complex number is undefined !");
+        if (second_operand == constants::complex_zero) {
+            return reject(Errors::Code::domain, "Zeroth root of complex number is undefined !");
         }
-        const auto ind = one / second_operand;
-        const auto result = std::pow(first_operand, ind);
+        const auto result = Powers::root(first_operand, second_operand);
         results.emplace_back(build_output(query, first_operand, second_operand, result));
         return true;
     }
@@ -513,10 +1002,14 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
     }
     else if (query == "ARGUMENT") {
         float1000 rads(std::arg(operand));
-        float1000 degs(hf::radians_to_degrees(rads));
+        float1000 degs(AngleConv::radians_to_degrees(rads));
         results.emplace_back(build_output(query, operand, degs));
         return true;
     }
+    else if (query == "POLAR") {
+        results.emplace_back(build_output(query, operand, Families::polar(operand)));
+        return true;
+    }
     else if (query == "SINE") {
         auto sine = std::sin(operand);
         results.emplace_back(build_output(query, operand, sine));
@@ -533,17 +1026,17 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
         return true;
     }
     else if (query == "COTANGENT") {
-        auto cotangent = ct::cot(operand);
+        auto cotangent = ComplexTrig::cotangent(operand);
         results.emplace_back(build_output(query, operand, cotangent));
         return true;
     }
     else if (query == "SECANT") {
-        auto secant = ct::sec(operand);
+        auto secant = ComplexTrig::secant(operand);
         results.emplace_back(build_output(query, operand, secant));
         return true;
     }
     else if (query == "COSECANT") {
-        auto cosecant = ct::csc(operand);
+        auto cosecant = ComplexTrig::cosecant(operand);
         results.emplace_back(build_output(query, operand, cosecant));
         return true;
     }
@@ -563,17 +1056,17 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
         return true;
     }
     else if (query == "INVERSE_COTANGENT") {
-        auto inverseCot = ct::acot(operand);
+        auto inverseCot = ComplexTrig::inverse_cotangent(operand);
         results.emplace_back(build_output(query, operand, inverseCot));
         return true;
     }
     else if (query == "INVERSE_SECANT") {
-        auto inverseSec = ct::asec(operand);
+        auto inverseSec = ComplexTrig::inverse_secant(operand);
         results.emplace_back(build_output(query, operand, inverseSec));
         return true;
     }
     else if (query == "INVERSE_COSECANT") {
-        auto inverseCsc = ct::acsc(operand);
+        auto inverseCsc = ComplexTrig::inverse_cosecant(operand);
         results.emplace_back(build_output(query, operand, inverseCsc));
         return true;
     }
@@ -593,17 +1086,17 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
         return true;
     }
     else if (query == "HYP_COTANGENT") {
-        auto Cothan = ct::coth(operand);
+        auto Cothan = ComplexTrig::cotangent_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, Cothan));
         return true;
     }
     else if (query == "HYP_SECANT") {
-        auto Shek = ct::sech(operand);
+        auto Shek = ComplexTrig::secant_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, Shek));
         return true;
     }
     else if (query == "HYP_COSECANT") {
-        auto CoShek = ct::csch(operand);
+        auto CoShek = ComplexTrig::cosecant_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, CoShek));
         return true;
     }
@@ -623,23 +1116,23 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
         return true;
     }
     else if (query == "INVERSE_HYP_COTANGENT") {
-        auto InvCOTH = ct::acoth(operand);
+        auto InvCOTH = ComplexTrig::inverse_cotangent_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, InvCOTH));
         return true;
     }
     else if (query == "INVERSE_HYP_SECANT") {
-        auto InvSheck = ct::asech(operand);
+        auto InvSheck = ComplexTrig::inverse_secant_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, InvSheck));
         return true;
     }
     else if (query == "INVERSE_HYP_COSECANT") {
-        auto INV_CSCH = ct::acsch(operand);
+        auto INV_CSCH = ComplexTrig::inverse_cosecant_hyperbolic(operand);
         results.emplace_back(build_output(query, operand, INV_CSCH));
         return true;
     }
     else if (query == "NATURAL_LOGARITHM") {
-        if (operand == zero) {
-            throw std::runtime_error("Cannot take log of zero !");
+        if (operand == constants::complex_zero) {
+            return reject(Errors::Code::domain, "Cannot take log of zero !");
         }
         auto ln = std::log(operand);
         results.emplace_back(build_output(query, operand, ln));
@@ -660,51 +1153,801 @@ calculate_complex_queries_single_operand(const std::string& query, const complex
     }
 }
 
+bool mmqli::core::Core::calculate_plugin_queries(const std::string& query, const complex1000& first_operand,
+                                                  const complex1000& second_operand) {
+    const Plugins::Function* function{Plugins::find(query, Plugins::Kind::complex)};
+    if (function == nullptr)
+        return OPERATION_FAILURE;
+    complex1000 result;
+    call_plugin(*function, query, result, first_operand, second_operand);
+    results.emplace_back(function->arity == 1
+                             ? build_output(query, first_operand, result)
+                             : build_output(query, first_operand, second_operand, result));
+    return OPERATION_SUCCESS;
+}
+
 void mmqli::core::Core::process_complex_queries() {
     if (parsed_complex.empty()) // if there is no complex query...... !
         return;
-    for (const auto& parsedToken : parsed_complex) {
-        std::string QUERY = std::get<0>(parsedToken);
-        if (std::smatch m; std::regex_match(QUERY, m, grammar::queries::internal::var_get_internalComplex)) {
+    for (std::size_t i = 0; i < parsed_complex.size(); ++i) {
+        const auto& parsedToken = parsed_complex[i];
+        const std::string& QUERY = std::get<0>(parsedToken);
+        enter(sources.complex, i);
+        const profiler::Scope timer{"complex", QUERY};
+        if (std::smatch m; QUERY.starts_with("GET") &&
+                           std::regex_match(QUERY, m, grammar::queries::internal::var_get_internalComplex)) {
             results.emplace_back(QUERY + "\n");
             continue;
         }
-        const complex1000 F_OPERAND = std::get<1>(parsedToken);
+        const complex1000& F_OPERAND = std::get<1>(parsedToken);
         // ReSharper disable once CppTooWideScopeInitStatement
-        const complex1000 S_OPERAND = std::get<2>(parsedToken);
+        const complex1000& S_OPERAND = std::get<2>(parsedToken);
 
-        if (calculate_complex_queries_single_operand(QUERY, F_OPERAND) ||
-            calculate_complex_queries_double_operands(QUERY, F_OPERAND, S_OPERAND)) { continue; }
-        std::string current_error = "mmqli failed to evaluate " + QUERY;
-        attach_error(current_error);
+        if (guarded([&] {
+            return calculate_complex_queries_single_operand(QUERY, F_OPERAND) ||
+                   calculate_complex_queries_double_operands(QUERY, F_OPERAND, S_OPERAND) ||
+                   calculate_plugin_queries(QUERY, F_OPERAND, S_OPERAND);
+        })) { continue; }
+        reject(Errors::Code::syntax, "mmqli failed to evaluate " + QUERY);
     }
 }
 
-void mmqli::core::Core::attach_error(const std::string& err) {
-    errors.emplace_back(err);
+bool mmqli::core::Core::calculate_real_batch_double_operands(const std::string& query,
+                                                             const std::vector<float1000>& first_operands,
+                                                             const std::vector<float1000>& second_operands) {
+    const auto finish{
+        [&](const Batch::RealBatch& result) {
+            results.emplace_back(build_output(query, first_operands, second_operands, result));
+            return OPERATION_SUCCESS;
+        }
+    };
+    // the zero divisors are found before the kernels run, so a bad element does not stop the workers half way.
+    const bool zero_divisor{
+        (query == "DIVIDE" || query == "ROOT" || query == "MODULO") &&
+        std::ranges::any_of(second_operands, [](const float1000& b) { return b == 0; })
+    };
+    if (zero_divisor && query == "ROOT")
+        return reject(Errors::Code::domain, "Zeroeth root is undefined !");
+    if (zero_divisor)
+        return reject(Errors::Code::division_by_zero, "Division by zero is undefined !");
+    if ((query == "BESSEL_J" || query == "BESSEL_Y") &&
+        !std::ranges::all_of(first_operands, [](const float1000& n) {
+            return Special::order(n.backend().data()).has_value();
+        }))
+        return reject(Errors::Code::domain, "The order of " + query + " must be an integer !");
+    if (query == "ADD")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_add(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "SUBTRACT")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_sub(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "MULTIPLY")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_mul(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "DIVIDE")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_div(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "POWER")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     Powers::power(r, a, b);
+                                 }));
+    if (query == "ROOT")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr n, Batch::RealBatchContext& context) {
+                                     Powers::root(r, a, n, context.scratch.backend().data());
+                                 }));
+    if (query == "BESSEL_J" || query == "BESSEL_Y")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [second_kind{query == "BESSEL_Y"}](mpfr_ptr r, mpfr_srcptr n, mpfr_srcptr x,
+                                                                    Batch::RealBatchContext&) {
+                                     Special::bessel(r, second_kind, *Special::order(n), x);
+                                 }));
+    if (query == "INCOMPLETE_GAMMA")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_gamma_inc(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "LOGARITHM")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext& context) {
+                                     mpfr_log10(context.scratch.backend().data(), a, MPFR_RNDN);
+                                     mpfr_log10(r, b, MPFR_RNDN);
+                                     mpfr_div(r, context.scratch.backend().data(), r, MPFR_RNDN);
+                                 }));
+    if (query == "MODULO")
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     mpfr_fmod(r, a, b, MPFR_RNDN);
+                                 }));
+    if (query == "POLYVAL")
+        return finish(Polynomial::evaluate(first_operands, second_operands));
+    if (query == "INTEGRATE" || query == "INTEGRATE_TANH_SINH") {
+        // the integrand is the polynomial of the first operand, the bounds are the second operand.
+        if (second_operands.size() != 2)
+            return reject(Errors::Code::invalid_literal, "Integration bounds must be written as [a,b] !");
+        const float1000 integral{
+            Integration::integrate(
+                query == "INTEGRATE" ? Integration::Rule::gauss_legendre : Integration::Rule::tanh_sinh,
+                second_operands[0], second_operands[1],
+                [&](const Batch::RealBatch& points) { return Polynomial::evaluate(first_operands, points); })
+        };
+        results.emplace_back(build_output(query, first_operands, second_operands, integral));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "PERMUTATION" || query == "COMBINATION") {
+        const bool permutation{query == "PERMUTATION"};
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [permutation](mpfr_ptr r, mpfr_srcptr n, mpfr_srcptr k, Batch::RealBatchContext&) {
+                                     const float1000 result{
+                                         permutation
+                                             ? Combinatorics::permutation(float1000{n}, float1000{k})
+                                             : Combinatorics::combination(float1000{n}, float1000{k})
+                                     };
+                                     mpfr_set(r, result.backend().data(), MPFR_RNDN);
+                                 }));
+    }
+    if (const Plugins::Function* function{Plugins::find(query, Plugins::Kind::real)};
+        function != nullptr && function->arity == 2)
+        return finish(Batch::zip(first_operands, second_operands,
+                                 [function, &query](mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, Batch::RealBatchContext&) {
+                                     call_plugin(*function, query, r, a, b);
+                                 }));
+    return calculate_vector_queries(query, first_operands, second_operands);
 }
 
-std::string mmqli::core::Core::get_string_errors() {
-    std::ranges::sort(errors);
-    auto l = std::ranges::unique(errors);
-    errors.erase(l.begin(), errors.end());
-    std::string allErrors;
-    for (const auto& err : errors) {
-        allErrors.append(err);
-        allErrors.append("\n");
+bool mmqli::core::Core::map_real_batch(const std::string& query, const std::vector<float1000>& operands,
+                                       Batch::RealBatch& result) {
+    const auto finish{
+        [&](Batch::RealBatch&& mapped) {
+            result = std::move(mapped);
+            return OPERATION_SUCCESS;
+        }
+    };
+    // kernels taking degrees, the conversion is done into the per-batch scratch register.
+    const auto degrees_kernel{
+        [&](auto&& function) {
+            return Batch::map(operands, [&function](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+                context.degrees_to_radians(context.scratch.backend().data(), x);
+                function(r, context.scratch.backend().data(), MPFR_RNDN);
+            });
+        }
+    };
+    // kernels giving degrees, the reciprocal argument is formed when asked for.
+    const auto inverse_kernel{
+        [&](auto&& function, const bool reciprocal) {
+            return Batch::map(operands, [&function, reciprocal](mpfr_ptr r, mpfr_srcptr x,
+                                                                 Batch::RealBatchContext& context) {
+                mpfr_ptr scratch{context.scratch.backend().data()};
+                if (reciprocal) {
+                    mpfr_ui_div(scratch, 1, x, MPFR_RNDN);
+                    function(scratch, scratch, MPFR_RNDN);
+                }
+                else
+                    function(scratch, x, MPFR_RNDN);
+                context.radians_to_degrees(r, scratch);
+            });
+        }
+    };
+    const auto plain_kernel{
+        [&](auto&& function, const bool reciprocal = false) {
+            return Batch::map(operands, [&function, reciprocal](mpfr_ptr r, mpfr_srcptr x,
+                                                                 Batch::RealBatchContext& context) {
+                if (!reciprocal) {
+                    function(r, x, MPFR_RNDN);
+                    return;
+                }
+                mpfr_ui_div(context.scratch.backend().data(), 1, x, MPFR_RNDN);
+                function(r, context.scratch.backend().data(), MPFR_RNDN);
+            });
+        }
+    };
+    if (query == "FACTORIAL")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+            mpfr_add_ui(context.scratch.backend().data(), x, 1, MPFR_RNDN);
+            mpfr_gamma(r, context.scratch.backend().data(), MPFR_RNDN);
+        }));
+    if (query == "ABSOLUTE") return finish(plain_kernel(mpfr_abs));
+    if (query == "FLOOR")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext&) {
+            mpfr_floor(r, x);
+        }));
+    if (query == "CEILING")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext&) {
+            mpfr_ceil(r, x);
+        }));
+    if (query == "SINE") return finish(degrees_kernel(mpfr_sin));
+    if (query == "COSINE") return finish(degrees_kernel(mpfr_cos));
+    if (query == "TANGENT")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+            mpfr_ptr scratch{context.scratch.backend().data()};
+            mpfr_fmod_ui(scratch, x, 90, MPFR_RNDN);
+            if (mpfr_zero_p(scratch)) {
+                mpfr_set_inf(r, 1);
+                return;
+            }
+            context.degrees_to_radians(scratch, x);
+            mpfr_tan(r, scratch, MPFR_RNDN);
+        }));
+    if (query == "COTANGENT")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+            if (mpfr_cmp_ui(x, 90) == 0) mpfr_set_zero(r, 1);
+            else if (mpfr_zero_p(x)) mpfr_set_inf(r, 1);
+            else {
+                context.degrees_to_radians(context.scratch.backend().data(), x);
+                mpfr_cot(r, context.scratch.backend().data(), MPFR_RNDN);
+            }
+        }));
+    if (query == "COSECANT")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+            if (mpfr_zero_p(x)) mpfr_set_inf(r, 1);
+            else {
+                context.degrees_to_radians(context.scratch.backend().data(), x);
+                mpfr_csc(r, context.scratch.backend().data(), MPFR_RNDN);
+            }
+        }));
+    if (query == "SECANT")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext& context) {
+            if (mpfr_cmp_ui(x, 90) == 0) mpfr_set_inf(r, 1);
+            else {
+                context.degrees_to_radians(context.scratch.backend().data(), x);
+                mpfr_sec(r, context.scratch.backend().data(), MPFR_RNDN);
+            }
+        }));
+    if (query == "INVERSE_SINE") return finish(inverse_kernel(mpfr_asin, false));
+    if (query == "INVERSE_COSINE") return finish(inverse_kernel(mpfr_acos, false));
+    if (query == "INVERSE_TANGENT") return finish(inverse_kernel(mpfr_atan, false));
+    if (query == "INVERSE_COTANGENT") return finish(inverse_kernel(mpfr_atan, true));
+    if (query == "INVERSE_COSECANT") return finish(inverse_kernel(mpfr_asin, true));
+    if (query == "INVERSE_SECANT") return finish(inverse_kernel(mpfr_acos, true));
+    if (query == "HYP_SINE") return finish(plain_kernel(mpfr_sinh));
+    if (query == "HYP_COSINE") return finish(plain_kernel(mpfr_cosh));
+    if (query == "HYP_TANGENT") return finish(plain_kernel(mpfr_tanh));
+    if (query == "HYP_COTANGENT") return finish(plain_kernel(mpfr_coth));
+    if (query == "HYP_COSECANT") return finish(plain_kernel(mpfr_csch));
+    if (query == "HYP_SECANT") return finish(plain_kernel(mpfr_sech));
+    if (query == "INVERSE_HYP_SINE") return finish(plain_kernel(mpfr_asinh));
+    if (query == "INVERSE_HYP_COSINE") return finish(plain_kernel(mpfr_acosh));
+    if (query == "INVERSE_HYP_TANGENT") return finish(plain_kernel(mpfr_atanh));
+    if (query == "INVERSE_HYP_COTANGENT") return finish(plain_kernel(mpfr_atanh, true));
+    if (query == "INVERSE_HYP_COSECANT") return finish(plain_kernel(mpfr_asinh, true));
+    if (query == "INVERSE_HYP_SECANT") return finish(plain_kernel(mpfr_acosh, true));
+    if (query == "NATURAL_LOGARITHM") return finish(plain_kernel(mpfr_log));
+    if (query == "BINARY_LOGARITHM") return finish(plain_kernel(mpfr_log2));
+    if (query == "COMMON_LOGARITHM") return finish(plain_kernel(mpfr_log10));
+    if (const Special::Function function{Special::unary(query)}; function != nullptr)
+        return finish(plain_kernel(function));
+    if (query == "ZETA")
+        return finish(Batch::map(operands, [](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext&) {
+            Special::zeta(r, x);
+        }));
+    if (const Plugins::Function* function{Plugins::find(query, Plugins::Kind::real)};
+        function != nullptr && function->arity == 1)
+        return finish(Batch::map(operands, [function, &query](mpfr_ptr r, mpfr_srcptr x, Batch::RealBatchContext&) {
+            call_plugin(*function, query, r, x, x);
+        }));
+    return OPERATION_FAILURE;
+}
+
+bool mmqli::core::Core::calculate_real_batch_single_operand(const std::string& query,
+                                                            const std::vector<float1000>& operands) {
+    const auto reduced{
+        [&](const float1000& result) {
+            results.emplace_back(build_output(query, operands, result));
+            return OPERATION_SUCCESS;
+        }
+    };
+    if (query == "SUM") return reduced(Reductions::sum(operands));
+    if (query == "PRODUCT") return reduced(Reductions::product(operands));
+    if (query == "MEAN") return reduced(Reductions::mean(operands));
+    if (query == "NORM") return reduced(Reductions::norm(operands));
+    if (query == "COMPENSATED_SUM") return reduced(Reductions::compensated_sum(operands));
+    if (query == "COMPENSATED_MEAN") return reduced(Reductions::compensated_mean(operands));
+    if (query == "COMPENSATED_NORM") return reduced(Reductions::compensated_norm(operands));
+    if (query == "POLYROOTS") {
+        const Batch::ComplexBatch coefficients(operands.begin(), operands.end());
+        results.emplace_back(build_output(query, operands, std::vector<float1000>{}, Polynomial::roots(coefficients)));
+        return OPERATION_SUCCESS;
     }
-    return allErrors;
+    if (query.starts_with("INTEGRATE")) {
+        // "INTEGRATE FUNCTION" over the bounds [a,b], the integrand is any element-wise batch query.
+        const std::size_t space{query.find(' ')};
+        if (space == std::string::npos)
+            return OPERATION_FAILURE;
+        const std::string rule_name{query.substr(0, space)};
+        const std::string function{query.substr(space + 1)};
+        if (rule_name != "INTEGRATE" && rule_name != "INTEGRATE_TANH_SINH")
+            return OPERATION_FAILURE;
+        if (operands.size() != 2)
+            return reject(Errors::Code::invalid_literal, "Integration bounds must be written as [a,b] !");
+        const auto integrand{
+            [&](const Batch::RealBatch& points) {
+                Batch::RealBatch values;
+                if (!map_real_batch(function, points, values))
+                    throw std::runtime_error("Cannot integrate " + function + " !");
+                return values;
+            }
+        };
+        return reduced(Integration::integrate(
+            rule_name == "INTEGRATE" ? Integration::Rule::gauss_legendre : Integration::Rule::tanh_sinh,
+            operands[0], operands[1], integrand));
+    }
+    if (Batch::RealBatch result; map_real_batch(query, operands, result)) {
+        results.emplace_back(build_output(query, operands, std::vector<float1000>{}, result));
+        return OPERATION_SUCCESS;
+    }
+    return OPERATION_FAILURE;
 }
 
-mmqli::core::Core::Core(const ParsedRealQueries& parsedReal, const ParsedComplexQueries& parsedComplex) {
-    parsed_reals = parsedReal;
-    parsed_complex = parsedComplex;
+void mmqli::core::Core::process_real_batches() {
+    for (std::size_t i = 0; i < parsed_real_batches.size(); ++i) {
+        const auto& [QUERY, F_OPERANDS, S_OPERANDS] = parsed_real_batches[i];
+        const profiler::Scope timer{"real batch", QUERY};
+        enter(sources.real_batches, i);
+        if (guarded([&] {
+            return S_OPERANDS.empty()
+                       ? calculate_real_batch_single_operand(QUERY, F_OPERANDS)
+                       : calculate_real_batch_double_operands(QUERY, F_OPERANDS, S_OPERANDS);
+        }))
+            continue;
+        reject(Errors::Code::syntax, "Syntax Fault: MmQLC failed to process batch " + QUERY);
+    }
 }
 
-std::vector<std::string> mmqli::core::Core::evaluate_all() {
+bool mmqli::core::Core::calculate_complex_batch_double_operands(const std::string& query,
+                                                                const std::vector<complex1000>& first_operands,
+                                                                const std::vector<complex1000>& second_operands) {
+    const auto finish{
+        [&](auto&& kernel) {
+            results.emplace_back(build_output(query, first_operands, second_operands,
+                                              Batch::zip(first_operands, second_operands, kernel)));
+            return OPERATION_SUCCESS;
+        }
+    };
+    if ((query == "DIVIDE" || query == "ROOT") &&
+        std::ranges::any_of(second_operands, [](const complex1000& b) { return b == constants::complex_zero; }))
+        return query == "ROOT"
+                   ? reject(Errors::Code::domain, "Zeroth root of complex number is undefined !")
+                   : reject(Errors::Code::division_by_zero, "Cannot divide complex number by zero !");
+    if (query == "ADD")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) { r = a + b; });
+    if (query == "SUBTRACT")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) { r = a - b; });
+    if (query == "MULTIPLY")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) { r = a * b; });
+    if (query == "DIVIDE")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) {
+            r = a / b;
+        });
+    if (query == "POWER")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) {
+            r = Powers::power(a, b);
+        });
+    if (query == "POLYVAL") {
+        results.emplace_back(build_output(query, first_operands, second_operands,
+                                          Polynomial::evaluate(first_operands, second_operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "ROOT")
+        return finish([](complex1000& r, const complex1000& a, const complex1000& b) {
+            r = Powers::root(a, b);
+        });
+    if (const Plugins::Function* function{Plugins::find(query, Plugins::Kind::complex)};
+        function != nullptr && function->arity == 2)
+        return finish([function, &query](complex1000& r, const complex1000& a, const complex1000& b) {
+            call_plugin(*function, query, r, a, b);
+        });
+    return calculate_vector_queries(query, first_operands, second_operands);
+}
+
+bool mmqli::core::Core::calculate_complex_batch_single_operand(const std::string& query,
+                                                               const std::vector<complex1000>& operands) {
+    const auto finish{
+        [&](auto&& kernel) {
+            results.emplace_back(build_output(query, operands, std::vector<complex1000>{},
+                                              Batch::map(operands, kernel)));
+            return OPERATION_SUCCESS;
+        }
+    };
+    if (query == "NATURAL_LOGARITHM" &&
+        std::ranges::any_of(operands, [](const complex1000& z) { return z == constants::complex_zero; }))
+        return reject(Errors::Code::domain, "Cannot take log of zero !");
+    if (query == "SUM") {
+        results.emplace_back(build_output(query, operands, Reductions::sum(operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "PRODUCT") {
+        results.emplace_back(build_output(query, operands, Reductions::product(operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "MEAN") {
+        results.emplace_back(build_output(query, operands, Reductions::mean(operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "NORM") {
+        results.emplace_back(build_output(query, operands, Reductions::norm(operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "POLYROOTS") {
+        results.emplace_back(build_output(query, operands, std::vector<complex1000>{}, Polynomial::roots(operands)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "MODULUS" || query == "ARGUMENT") {
+        // both are real valued, so the batch of results is a real batch.
+        const bool modulus{query == "MODULUS"};
+        Batch::RealBatch real_results(operands.size());
+        for (std::size_t i = 0; i < operands.size(); ++i)
+            real_results[i] = modulus
+                                  ? float1000{std::abs(operands[i])}
+                                  : AngleConv::radians_to_degrees(std::arg(operands[i]));
+        results.emplace_back(build_output(query, operands, std::vector<complex1000>{}, real_results));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "SINE") return finish([](complex1000& r, const complex1000& z) { r = std::sin(z); });
+    if (query == "COSINE") return finish([](complex1000& r, const complex1000& z) { r = std::cos(z); });
+    if (query == "TANGENT") return finish([](complex1000& r, const complex1000& z) { r = std::tan(z); });
+    if (query == "COTANGENT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::cotangent(z); });
+    if (query == "SECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::secant(z); });
+    if (query == "COSECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::cosecant(z); });
+    if (query == "INVERSE_SINE") return finish([](complex1000& r, const complex1000& z) { r = std::asin(z); });
+    if (query == "INVERSE_COSINE") return finish([](complex1000& r, const complex1000& z) { r = std::acos(z); });
+    if (query == "INVERSE_TANGENT") return finish([](complex1000& r, const complex1000& z) { r = std::atan(z); });
+    if (query == "INVERSE_COTANGENT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::inverse_cotangent(z); });
+    if (query == "INVERSE_SECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::inverse_secant(z); });
+    if (query == "INVERSE_COSECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::inverse_cosecant(z); });
+    if (query == "HYP_SINE") return finish([](complex1000& r, const complex1000& z) { r = std::sinh(z); });
+    if (query == "HYP_COSINE") return finish([](complex1000& r, const complex1000& z) { r = std::cosh(z); });
+    if (query == "HYP_TANGENT") return finish([](complex1000& r, const complex1000& z) { r = std::tanh(z); });
+    if (query == "HYP_COTANGENT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::cotangent_hyperbolic(z); });
+    if (query == "HYP_SECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::secant_hyperbolic(z); });
+    if (query == "HYP_COSECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::cosecant_hyperbolic(z); });
+    if (query == "INVERSE_HYP_SINE")
+        return finish([](complex1000& r, const complex1000& z) { r = std::asinh(z); });
+    if (query == "INVERSE_HYP_COSINE")
+        return finish([](complex1000& r, const complex1000& z) { r = std::acosh(z); });
+    if (query == "INVERSE_HYP_TANGENT")
+        return finish([](complex1000& r, const complex1000& z) { r = std::atanh(z); });
+    if (query == "INVERSE_HYP_COTANGENT")
+        return finish([](complex1000& r, const complex1000& z) {
+            r = ComplexTrig::inverse_cotangent_hyperbolic(z);
+        });
+    if (query == "INVERSE_HYP_SECANT")
+        return finish([](complex1000& r, const complex1000& z) { r = ComplexTrig::inverse_secant_hyperbolic(z); });
+    if (query == "INVERSE_HYP_COSECANT")
+        return finish([](complex1000& r, const complex1000& z) {
+            r = ComplexTrig::inverse_cosecant_hyperbolic(z);
+        });
+    if (query == "NATURAL_LOGARITHM")
+        return finish([](complex1000& r, const complex1000& z) {
+            r = std::log(z);
+        });
+    if (query == "POWER_E") return finish([](complex1000& r, const complex1000& z) { r = std::exp(z); });
+    if (query == "CONJUGATE") return finish([](complex1000& r, const complex1000& z) { r = std::conj(z); });
+    if (const Plugins::Function* function{Plugins::find(query, Plugins::Kind::complex)};
+        function != nullptr && function->arity == 1)
+        return finish([function, &query](complex1000& r, const complex1000& z) {
+            call_plugin(*function, query, r, z, z);
+        });
+    return OPERATION_FAILURE;
+}
+
+void mmqli::core::Core::process_complex_batches() {
+    for (std::size_t i = 0; i < parsed_complex_batches.size(); ++i) {
+        const auto& [QUERY, F_OPERANDS, S_OPERANDS] = parsed_complex_batches[i];
+        const profiler::Scope timer{"complex batch", QUERY};
+        enter(sources.complex_batches, i);
+        if (guarded([&] {
+            return S_OPERANDS.empty()
+                       ? calculate_complex_batch_single_operand(QUERY, F_OPERANDS)
+                       : calculate_complex_batch_double_operands(QUERY, F_OPERANDS, S_OPERANDS);
+        }))
+            continue;
+        reject(Errors::Code::syntax, "mmqli failed to evaluate batch " + QUERY);
+    }
+}
+
+template<typename T>
+bool mmqli::core::Core::calculate_vector_queries(const std::string& query, const std::vector<T>& first_operands,
+                                                 const std::vector<T>& second_operands) {
+    if (query != "DOT" && query != "CROSS")
+        return OPERATION_FAILURE;
+    if (first_operands.size() != second_operands.size())
+        return reject(Errors::Code::domain, "Vector operands differ in length !");
+    const std::size_t length{first_operands.size()};
+    if (query == "DOT") {
+        T result{0};
+        const bool fixed_size{
+            LinAlg::visit_dimension(length, [&]<std::size_t N>() {
+                result = LinAlg::dot(LinAlg::Matrix<T, N, 1>::from(first_operands),
+                                     LinAlg::Matrix<T, N, 1>::from(second_operands));
+            })
+        };
+        if (!fixed_size) {
+            for (std::size_t i = 0; i < length; ++i)
+                result += LinAlg::conjugate(first_operands[i]) * second_operands[i];
+        }
+        results.emplace_back(build_output(query, first_operands, second_operands, result));
+        return OPERATION_SUCCESS;
+    }
+    if (length == 3) {
+        const auto result{
+            LinAlg::cross(LinAlg::Matrix<T, 3, 1>::from(first_operands), LinAlg::Matrix<T, 3, 1>::from(second_operands))
+        };
+        results.emplace_back(build_output(query, first_operands, second_operands, result.to_dynamic(true).elements));
+        return OPERATION_SUCCESS;
+    }
+    if (length == 2) {
+        const T result{
+            LinAlg::cross(LinAlg::Matrix<T, 2, 1>::from(first_operands), LinAlg::Matrix<T, 2, 1>::from(second_operands))
+        };
+        results.emplace_back(build_output(query, first_operands, second_operands, result));
+        return OPERATION_SUCCESS;
+    }
+    return reject(Errors::Code::domain, "Cross product is only defined for 2D and 3D vectors !");
+}
+
+template<typename T>
+bool mmqli::core::Core::calculate_matrix_queries(const std::string& query,
+                                                 const LinAlg::DynamicMatrix<T>& first_operand,
+                                                 const LinAlg::DynamicMatrix<T>& second_operand) {
+    const auto finish{
+        [&](const auto& result) {
+            results.emplace_back(build_output(query, first_operand, second_operand, result));
+            return OPERATION_SUCCESS;
+        }
+    };
+    const bool square{first_operand.rows == first_operand.cols};
+    const auto not_square{
+        [&] { return reject(Errors::Code::domain, query + " is only defined for square matrices !"); }
+    };
+    const bool single{second_operand.rows == 0};
+    for (const auto* operand : {&first_operand, &second_operand}) {
+        if (operand->rows <= LinAlg::max_dimension && operand->cols <= LinAlg::max_dimension)
+            continue;
+        if constexpr (std::is_same_v<T, float1000>)
+            return calculate_dense_queries(query, first_operand, second_operand);
+        else
+            return reject(Errors::Code::domain, "Complex matrices larger than 5x5 are not supported !");
+    }
+    LinAlg::DynamicMatrix<T> result;
+    if (single && query == "TRANSPOSE") {
+        LinAlg::visit_shape(first_operand.rows, first_operand.cols, [&]<std::size_t R, std::size_t C>() {
+            result = LinAlg::transpose(LinAlg::Matrix<T, R, C>::from(first_operand)).to_dynamic();
+        });
+        return finish(result);
+    }
+    if (single && query == "DET") {
+        if (!square) return not_square();
+        T determinant{0};
+        LinAlg::visit_dimension(first_operand.rows, [&]<std::size_t N>() {
+            determinant = LinAlg::determinant(LinAlg::Matrix<T, N, N>::from(first_operand));
+        });
+        return finish(determinant);
+    }
+    if (single && query == "INVERSE") {
+        if (!square) return not_square();
+        LinAlg::visit_dimension(first_operand.rows, [&]<std::size_t N>() {
+            result = LinAlg::inverse(LinAlg::Matrix<T, N, N>::from(first_operand)).to_dynamic();
+        });
+        return finish(result);
+    }
+    if (!single && query == "MATMUL") {
+        if (first_operand.cols != second_operand.rows)
+            return reject(Errors::Code::domain, "Matrix dimensions do not agree !");
+        LinAlg::visit_shape(first_operand.rows, first_operand.cols, [&]<std::size_t R, std::size_t K>() {
+            LinAlg::visit_dimension(second_operand.cols, [&]<std::size_t C>() {
+                result = LinAlg::multiply(LinAlg::Matrix<T, R, K>::from(first_operand),
+                                          LinAlg::Matrix<T, K, C>::from(second_operand)).to_dynamic(second_operand.vector);
+            });
+        });
+        return finish(result);
+    }
+    if (!single && query == "SOLVE") {
+        if (!square) return not_square();
+        if (first_operand.rows != second_operand.rows)
+            return reject(Errors::Code::domain, "Matrix dimensions do not agree !");
+        LinAlg::visit_dimension(first_operand.rows, [&]<std::size_t N>() {
+            LinAlg::visit_dimension(second_operand.cols, [&]<std::size_t M>() {
+                result = LinAlg::solve(LinAlg::Matrix<T, N, N>::from(first_operand),
+                                       LinAlg::Matrix<T, N, M>::from(second_operand)).to_dynamic(second_operand.vector);
+            });
+        });
+        return finish(result);
+    }
+    return OPERATION_FAILURE;
+}
+
+bool mmqli::core::Core::calculate_dense_queries(const std::string& query,
+                                                const LinAlg::DynamicMatrix<float1000>& first_operand,
+                                                const LinAlg::DynamicMatrix<float1000>& second_operand) {
+    const auto finish{
+        [&](const auto& result) {
+            results.emplace_back(build_output(query, first_operand, second_operand, result));
+            return OPERATION_SUCCESS;
+        }
+    };
+    const bool single{second_operand.rows == 0};
+    if (single && query == "TRANSPOSE")
+        return finish(Dense::transpose(first_operand));
+    if (single && query == "DET")
+        return finish(Dense::determinant(Dense::DenseMatrix::from(first_operand)));
+    if (single && query == "INVERSE")
+        return finish(Dense::inverse(Dense::DenseMatrix::from(first_operand)).to_dynamic());
+    if (!single && query == "MATMUL")
+        return finish(Dense::multiply(Dense::DenseMatrix::from(first_operand),
+                                      Dense::DenseMatrix::from(second_operand)).to_dynamic(second_operand.vector));
+    if (!single && query == "SOLVE")
+        return finish(Dense::solve(Dense::DenseMatrix::from(first_operand),
+                                   Dense::DenseMatrix::from(second_operand)).to_dynamic(second_operand.vector));
+    return OPERATION_FAILURE;
+}
+
+void mmqli::core::Core::process_matrices() {
+    for (std::size_t i = 0; i < parsed_real_matrices.size(); ++i) {
+        const auto& [QUERY, F_OPERAND, S_OPERAND] = parsed_real_matrices[i];
+        const profiler::Scope timer{"real matrix", QUERY};
+        enter(sources.real_matrices, i);
+        if (guarded([&] {
+            return calculate_geometry_queries(QUERY, F_OPERAND, S_OPERAND) ||
+                   calculate_matrix_queries(QUERY, F_OPERAND, S_OPERAND);
+        }))
+            continue;
+        reject(Errors::Code::syntax, "Syntax Fault: MmQLC failed to process matrix " + QUERY);
+    }
+    for (std::size_t i = 0; i < parsed_complex_matrices.size(); ++i) {
+        const auto& [QUERY, F_OPERAND, S_OPERAND] = parsed_complex_matrices[i];
+        const profiler::Scope timer{"complex matrix", QUERY};
+        enter(sources.complex_matrices, i);
+        if (guarded([&] { return calculate_matrix_queries(QUERY, F_OPERAND, S_OPERAND); }))
+            continue;
+        reject(Errors::Code::syntax, "mmqli failed to evaluate matrix " + QUERY);
+    }
+}
+
+bool mmqli::core::Core::calculate_geometry_queries(const std::string& query,
+                                                  const LinAlg::DynamicMatrix<float1000>& first_operand,
+                                                  const LinAlg::DynamicMatrix<float1000>& second_operand) {
+    const bool single{second_operand.rows == 0};
+    if (query == "AREA" && single) {
+        results.emplace_back(build_output(query, first_operand, second_operand, Geometry::area(Geometry::Points(first_operand))));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "COLLINEAR") {
+        const Geometry::Points points(first_operand);
+        if (single)
+            results.emplace_back(build_output(query, first_operand, second_operand,
+                                              float1000{Geometry::collinear(points) ? 1 : 0}));
+        else
+            results.emplace_back(build_output(query, first_operand, second_operand,
+                                              Geometry::collinear(points, Geometry::Points(second_operand))));
+        return OPERATION_SUCCESS;
+    }
+    if (single)
+        return OPERATION_FAILURE;
+    if (query == "DISTANCE") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::distances(Geometry::Points(first_operand), Geometry::Points(second_operand))));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "MIDPOINT") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::midpoints(Geometry::Points(first_operand), Geometry::Points(second_operand))));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "SLOPE") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::slopes(Geometry::Points(first_operand), Geometry::Points(second_operand))));
+        return OPERATION_SUCCESS;
+    }
+    return OPERATION_FAILURE;
+}
+
+bool mmqli::core::Core::calculate_fast_geometry_queries(const std::string& query,
+                                                       const Geometry::PointSet& first_operand,
+                                                       const Geometry::PointSet& second_operand) {
+    const bool single{second_operand.size() == 0};
+    if (query == "FAST_AREA" && single) {
+        results.emplace_back(build_output(query, first_operand, second_operand, Geometry::fast::area(first_operand)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "FAST_COLLINEAR") {
+        if (single)
+            results.emplace_back(build_output(query, first_operand, second_operand,
+                                              Geometry::fast::collinear(first_operand) ? 1.0 : 0.0));
+        else
+            results.emplace_back(build_output(query, first_operand, second_operand,
+                                              Geometry::fast::collinear(first_operand, second_operand)));
+        return OPERATION_SUCCESS;
+    }
+    if (single)
+        return OPERATION_FAILURE;
+    if (query == "FAST_DISTANCE") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::fast::distances(first_operand, second_operand)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "FAST_MIDPOINT") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::fast::midpoints(first_operand, second_operand)));
+        return OPERATION_SUCCESS;
+    }
+    if (query == "FAST_SLOPE") {
+        results.emplace_back(build_output(query, first_operand, second_operand,
+                                          Geometry::fast::slopes(first_operand, second_operand)));
+        return OPERATION_SUCCESS;
+    }
+    return OPERATION_FAILURE;
+}
+
+void mmqli::core::Core::process_point_sets() {
+    for (std::size_t i = 0; i < parsed_point_sets.size(); ++i) {
+        const auto& [QUERY, F_OPERAND, S_OPERAND] = parsed_point_sets[i];
+        const profiler::Scope timer{"point set", QUERY};
+        enter(sources.point_sets, i);
+        if (guarded([&] { return calculate_fast_geometry_queries(QUERY, F_OPERAND, S_OPERAND); }))
+            continue;
+        reject(Errors::Code::syntax, "Syntax Fault: MmQLC failed to process point set " + QUERY);
+    }
+}
+
+bool mmqli::core::Core::reject(const Errors::Code code, std::string message) {
+    results.emplace_back(Errors::fail(code, std::move(message), current));
+    return OPERATION_SUCCESS; // the query is answered, with its error
+}
+
+mmqli::core::Core::Core(ParsedRealQueries parsedReal, ParsedComplexQueries parsedComplex,
+                        ParsedRealBatches parsedRealBatches, ParsedComplexBatches parsedComplexBatches,
+                        ParsedRealMatrices parsedRealMatrices, ParsedComplexMatrices parsedComplexMatrices,
+                        ParsedPointSets parsedPointSets, ParsedExactQueries parsedExact)
+    : parsed_reals(std::move(parsedReal)), parsed_complex(std::move(parsedComplex)),
+      parsed_real_batches(std::move(parsedRealBatches)), parsed_complex_batches(std::move(parsedComplexBatches)),
+      parsed_real_matrices(std::move(parsedRealMatrices)), parsed_complex_matrices(std::move(parsedComplexMatrices)),
+      parsed_point_sets(std::move(parsedPointSets)), parsed_exact(std::move(parsedExact)) {
+    // one result per query, reserved up front so that the evaluation itself does not grow the vector.
+    results.reserve(query_count());
+}
+
+std::vector<Errors::Result<std::string>> mmqli::core::Core::evaluate() {
+    const profiler::Scope timer{"stage", "evaluate"};
+    process_exact_queries();
     process_real_queries();
     process_complex_queries();
-    if (!errors.empty())
-        throw std::runtime_error(get_string_errors());
-    return results;
+    process_real_batches();
+    process_complex_batches();
+    process_matrices();
+    process_point_sets();
+    if (keeping_values)
+        values.resize(results.size());
+    return std::exchange(results, {});
+}
+
+std::vector<std::string> mmqli::core::Core::evaluate_all() {
+    std::vector<std::string> answers;
+    std::string failures;
+    for (auto& result : evaluate()) {
+        if (result)
+            answers.emplace_back(std::move(*result));
+        else
+            failures += result.error().message + "\n";
+    }
+    if (!failures.empty())
+        throw std::runtime_error(failures);
+    return answers;
 }
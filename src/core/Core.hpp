@@ -1,35 +1,157 @@
 #ifndef MMQLI_CORE_HPP
 #define MMQLI_CORE_HPP
 
+#include <array>
 #include <type_traits>
+#include <initializer_list>
 #include <stdexcept>
+#include <string_view>
 #include "../parser/Parser.hpp"
+#include "helpers/profiler.hpp"
+#include "helpers/cancel.hpp"
+#include "helpers/error.hpp"
+#include "helpers/wire.hpp"
 
 template<typename T>
 concept RealComplex = Real<T> || Complex<T>; // either real number or complex number.
 
+template<typename T>
+concept RealComplexBatch = RealComplex<typename T::value_type> && std::same_as<T, std::vector<typename T::value_type> >;
+// a contiguous batch of real or complex numbers.
+
 namespace mmqli::core {
+    using ParsedExactQuery = std::tuple<std::string, mpq_class, mpq_class>;
+    using ParsedExactQueries = std::vector<ParsedExactQuery>;
     using ParsedRealQuery = std::tuple<std::string, float1000, float1000>;
     using ParsedRealQueries = std::vector<ParsedRealQuery>;
     using ParsedComplexQuery = std::tuple<std::string, complex1000, complex1000>;
     using ParsedComplexQueries = std::vector<ParsedComplexQuery>;
+    using ParsedRealBatch = std::tuple<std::string, std::vector<float1000>, std::vector<float1000> >;
+    using ParsedRealBatches = std::vector<ParsedRealBatch>;
+    using ParsedComplexBatch = std::tuple<std::string, std::vector<complex1000>, std::vector<complex1000> >;
+    using ParsedComplexBatches = std::vector<ParsedComplexBatch>;
+    using ParsedRealMatrix = std::tuple<std::string, linalg::DynamicMatrix<float1000>, linalg::DynamicMatrix<float1000> >;
+    using ParsedRealMatrices = std::vector<ParsedRealMatrix>;
+    using ParsedComplexMatrix = std::tuple<std::string, linalg::DynamicMatrix<complex1000>, linalg::DynamicMatrix<complex1000> >;
+    using ParsedComplexMatrices = std::vector<ParsedComplexMatrix>;
+    using ParsedPointSet = std::tuple<std::string, geometry::PointSet, geometry::PointSet>;
+    using ParsedPointSets = std::vector<ParsedPointSet>;
 
+/**
+ * Evaluates the parsed queries of one line. The pipeline is reentrant: a Core, like a Parser, belongs to the thread
+ * that made it, and any number of threads may tokenize, parse, resolve variables and evaluate side by side, each with
+ * its own variables. The state they share is either immutable once mmqlc has started (the grammar, the tables of the
+ * kernels, the loaded plugins) or synchronized (the worker pool, the profiler, the caches), and no kernel changes the
+ * global state of MPFR: every number carries its own precision, and the exponent range is never narrowed. The digits
+ * of the adaptive evaluation can be set per thread, see @ref ziv::ThreadDigits.
+ */
 class Core {
     ParsedRealQueries parsed_reals;
     ParsedComplexQueries parsed_complex;
-    std::vector<std::string> results;
-    std::vector<std::string> errors;
+    ParsedRealBatches parsed_real_batches;
+    ParsedComplexBatches parsed_complex_batches;
+    ParsedRealMatrices parsed_real_matrices;
+    ParsedComplexMatrices parsed_complex_matrices;
+    ParsedPointSets parsed_point_sets;
+    ParsedExactQueries parsed_exact;
+    std::vector<error::Result<std::string>> results; // one per query, in the order of evaluation
+    bool keeping_values{false};
+    bool keeping_text{true}; // false when the values are kept without their answer strings
+    std::vector<wire::Value> values; // the results as values, when they are kept, aligned with the results
+    ParsedSources sources; // where the parsed queries come from, empty when they were not parsed from text
+    error::Position current{}; // where the errors of the query being evaluated are reported
+    std::array<std::string, 2> written{}; // the operands of the real query being evaluated as written, when known
+
+public:
+    /**
+     * This function identifies the engine that answers: its version, the hash of the sources it was built from and
+     * the precision of its numbers. Two builds that could answer differently never share an identity.
+     */
+    static std::string engine();
 
+    // the formatting of the results, public so that it can be measured on its own.
     static std::string to_str(const complex1000 &complex);
     static std::string to_str(const float1000 &real);
+    static std::string to_str(const mpq_class &exact);
+    static std::string to_str(const RealComplexBatch auto &batch) {
+        if (batch.empty())
+            return "[]";
+        std::string joined{"["};
+        for (const auto &element: batch) {
+            joined += to_str(element);
+            joined += ',';
+        }
+        joined.back() = ']';
+        return joined;
+    }
+    static std::string to_str(double real);
+    static std::string to_str(const std::vector<double> &batch);
+    static std::string to_str(const geometry::PointSet &points);
+    template<typename T>
+    static std::string to_str(const linalg::DynamicMatrix<T> &matrix) {
+        if (matrix.vector)
+            return to_str(matrix.elements);
+        if (matrix.rows == 0)
+            return "[]";
+        std::string joined{"["};
+        for (std::size_t row = 0; row < matrix.rows; ++row) {
+            joined += '[';
+            for (std::size_t col = 0; col < matrix.cols; ++col) {
+                joined += to_str(matrix(row, col));
+                joined += ',';
+            }
+            joined.back() = ']';
+            joined += ',';
+        }
+        joined.back() = ']';
+        return joined;
+    }
 
+private:
     bool calculate_real_queries_double_operands(const std::string& query, const float1000& first_operand, const float1000& second_operand);
     bool calculate_real_queries_single_operand(const std::string& query, const float1000& operand);
+    bool calculate_plugin_queries(const std::string& query, const float1000& first_operand, const float1000& second_operand);
+    bool calculate_special_queries(const std::string& query, const float1000& first_operand, const float1000& second_operand);
+    /**
+     * Evaluates a real query to the digits of the session, see @ref ziv::evaluate. Its operands are read again from
+     * the literals they are written with when they are known, see @ref ziv::Operand.
+     * @return false when the query has no adaptive kernel, it is then evaluated at the precision of float1000.
+     */
+    bool calculate_adaptive_queries(const std::string& query, const float1000& first_operand, const float1000& second_operand);
+    void evaluate_real_query(const std::string& query, const float1000& first_operand, const float1000& second_operand);
     void process_real_queries();
 
+    /**
+     * Answers a query over integer and rational literals exactly, see @ref exact::evaluate.
+     * @return false when the query has no exact answer, it is then promoted to a real query.
+     */
+    bool calculate_exact_queries(const std::string& query, const mpq_class& first_operand, const mpq_class& second_operand);
+    void process_exact_queries();
+
     bool calculate_complex_queries_double_operands(const std::string& query, const complex1000& first_operand, const complex1000& second_operand);
     bool calculate_complex_queries_single_operand(const std::string& query, const complex1000& operand);
+    bool calculate_plugin_queries(const std::string& query, const complex1000& first_operand, const complex1000& second_operand);
     void process_complex_queries();
+
+    bool calculate_real_batch_double_operands(const std::string& query, const std::vector<float1000>& first_operands, const std::vector<float1000>& second_operands);
+    bool map_real_batch(const std::string& query, const std::vector<float1000>& operands, std::vector<float1000>& result);
+    bool calculate_real_batch_single_operand(const std::string& query, const std::vector<float1000>& operands);
+    void process_real_batches();
+
+    bool calculate_complex_batch_double_operands(const std::string& query, const std::vector<complex1000>& first_operands, const std::vector<complex1000>& second_operands);
+    bool calculate_complex_batch_single_operand(const std::string& query, const std::vector<complex1000>& operands);
+    void process_complex_batches();
+
+    template<typename T>
+    bool calculate_vector_queries(const std::string& query, const std::vector<T>& first_operands, const std::vector<T>& second_operands);
+    template<typename T>
+    bool calculate_matrix_queries(const std::string& query, const linalg::DynamicMatrix<T>& first_operand, const linalg::DynamicMatrix<T>& second_operand);
+    bool calculate_dense_queries(const std::string& query, const linalg::DynamicMatrix<float1000>& first_operand, const linalg::DynamicMatrix<float1000>& second_operand);
+    void process_matrices();
+
+    bool calculate_geometry_queries(const std::string& query, const linalg::DynamicMatrix<float1000>& first_operand, const linalg::DynamicMatrix<float1000>& second_operand);
+    bool calculate_fast_geometry_queries(const std::string& query, const geometry::PointSet& first_operand, const geometry::PointSet& second_operand);
+    void process_point_sets();
     /**
      * This function build the answer string from the components. This is a templated function and by ODR, it is defined and implemented here.
      * @param q The query string
@@ -39,7 +161,10 @@ class Core {
      * @return The answer string in the form @code query f,s = r @endcode
      */
     std::string build_output(const std::string &q, const RealComplex auto& f, const RealComplex auto& s, const RealComplex auto& r) {
-        return q + " " + to_str(f) + "," + to_str(s) + " = " + to_str(r) + "\n";
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        return join({q, " ", to_str(f), ",", to_str(s), " = ", to_str(r), "\n"});
     }
     /**
      * This function build the answer string from the components. This is a templated function and by ODR, it is defined and implemented here.
@@ -49,15 +174,237 @@ class Core {
      * @return The answer string in the form @code query f = r @endcode
      */
     std::string build_output(const std::string &q, const RealComplex auto& f, const RealComplex auto& r) {
-        return q + " " + to_str(f) + " = " + to_str(r) + "\n";
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a fused query, the family of results of one operand is written as one vector.
+     * @param q The query string
+     * @param f The operand
+     * @param r The family of results, in the order of the query.
+     * @return The answer string in the form @code query f = [r...] @endcode
+     */
+    std::string build_output(const std::string &q, const RealComplex auto& f, const RealComplexBatch auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a batch query, all the results are written as one vector.
+     * @param q The query string
+     * @param f The batch of first operands
+     * @param s The batch of second operands, empty for single operand queries.
+     * @param r The batch of results after evaluation.
+     * @return The answer string in the form @code query [f...],[s...] = [r...] @endcode
+     */
+    std::string build_output(const std::string &q, const RealComplexBatch auto& f, const RealComplexBatch auto& s, const RealComplexBatch auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        if (s.empty())
+            return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+        return join({q, " ", to_str(f), ",", to_str(s), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a reduction, the whole batch is reduced to a single result.
+     * @param q The query string
+     * @param f The batch of operands
+     * @param r The result after the reduction.
+     * @return The answer string in the form @code query [f...] = r @endcode
+     */
+    std::string build_output(const std::string &q, const RealComplexBatch auto& f, const RealComplex auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a query over two vectors with a single result, such as a dot product.
+     * @param q The query string
+     * @param f The first vector
+     * @param s The second vector
+     * @param r The result after evaluation.
+     * @return The answer string in the form @code query [f...],[s...] = r @endcode
+     */
+    std::string build_output(const std::string &q, const RealComplexBatch auto& f, const RealComplexBatch auto& s, const RealComplex auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        return join({q, " ", to_str(f), ",", to_str(s), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a matrix query, the result is either a matrix or a number.
+     * @param q The query string
+     * @param f The first matrix
+     * @param s The second matrix or vector, empty for single operand queries.
+     * @param r The result after evaluation.
+     * @return The answer string in the form @code query [[f...]],[[s...]] = r @endcode
+     */
+    template<typename T>
+    std::string build_output(const std::string &q, const linalg::DynamicMatrix<T>& f, const linalg::DynamicMatrix<T>& s, const auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        if (s.rows == 0)
+            return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+        return join({q, " ", to_str(f), ",", to_str(s), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function build the answer string for a double precision geometry query over point sets.
+     * @param q The query string
+     * @param f The first point set
+     * @param s The second point set, empty for single operand queries.
+     * @param r The result after evaluation.
+     * @return The answer string in the form @code query [[x,y]...],[[x,y]...] = r @endcode
+     */
+    std::string build_output(const std::string &q, const geometry::PointSet& f, const geometry::PointSet& s, const auto& r) {
+        const profiler::Scope timer{"stage", "format"};
+        if (!keep(r))
+            return {};
+        if (s.size() == 0)
+            return join({q, " ", to_str(f), " = ", to_str(r), "\n"});
+        return join({q, " ", to_str(f), ",", to_str(s), " = ", to_str(r), "\n"});
+    }
+
+    /**
+     * This function concatenates the parts of an answer string, the string is allocated once at its final length.
+     * @param parts The parts, in order.
+     * @return The answer string.
+     */
+    static std::string join(const std::initializer_list<std::string_view> parts) {
+        std::size_t length{0};
+        for (const std::string_view part : parts)
+            length += part.size();
+        std::string joined;
+        joined.reserve(length);
+        for (const std::string_view part : parts)
+            joined += part;
+        return joined;
     }
 
-    void attach_error(const std::string &err);
-    std::string get_string_errors();
+    /**
+     * This function keeps the result of the current query as a value, when the values are kept. Every answer string
+     * is built by build_output right before it is emplaced, so the value lands at the index of its result.
+     * @param r The result after evaluation.
+     * @return Whether the answer string is needed: always, unless the value is kept without its text.
+     */
+    bool keep(const auto& r) {
+        if (!keeping_values)
+            return true;
+        using T = std::remove_cvref_t<decltype(r)>;
+        values.resize(results.size());
+        if constexpr (std::is_same_v<T, float1000> || std::is_same_v<T, complex1000> ||
+                      std::is_same_v<T, std::vector<float1000>> || std::is_same_v<T, std::vector<complex1000>>) {
+            values.emplace_back(r);
+            return keeping_text;
+        } else {
+            values.emplace_back();
+            return true;
+        }
+    }
+
+    /**
+     * This function starts the evaluation of the query at @p index of the queries of one kind: its errors are
+     * reported at the index and first column of its query in the source, or at the index of its result when the
+     * sources are not known.
+     * @param kind The sources of the queries of its kind.
+     * @param index The index of the query among the queries of its kind.
+     */
+    void enter(const std::vector<TokenSource>& kind, const std::size_t index) {
+        current = index < kind.size() ? error::Position{kind[index].query, kind[index].first}
+                                      : error::Position{results.size(), 0};
+        written[0].clear();
+        written[1].clear();
+    }
+
+    /**
+     * This function answers the current query with an error, in place of its result.
+     * @param code What went wrong.
+     * @param message The message shown for the query.
+     * @return Always true, the query is answered.
+     */
+    bool reject(error::Code code, std::string message);
+
+    /**
+     * This function counts the parsed queries, every one of them gets exactly one result.
+     * @return The number of queries of every kind.
+     */
+    [[nodiscard]] std::size_t query_count() const {
+        return parsed_reals.size() + parsed_complex.size() + parsed_real_batches.size() +
+               parsed_complex_batches.size() + parsed_real_matrices.size() + parsed_complex_matrices.size() +
+               parsed_point_sets.size() + parsed_exact.size();
+    }
+
+    /**
+     * This function evaluates one query. A kernel that throws (a singular matrix, a polynomial without coefficients)
+     * answers the query with an error instead of aborting the other queries, the try block costs nothing as long as
+     * nothing is thrown. A std::domain_error (an operand outside the domain of a plugin function) is a domain error.
+     * The query runs under its own budget, see @ref cancel::Query, a query that is cancelled is answered with a
+     * cancelled error.
+     * @param evaluate Evaluates the query, returns false when no rule matches it.
+     * @return Whether the query was answered, with a result or with an error.
+     */
+    bool guarded(const auto& evaluate) {
+        try {
+            const cancel::Query budget;
+            return evaluate();
+        } catch (const cancel::Cancelled &e) {
+            return reject(error::Code::cancelled, e.what());
+        } catch (const std::domain_error &e) {
+            return reject(error::Code::domain, e.what());
+        } catch (const std::exception &e) {
+            return reject(error::Code::evaluation, e.what());
+        }
+    }
 
 public:
-    Core(const ParsedRealQueries &parsedReal, const ParsedComplexQueries &parsedComplex);
+    // the parsed queries are taken by value, the Parser hands them over and they are moved in without a copy.
+    Core(ParsedRealQueries parsedReal, ParsedComplexQueries parsedComplex,
+         ParsedRealBatches parsedRealBatches = {}, ParsedComplexBatches parsedComplexBatches = {},
+         ParsedRealMatrices parsedRealMatrices = {}, ParsedComplexMatrices parsedComplexMatrices = {},
+         ParsedPointSets parsedPointSets = {}, ParsedExactQueries parsedExact = {});
+    /**
+     * Tells where the parsed queries come from, the Parser hands their sources over with @ref Parser::parse_Sources.
+     * The errors are then reported at the index of their query in the source and the column of its first operand.
+     */
+    void locate(ParsedSources parsed) {
+        sources = std::move(parsed);
+    }
+
+    /**
+     * Evaluates every query, one result per query in the order of evaluation: the exact, real, complex, batch, matrix
+     * and point set queries. A query that cannot be answered holds its error, at its source when the sources are
+     * known, see @ref locate, at the index of its result otherwise.
+     */
+    std::vector<error::Result<std::string>> evaluate();
+    /**
+     * The answers of @ref evaluate, all or nothing: throws the messages of the failed queries when there is one.
+     */
     std::vector<std::string> evaluate_all();
+    /**
+     * Makes @ref evaluate keep the results as values too, for the binary output that carries them without a decimal
+     * conversion. Without @p text, the answer string of a result kept as a value is left empty, the caller formats
+     * the value itself when it needs to, and the operands are never formatted.
+     */
+    void keep_values(const bool text = true) {
+        keeping_values = true;
+        keeping_text = text;
+        values.reserve(query_count());
+    }
+    /**
+     * The values of the last @ref evaluate, aligned with its results, monostate for the results that only exist as
+     * text and for the errors.
+     */
+    std::vector<wire::Value> take_values() { return std::exchange(values, {}); }
 };
 } //namespace mmqli::core
 #endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <gmp.h>
+
+/**
+ * @brief This namespace contains the per-thread arenas that back the limbs of every GMP and MPFR number. A float1000
+ * allocates its limbs when it is created and frees them when it is destroyed, so a single query used to make dozens
+ * of malloc/free pairs of the same few sizes. Once installed, freed blocks are kept on per-thread free lists by size
+ * class and handed out again, so evaluation stops calling malloc once the lists are warm.
+ */
+namespace mmqli::core::arena {
+    /**
+     * @brief Blocks are rounded up to a whole number of limbs, the largest pooled block holds the limbs of a few
+     * thousand digits. Larger blocks (binary splitting integers, huge precisions) go straight to malloc. GMP and MPFR
+     * size the limbs of their numbers in whole limbs, so a number that malloc allocated before the arena was
+     * installed (a constant built during static initialization) fits its size class exactly, and its block can be
+     * reused safely when MPFR frees or resizes it later.
+     */
+    constexpr std::size_t granularity{sizeof(mp_limb_t)};
+    constexpr std::size_t largest_block{4096};
+    constexpr std::size_t class_count{largest_block / granularity};
+    /**
+     * @brief The number of free blocks kept per size class and thread, a batch of a million numbers returns most of
+     * its blocks to malloc instead of keeping them.
+     */
+    constexpr std::uint32_t blocks_per_class{256};
+
+    namespace detail {
+        // the number of calls that reached malloc, realloc or free.
+        inline std::atomic<std::uint64_t> system_calls{0};
+
+        enum class State : unsigned char { fresh, alive, finished };
+
+        // trivially destructible, so it can still be read while the statics are destroyed at exit.
+        inline thread_local State state{State::fresh};
+
+        struct FreeList {
+            void *head{nullptr};
+            std::uint32_t length{0};
+        };
+
+        struct FreeLists {
+            FreeList lists[class_count]{};
+
+            FreeLists() { state = State::alive; }
+
+            FreeLists(const FreeLists &) = delete;
+            FreeLists &operator=(const FreeLists &) = delete;
+
+            ~FreeLists() {
+                state = State::finished;
+                for (auto &[head, length]: lists)
+                    while (head != nullptr)
+                        std::free(std::exchange(head, *static_cast<void **>(head)));
+            }
+        };
+
+        inline FreeLists &free_lists() {
+            static thread_local FreeLists lists;
+            return lists;
+        }
+
+        // false once the lists of the thread are destroyed, the blocks then go straight to malloc and free.
+        inline bool lists_available() {
+            if (state == State::finished)
+                return false;
+            free_lists();
+            return true;
+        }
+
+        inline std::size_t size_class(const std::size_t size) { return (size + granularity - 1) / granularity - 1; }
+
+        // the blocks are requested from C code, failing the way GMP itself does is the only safe option.
+        [[noreturn]] inline void out_of_memory() {
+            std::fputs("mmqlc: cannot allocate memory\n", stderr);
+            std::abort();
+        }
+
+        inline void *system_allocate(const std::size_t size) {
+            system_calls.fetch_add(1, std::memory_order_relaxed);
+            void *block{std::malloc(size)};
+            if (block == nullptr)
+                out_of_memory();
+            return block;
+        }
+
+        inline void system_free(void *block) {
+            system_calls.fetch_add(1, std::memory_order_relaxed);
+            std::free(block);
+        }
+
+        inline void *allocate(const std::size_t size) {
+            if (size == 0 || size > largest_block)
+                return system_allocate(size == 0 ? 1 : size);
+            const std::size_t index{size_class(size)};
+            if (lists_available()) {
+                if (FreeList &list{free_lists().lists[index]}; list.head != nullptr) {
+                    void *block{list.head};
+                    list.head = *static_cast<void **>(block);
+                    --list.length;
+                    return block;
+                }
+            }
+            return system_allocate((index + 1) * granularity);
+        }
+
+        inline void deallocate(void *block, const std::size_t size) {
+            if (block == nullptr)
+                return;
+            if (size == 0 || size > largest_block || !lists_available()) {
+                system_free(block);
+                return;
+            }
+            FreeList &list{free_lists().lists[size_class(size)]};
+            if (list.length == blocks_per_class) {
+                system_free(block);
+                return;
+            }
+            *static_cast<void **>(block) = list.head;
+            list.head = block;
+            ++list.length;
+        }
+
+        inline void *reallocate(void *block, const std::size_t old_size, const std::size_t new_size) {
+            if (old_size > largest_block && new_size > largest_block) {
+                system_calls.fetch_add(1, std::memory_order_relaxed);
+                void *grown{std::realloc(block, new_size)};
+                if (grown == nullptr)
+                    out_of_memory();
+                return grown;
+            }
+            if (old_size != 0 && new_size != 0 && old_size <= largest_block && new_size <= largest_block &&
+                size_class(old_size) == size_class(new_size))
+                return block; // the block already has the room
+            void *moved{allocate(new_size)};
+            std::memcpy(moved, block, std::min(old_size, new_size));
+            deallocate(block, old_size);
+            return moved;
+        }
+    }
+
+    /**
+     * @brief Makes GMP, and MPFR through it, allocate from the arenas. It is called at the start of main, before
+     * the queries create any number. The strings of MPFR are the only blocks that are not a whole number of limbs,
+     * they are only created by the queries, after the install.
+     */
+    inline void install() {
+        mp_set_memory_functions(detail::allocate, detail::reallocate, detail::deallocate);
+    }
+
+    /**
+     * @brief The number of calls the arenas made to malloc, realloc and free so far, it stays constant while
+     * warm queries are evaluated.
+     */
+    inline std::uint64_t system_calls() { return detail::system_calls.load(std::memory_order_relaxed); }
+} // namespace mmqli::core::arena
+#endif // ARENA_HPP
@@ -0,0 +1,140 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include "boost_fwd.hpp"
+#include "constants.hpp"
+#include "parallel.hpp"
+
+namespace mmqli::core::batch {
+    using RealBatch = std::vector<float1000>;
+    using ComplexBatch = std::vector<complex1000>;
+
+    /**
+     * @brief The number of consecutive elements handed to a worker thread at a time.
+     */
+    constexpr std::size_t elements_per_task{64};
+
+    /**
+     * @brief Calls @p body(begin, end, worker) for consecutive runs of @code elements_per_task @endcode indices in
+     * [0, length), spread across the worker threads.
+     */
+    template<typename Body>
+    void for_each_run(const std::size_t length, Body &&body) {
+        parallel::parallel_for((length + elements_per_task - 1) / elements_per_task,
+                               [&](const std::size_t task, const std::size_t worker) {
+                                   const std::size_t begin{task * elements_per_task};
+                                   body(begin, std::min(length, begin + elements_per_task), worker);
+                               });
+    }
+
+    /**
+     * @brief Per-batch state of the real kernels. It is set up once for a whole batch, so the kernels itself
+     * only perform the MPFR calls that the operation requires.
+     */
+    struct RealBatchContext {
+        float1000 scratch; // reusable temporary, avoids a heap allocated temporary per element
+        mpfr_srcptr pi{constants::arbitrary_precise_pi.backend().data()};
+
+        /**
+         * @brief Converts the degrees in @p degrees to radians into @p radians, rounding exactly like
+         * @code converters::degrees_to_radians @endcode does.
+         */
+        void degrees_to_radians(mpfr_ptr radians, mpfr_srcptr degrees) const {
+            mpfr_mul(radians, pi, degrees, MPFR_RNDN);
+            mpfr_div_ui(radians, radians, 180, MPFR_RNDN);
+        }
+
+        /**
+         * @brief Converts the radians in @p radians to degrees into @p degrees, rounding exactly like
+         * @code converters::radians_to_degrees @endcode does.
+         */
+        void radians_to_degrees(mpfr_ptr degrees, mpfr_srcptr radians) const {
+            mpfr_mul_ui(degrees, radians, 180, MPFR_RNDN);
+            mpfr_div(degrees, degrees, pi, MPFR_RNDN);
+        }
+    };
+
+    /**
+     * @brief Applies @p kernel to every element of @p operands. The results are stored contiguously and every
+     * kernel call writes straight into its result slot through raw MPFR pointers. The elements are spread across
+     * the worker threads, every worker has its own context.
+     * @param operands The batch of operands.
+     * @param kernel A callable of the form @code void(mpfr_ptr result, mpfr_srcptr operand, RealBatchContext&) @endcode
+     * @return The batch of results, in the order of the operands.
+     */
+    template<typename Kernel>
+    RealBatch map(const RealBatch &operands, Kernel &&kernel) {
+        RealBatch results(operands.size());
+        std::vector<RealBatchContext> contexts(parallel::worker_count());
+        for_each_run(operands.size(), [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+            for (std::size_t i = begin; i < end; ++i)
+                kernel(results[i].backend().data(), operands[i].backend().data(), contexts[worker]);
+        });
+        return results;
+    }
+
+    /**
+     * @brief Applies @p kernel element-wise to two batches. A batch holding a single element is broadcast
+     * against the other batch.
+     * @param first The batch of first operands.
+     * @param second The batch of second operands.
+     * @param kernel A callable of the form
+     * @code void(mpfr_ptr result, mpfr_srcptr first, mpfr_srcptr second, RealBatchContext&) @endcode
+     * @return The batch of results.
+     */
+    template<typename Kernel>
+    RealBatch zip(const RealBatch &first, const RealBatch &second, Kernel &&kernel) {
+        if (first.size() != second.size() && first.size() != 1 && second.size() != 1)
+            throw std::runtime_error("Batch operands differ in length !");
+        const std::size_t length{std::max(first.size(), second.size())};
+        const std::size_t first_stride{first.size() == 1 ? 0u : 1u};
+        const std::size_t second_stride{second.size() == 1 ? 0u : 1u};
+        RealBatch results(length);
+        std::vector<RealBatchContext> contexts(parallel::worker_count());
+        for_each_run(length, [&](const std::size_t begin, const std::size_t end, const std::size_t worker) {
+            for (std::size_t i = begin; i < end; ++i)
+                kernel(results[i].backend().data(),
+                       first[i * first_stride].backend().data(),
+                       second[i * second_stride].backend().data(),
+                       contexts[worker]);
+        });
+        return results;
+    }
+
+    /**
+     * @brief Complex counterpart of @code map @endcode, the kernel is of the form
+     * @code void(complex1000 &result, const complex1000 &operand) @endcode
+     */
+    template<typename Kernel>
+    ComplexBatch map(const ComplexBatch &operands, Kernel &&kernel) {
+        ComplexBatch results(operands.size());
+        for_each_run(operands.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+                kernel(results[i], operands[i]);
+        });
+        return results;
+    }
+
+    /**
+     * @brief Complex counterpart of @code zip @endcode, the kernel is of the form
+     * @code void(complex1000 &result, const complex1000 &first, const complex1000 &second) @endcode
+     */
+    template<typename Kernel>
+    ComplexBatch zip(const ComplexBatch &first, const ComplexBatch &second, Kernel &&kernel) {
+        if (first.size() != second.size() && first.size() != 1 && second.size() != 1)
+            throw std::runtime_error("Batch operands differ in length !");
+        const std::size_t length{std::max(first.size(), second.size())};
+        const std::size_t first_stride{first.size() == 1 ? 0u : 1u};
+        const std::size_t second_stride{second.size() == 1 ? 0u : 1u};
+        ComplexBatch results(length);
+        for_each_run(length, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+                kernel(results[i], first[i * first_stride], second[i * second_stride]);
+        });
+        return results;
+    }
+} // namespace mmqli::core::batch
+#endif // BATCH_HPP
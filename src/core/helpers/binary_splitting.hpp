@@ -0,0 +1,484 @@
+#ifndef BINARY_SPLITTING_HPP
+#define BINARY_SPLITTING_HPP
+
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <gmpxx.h>
+#include "boost_fwd.hpp"
+#include "cache.hpp"
+#include "cancel.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+#include "radix.hpp"
+
+/**
+ * @brief This namespace contains the engine behind the CONSTANT query. Every constant is a rapidly converging series
+ * of rational terms, whose partial sum is computed exactly with integers by binary splitting: the range of terms is
+ * halved recursively and the two halves are merged with a few large multiplications, so the cost is dominated by the
+ * multiplication of the final integers rather than by the number of terms. Only the final division is done in
+ * floating point, at the precision of the requested digits. The digits are cached on disk per digit count.
+ */
+namespace mmqli::core::binary_splitting {
+    using precision::Register;
+
+    constexpr std::size_t guard_digits{20}; // computed beyond the requested digits, then truncated
+    constexpr double bits_per_digit{3.3219280948873623};
+
+    /**
+     * @brief One term of a series @code S = sum a(n) / b(n) * p(0) / q(0) * ... * p(n) / q(n) @endcode.
+     */
+    struct Term {
+        mpz_class p{1};
+        mpz_class q{1};
+        mpz_class a{1};
+        mpz_class b{1};
+    };
+
+    /**
+     * @brief The terms [begin, end) of a series merged together, the partial sum is @code T / (B * Q) @endcode with
+     * the products P and Q taken over the same range.
+     */
+    struct Split {
+        mpz_class P{1};
+        mpz_class Q{1};
+        mpz_class B{1};
+        mpz_class T{0};
+
+        static Split from(Term term) {
+            Split leaf;
+            leaf.T = term.a * term.p;
+            leaf.P = std::move(term.p);
+            leaf.Q = std::move(term.q);
+            leaf.B = std::move(term.b);
+            return leaf;
+        }
+    };
+
+    inline Split combine(Split left, Split right) {
+        Split merged;
+        merged.T = right.B * right.Q * left.T + left.B * left.P * right.T;
+        merged.P = left.P * right.P;
+        merged.Q = left.Q * right.Q;
+        merged.B = left.B * right.B;
+        return merged;
+    }
+
+    /**
+     * @brief The terms [begin, end) of the Brent-McMillan sums @code sum c(k) @endcode and
+     * @code sum c(k) * H(k) @endcode for Euler's constant, where @code c(k) = (n^k / k!)^2 @endcode and H(k) is the
+     * k-th harmonic number. Beside P, Q and T, which hold the first sum like in @ref Split, C and D hold the harmonic
+     * numbers local to the range as @code D / C @endcode and V holds the second sum as @code V / (Q * C) @endcode.
+     */
+    struct HarmonicSplit {
+        mpz_class P{1};
+        mpz_class Q{1};
+        mpz_class T{0};
+        mpz_class C{1};
+        mpz_class D{0};
+        mpz_class V{0};
+    };
+
+    inline HarmonicSplit combine(HarmonicSplit left, HarmonicSplit right) {
+        HarmonicSplit merged;
+        merged.V = right.Q * right.C * left.V + left.P * (left.D * right.C * right.T + left.C * right.V);
+        merged.T = right.Q * left.T + left.P * right.T;
+        merged.D = left.D * right.C + right.D * left.C;
+        merged.P = left.P * right.P;
+        merged.Q = left.Q * right.Q;
+        merged.C = left.C * right.C;
+        return merged;
+    }
+
+    /**
+     * @brief A @ref HarmonicSplit rounded to floating point. The integers of the Brent-McMillan sums grow far beyond
+     * the working precision, so the ranges are only merged exactly up to about that size and then merged in floating
+     * point. All the parts are positive, so every rounding costs at most one unit in the last place.
+     */
+    struct RoundedHarmonicSplit {
+        Register P, Q, T, C, D, V;
+
+        static RoundedHarmonicSplit from(const HarmonicSplit &exact, const mpfr_prec_t bits) {
+            RoundedHarmonicSplit rounded{Register(bits), Register(bits), Register(bits), Register(bits),
+                                         Register(bits), Register(bits)};
+            mpfr_set_z(rounded.P.get(), exact.P.get_mpz_t(), MPFR_RNDN);
+            mpfr_set_z(rounded.Q.get(), exact.Q.get_mpz_t(), MPFR_RNDN);
+            mpfr_set_z(rounded.T.get(), exact.T.get_mpz_t(), MPFR_RNDN);
+            mpfr_set_z(rounded.C.get(), exact.C.get_mpz_t(), MPFR_RNDN);
+            mpfr_set_z(rounded.D.get(), exact.D.get_mpz_t(), MPFR_RNDN);
+            mpfr_set_z(rounded.V.get(), exact.V.get_mpz_t(), MPFR_RNDN);
+            return rounded;
+        }
+    };
+
+    inline RoundedHarmonicSplit combine(RoundedHarmonicSplit left, RoundedHarmonicSplit right) {
+        Register scratch(left.V.bits());
+        Register product(left.V.bits());
+        // V = Q2 C2 V1 + P1 (D1 C2 T2 + C1 V2), before D1 and C1 are overwritten
+        mpfr_mul(scratch.get(), left.D.get(), right.C.get(), MPFR_RNDN);
+        mpfr_mul(scratch.get(), scratch.get(), right.T.get(), MPFR_RNDN);
+        mpfr_mul(product.get(), left.C.get(), right.V.get(), MPFR_RNDN);
+        mpfr_add(scratch.get(), scratch.get(), product.get(), MPFR_RNDN);
+        mpfr_mul(scratch.get(), scratch.get(), left.P.get(), MPFR_RNDN);
+        mpfr_mul(left.V.get(), left.V.get(), right.Q.get(), MPFR_RNDN);
+        mpfr_mul(left.V.get(), left.V.get(), right.C.get(), MPFR_RNDN);
+        mpfr_add(left.V.get(), left.V.get(), scratch.get(), MPFR_RNDN);
+        // T = Q2 T1 + P1 T2
+        mpfr_mul(left.T.get(), left.T.get(), right.Q.get(), MPFR_RNDN);
+        mpfr_mul(product.get(), left.P.get(), right.T.get(), MPFR_RNDN);
+        mpfr_add(left.T.get(), left.T.get(), product.get(), MPFR_RNDN);
+        // D = D1 C2 + D2 C1
+        mpfr_mul(left.D.get(), left.D.get(), right.C.get(), MPFR_RNDN);
+        mpfr_mul(product.get(), right.D.get(), left.C.get(), MPFR_RNDN);
+        mpfr_add(left.D.get(), left.D.get(), product.get(), MPFR_RNDN);
+        mpfr_mul(left.P.get(), left.P.get(), right.P.get(), MPFR_RNDN);
+        mpfr_mul(left.Q.get(), left.Q.get(), right.Q.get(), MPFR_RNDN);
+        mpfr_mul(left.C.get(), left.C.get(), right.C.get(), MPFR_RNDN);
+        return left;
+    }
+
+    /**
+     * @brief Merges the leaves [begin, end) recursively on the calling thread.
+     * @param leaf A callable returning the merged form of term n.
+     */
+    template<typename Leaf>
+    auto split(const Leaf &leaf, const unsigned long begin, const unsigned long end) -> decltype(leaf(begin)) {
+        if (end - begin == 1)
+            return leaf(begin);
+        if (end - begin >= 64) // the small ranges are too quick to be worth a check
+            cancel::point();
+        const unsigned long middle{begin + (end - begin) / 2};
+        return combine(split(leaf, begin, middle), split(leaf, middle, end));
+    }
+
+    /**
+     * @brief Splits the leaves [0, terms) into @p chunks consecutive ranges over all the cores, each range is merged
+     * independently on one worker.
+     */
+    template<typename Leaf>
+    auto split_chunks(const Leaf &leaf, const unsigned long terms, const std::size_t chunks)
+        -> std::vector<decltype(leaf(0UL))> {
+        std::vector<decltype(leaf(0UL))> parts(chunks);
+        parallel::parallel_for(chunks, [&](const std::size_t i) {
+            parts[i] = split(leaf, terms * i / chunks, terms * (i + 1) / chunks);
+        });
+        return parts;
+    }
+
+    /**
+     * @brief Merges consecutive parts pairwise, level by level, the merges of one level run in parallel. Only the last
+     * merges, which multiply the largest numbers, run on fewer cores.
+     */
+    template<typename Part>
+    Part merge(std::vector<Part> parts) {
+        while (parts.size() > 1) {
+            std::vector<Part> merged(parts.size() / 2);
+            parallel::parallel_for(merged.size(), [&](const std::size_t i) {
+                merged[i] = combine(std::move(parts[2 * i]), std::move(parts[2 * i + 1]));
+            });
+            parts = std::move(merged);
+        }
+        return std::move(parts.front());
+    }
+
+    /**
+     * @brief A power of two of chunks, at least @p minimum and a few per worker because the later terms hold larger
+     * integers, but never more chunks than terms.
+     */
+    inline std::size_t chunk_count(const unsigned long terms, const std::size_t minimum = 1) {
+        std::size_t chunks{1};
+        while ((chunks < 4 * parallel::worker_count() || chunks < minimum) && 2 * chunks <= terms)
+            chunks *= 2;
+        return chunks;
+    }
+
+    /**
+     * @brief Merges the leaves [0, terms) over all the cores.
+     */
+    template<typename Leaf>
+    auto parallel_split(const Leaf &leaf, const unsigned long terms) -> decltype(leaf(0UL)) {
+        return merge(split_chunks(leaf, terms, chunk_count(terms)));
+    }
+
+    inline mpfr_prec_t bits_for(const std::size_t digits) {
+        return static_cast<mpfr_prec_t>(std::ceil(static_cast<double>(digits + guard_digits) * bits_per_digit)) + 64;
+    }
+
+    inline unsigned long terms_for(const std::size_t digits, const double digits_per_term) {
+        return static_cast<unsigned long>(std::ceil(static_cast<double>(digits + guard_digits) / digits_per_term)) + 2;
+    }
+
+    /**
+     * @brief Sets @p result to @code numerator / denominator @endcode.
+     */
+    inline void divide(Register &result, const mpz_class &numerator, const mpz_class &denominator) {
+        Register divisor(result.bits());
+        mpfr_set_z(result.get(), numerator.get_mpz_t(), MPFR_RNDN);
+        mpfr_set_z(divisor.get(), denominator.get_mpz_t(), MPFR_RNDN);
+        mpfr_div(result.get(), result.get(), divisor.get(), MPFR_RNDN);
+    }
+
+    /**
+     * @brief Pi by the Chudnovsky series, about 14 digits per term.
+     */
+    inline void pi(Register &result, const std::size_t digits) {
+        const Split sum{
+            parallel_split([](const unsigned long n) {
+                if (n == 0)
+                    return Split::from(Term{1, 1, 13591409, 1});
+                Term term;
+                term.p = 6 * n - 5;
+                term.p *= 2 * n - 1;
+                term.p *= 6 * n - 1;
+                term.p = -term.p;
+                term.q = n;
+                term.q *= n;
+                term.q *= n;
+                term.q *= 10939058860032000UL; // 640320^3 / 24
+                term.a = 545140134UL;
+                term.a *= n;
+                term.a += 13591409;
+                return Split::from(std::move(term));
+            }, terms_for(digits, 14.18))
+        };
+        divide(result, sum.Q, sum.T);
+        Register root(result.bits());
+        mpfr_sqrt_ui(root.get(), 10005, MPFR_RNDN);
+        mpfr_mul(result.get(), result.get(), root.get(), MPFR_RNDN);
+        mpfr_mul_ui(result.get(), result.get(), 426880, MPFR_RNDN);
+    }
+
+    /**
+     * @brief e as the sum of 1/n!, the number of terms is such that n! exceeds 10^digits.
+     */
+    inline void e(Register &result, const std::size_t digits) {
+        const double target{static_cast<double>(digits + guard_digits) * std::log(10.0)};
+        unsigned long low{1};
+        unsigned long high{2};
+        while (std::lgamma(static_cast<double>(high) + 1) < target)
+            high *= 2;
+        while (low + 1 < high) {
+            const unsigned long middle{low + (high - low) / 2};
+            (std::lgamma(static_cast<double>(middle) + 1) < target ? low : high) = middle;
+        }
+        const Split sum{
+            parallel_split([](const unsigned long n) {
+                return Split::from(Term{1, n == 0 ? 1 : n, 1, 1});
+            }, high + 2)
+        };
+        divide(result, sum.T, sum.Q);
+    }
+
+    /**
+     * @brief ln 2 by @code 3/4 * sum (-1)^n * (n!)^2 / (2^n * (2n+1)!) @endcode, about 0.9 digits per term.
+     */
+    inline void ln2(Register &result, const std::size_t digits) {
+        const Split sum{
+            parallel_split([](const unsigned long n) {
+                if (n == 0)
+                    return Split::from(Term{});
+                return Split::from(Term{-mpz_class{n}, 4 * (2 * n + 1), 1, 1});
+            }, terms_for(digits, 0.903))
+        };
+        divide(result, sum.T * 3, sum.Q * 4);
+    }
+
+    /**
+     * @brief Catalan's constant by Lupas' series
+     * @code 1/64 * sum (-1)^(n-1) * 2^(8n) * (40n^2 - 24n + 3) * ((2n)!)^3 * (n!)^2 / (n^3 * (2n-1) * ((4n)!)^2) @endcode
+     * over n >= 1, about 0.6 digits per term. Unlike the formulas through pi and logarithms, it is a single series.
+     */
+    inline void catalan(Register &result, const std::size_t digits) {
+        const Split sum{
+            parallel_split([](const unsigned long n) {
+                if (n == 0)
+                    return Split::from(Term{1, 1, 0, 1}); // the series starts at n = 1
+                // n^3 * (2n-1) cancels between the term and the ratio to the next term, so it is moved one term
+                // forward and the series has no denominators of its own.
+                Term term;
+                if (n > 1) {
+                    term.p = n - 1;
+                    term.p *= term.p * (n - 1);
+                    term.p *= -32 * static_cast<long>(2 * n - 3);
+                }
+                term.q = (4 * n - 3) * (4 * n - 1);
+                term.q *= term.q;
+                term.a = 40 * n;
+                term.a *= n;
+                term.a -= 24 * n;
+                term.a += 3;
+                term.a *= -32;
+                return Split::from(std::move(term));
+            }, terms_for(digits, 0.602))
+        };
+        divide(result, -sum.T, sum.Q * 64);
+    }
+
+    /**
+     * @brief Apery's constant zeta(3) by the Amdeberhan-Zeilberger series
+     * @code 1/64 * sum (-1)^n * (n!)^10 * (205n^2 + 250n + 77) / ((2n+1)!)^5 @endcode, about 3 digits per term.
+     */
+    inline void zeta3(Register &result, const std::size_t digits) {
+        const Split sum{
+            parallel_split([](const unsigned long n) {
+                if (n == 0)
+                    return Split::from(Term{1, 1, 77, 1});
+                Term term;
+                mpz_class odd{2 * n + 1};
+                mpz_pow_ui(term.p.get_mpz_t(), mpz_class{n}.get_mpz_t(), 5);
+                term.p = -term.p;
+                mpz_pow_ui(term.q.get_mpz_t(), odd.get_mpz_t(), 5);
+                term.q *= 32;
+                term.a = n;
+                term.a *= 205 * n + 250;
+                term.a += 77;
+                return Split::from(std::move(term));
+            }, terms_for(digits, 3.01))
+        };
+        divide(result, sum.T, sum.Q * 64);
+    }
+
+    /**
+     * @brief The Euler-Mascheroni constant by the Brent-McMillan formula
+     * @code sum c(k) * H(k) / sum c(k) - ln n @endcode with @code c(k) = (n^k / k!)^2 @endcode, whose error is about
+     * e^(-4n). The sums are truncated where c(k) falls below that error. n is a power of two, so that ln n is a
+     * multiple of ln 2 given by its own series rather than by a logarithm at full precision.
+     */
+    inline void euler(Register &result, const std::size_t digits) {
+        const double minimum_n{static_cast<double>(digits + guard_digits) * std::log(10.0) / 4};
+        unsigned long power{0};
+        while (std::ldexp(1.0, static_cast<int>(power)) < minimum_n)
+            ++power;
+        const unsigned long n{1UL << power};
+        // c(k) peaks at about e^(2n), the sums stop at the first k past the peak where c(k) is below the requested
+        // digits relative to that peak. n may be up to twice the minimum, which moves that k well below 4.97n.
+        const double cut_off{2 * static_cast<double>(n) - static_cast<double>(digits + guard_digits) * std::log(10.0)};
+        auto log_c{[&](const unsigned long k) {
+            return 2 * (static_cast<double>(k) * std::log(static_cast<double>(n)) - std::lgamma(static_cast<double>(k) + 1));
+        }};
+        unsigned long low{n};
+        unsigned long high{5 * n + 2};
+        while (low + 1 < high) {
+            const unsigned long middle{low + (high - low) / 2};
+            (log_c(middle) > cut_off ? low : high) = middle;
+        }
+        const unsigned long terms{high + 1};
+        mpz_class square{n};
+        square *= n;
+        // Q alone is (terms!)^2, cut the range so that every chunk holds integers of about the working precision.
+        const double exact_bits{2 * std::lgamma(static_cast<double>(terms) + 1) / std::log(2.0)};
+        std::vector<HarmonicSplit> exact{
+            split_chunks([&square](const unsigned long k) {
+                if (k == 0)
+                    return HarmonicSplit{1, 1, 1, 1, 0, 0};
+                mpz_class q{k};
+                q *= k;
+                return HarmonicSplit{square, std::move(q), square, k, 1, square};
+            }, terms, chunk_count(terms, static_cast<std::size_t>(exact_bits / static_cast<double>(result.bits()))))
+        };
+        std::vector<RoundedHarmonicSplit> rounded(exact.size());
+        parallel::parallel_for(exact.size(), [&](const std::size_t i) {
+            rounded[i] = RoundedHarmonicSplit::from(exact[i], result.bits());
+            exact[i] = HarmonicSplit{};
+        });
+        const RoundedHarmonicSplit sum{merge(std::move(rounded))};
+        mpfr_mul(result.get(), sum.C.get(), sum.T.get(), MPFR_RNDN);
+        mpfr_div(result.get(), sum.V.get(), result.get(), MPFR_RNDN);
+        Register logarithm(result.bits());
+        ln2(logarithm, digits);
+        mpfr_mul_ui(logarithm.get(), logarithm.get(), power, MPFR_RNDN);
+        mpfr_sub(result.get(), result.get(), logarithm.get(), MPFR_RNDN);
+    }
+
+    /**
+     * @brief The constants known to the CONSTANT query.
+     */
+    inline const std::map<std::string, std::function<void(Register &, std::size_t)>> &engines() {
+        static const std::map<std::string, std::function<void(Register &, std::size_t)>> known{
+            {"PI", pi}, {"E", e}, {"LN2", ln2}, {"CATALAN", catalan}, {"EULER", euler}, {"ZETA3", zeta3}
+        };
+        return known;
+    }
+
+    /**
+     * @brief The estimated peak memory of the constant @p name to @p digits digits, in bytes: a multiple of the bytes
+     * of the digits, measured at a million digits. The series of Catalan's constant and of Euler's constant hold many
+     * more integers of full size than the others while they are merged.
+     */
+    inline std::size_t working_memory(const std::string &name, const std::size_t digits) {
+        const std::size_t multiple{name == "CATALAN" || name == "EULER" ? 512u : name == "PI" || name == "E" ? 32u : 160u};
+        return multiple * cancel::bytes_of(bits_for(digits));
+    }
+
+    /**
+     * @brief Writes @p value with @p digits digits after the decimal point. The value holds more digits than that, so
+     * the expansion is truncated rather than rounded, which keeps the digits of a shorter request a prefix of the
+     * digits of a longer one.
+     */
+    inline std::string to_digits(const Register &value, const std::size_t digits) {
+        std::string text;
+        text.reserve(digits + 32);
+        radix::write_fixed(value.get(), digits, [&text](const std::string_view part) { text.append(part); });
+        return text;
+    }
+
+    /**
+     * @brief The digits of a constant cached in a previous run, taken from the smallest cached digit count that is at
+     * least @p digits.
+     * @return The digits, or an empty string when none are cached.
+     */
+    inline std::string cached(const std::filesystem::path &directory, const std::string &name,
+                              const std::size_t digits) {
+        std::filesystem::path best;
+        std::size_t best_digits{0};
+        std::error_code failure;
+        for (const auto &entry: std::filesystem::directory_iterator(directory, failure)) {
+            const std::string stem{entry.path().stem().string()};
+            if (entry.path().extension() != ".txt" || !stem.starts_with(name + "-"))
+                continue;
+            std::size_t count{0};
+            const char *first{stem.data() + name.size() + 1};
+            const char *last{stem.data() + stem.size()};
+            if (const auto [end, error]{std::from_chars(first, last, count)}; error != std::errc{} || end != last)
+                continue;
+            if (count >= digits && (best.empty() || count < best_digits)) {
+                best = entry.path();
+                best_digits = count;
+            }
+        }
+        if (best.empty())
+            return "";
+        const std::optional<std::string> text{cache::load(best)};
+        const std::size_t point{text ? text->find('.') : std::string::npos};
+        if (point == std::string::npos || text->size() < point + 1 + best_digits)
+            return ""; // damaged file, computed again
+        return text->substr(0, point + 1 + digits);
+    }
+
+    /**
+     * @brief The constant @p name with @p digits digits after the decimal point. The digits come from the disk cache
+     * when an equal or longer expansion was computed before, otherwise they are computed and cached.
+     */
+    inline std::string constant(const std::string &name, const std::size_t digits) {
+        const auto engine{engines().find(name)};
+        if (engine == engines().end())
+            throw std::runtime_error("Unknown constant " + name + ", the constants are CATALAN, E, EULER, LN2, PI and ZETA3 !");
+        const std::filesystem::path directory{cache::directory("constants")};
+        if (std::string digits_text{cached(directory, name, digits)}; !digits_text.empty())
+            return digits_text;
+        Register value(bits_for(digits));
+        engine->second(value, digits);
+        std::string digits_text{to_digits(value, digits)};
+        cache::store(directory / (name + "-" + std::to_string(digits) + ".txt"), digits_text);
+        return digits_text;
+    }
+} // namespace mmqli::core::binary_splitting
+#endif // BINARY_SPLITTING_HPP
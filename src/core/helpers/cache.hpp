@@ -0,0 +1,83 @@
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+
+/**
+ * @brief This namespace contains the on-disk storage of results that are expensive to compute. The cache is only an
+ * accelerator: a file that cannot be read or written is treated as missing, never as an error.
+ */
+namespace mmqli::core::cache {
+    /**
+     * @brief The directory holding the cache @p section, it is created on first use. The root is the
+     * @code MMQLC_CACHE_DIR @endcode environment variable, else @code $XDG_CACHE_HOME/mmqlc @endcode, else
+     * @code ~/.cache/mmqlc @endcode, else the temporary directory of the system.
+     */
+    inline std::filesystem::path directory(const std::string &section) {
+        std::filesystem::path root;
+        if (const char *explicit_root{std::getenv("MMQLC_CACHE_DIR")}; explicit_root != nullptr && *explicit_root)
+            root = explicit_root;
+        else if (const char *xdg{std::getenv("XDG_CACHE_HOME")}; xdg != nullptr && *xdg)
+            root = std::filesystem::path{xdg} / "mmqlc";
+        else if (const char *home{std::getenv("HOME")}; home != nullptr && *home)
+            root = std::filesystem::path{home} / ".cache" / "mmqlc";
+        else {
+            std::error_code ignored;
+            root = std::filesystem::temp_directory_path(ignored) / "mmqlc";
+        }
+        std::error_code ignored;
+        std::filesystem::create_directories(root / section, ignored);
+        return root / section;
+    }
+
+    /**
+     * @brief Reads the whole file at @p path.
+     * @return The contents, or nothing when the file is missing or unreadable.
+     */
+    inline std::optional<std::string> load(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return std::nullopt;
+        std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        if (file.bad())
+            return std::nullopt;
+        return contents;
+    }
+
+    /**
+     * @brief Writes @p contents to @p path. The data goes to a temporary sibling first and is then renamed over
+     * @p path, so concurrent readers (another mmqlc process for instance) never see a partial file.
+     * @return false when the file could not be written.
+     */
+    inline bool store(const std::filesystem::path &path, const std::string &contents) {
+        std::filesystem::path temporary{path};
+        temporary += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            if (!file.flush()) {
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                return false;
+            }
+        }
+        std::error_code failure;
+        std::filesystem::rename(temporary, path, failure);
+        if (failure) {
+            std::error_code ignored;
+            std::filesystem::remove(temporary, ignored);
+            return false;
+        }
+        return true;
+    }
+} // namespace mmqli::core::cache
+#endif // CACHE_HPP
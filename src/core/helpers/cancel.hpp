@@ -0,0 +1,166 @@
+#ifndef CANCEL_HPP
+#define CANCEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "boost_fwd.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the budgets of the queries. A query is evaluated under a budget installed on the
+ * thread that evaluates it: a deadline when a timeout is set, and the count of interrupts when it started. The kernels
+ * call @ref point between their steps: the indices of a parallel region (the elements of a batch, the tiles of a dense
+ * factorization, the iterations of a root finder), the splits of binary splitting, the attempts of the adaptive
+ * evaluation and the terms of zeta. @ref point throws @ref Cancelled once the budget is spent. The core answers the query with a cancelled error, the other queries of
+ * the line are answered as usual.
+ *
+ * An interrupt cancels the queries running when it arrives, not the ones started after it. A single MPFR or GMP call
+ * cannot be stopped halfway, so the memory limit rejects the queries whose numbers would not fit before they are
+ * evaluated, from an estimate of their size.
+ */
+namespace mmqli::core::cancel {
+    /**
+     * @brief Thrown by @ref point when the budget of the query is spent.
+     */
+    class Cancelled : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    namespace detail {
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "interrupt() is called by signal handlers");
+        inline std::atomic<std::uint32_t> interrupts{0};
+        inline std::atomic<std::int64_t> timeout_ms{0}; // 0 for no deadline
+        inline std::atomic<std::size_t> memory_limit{0}; // in bytes, 0 for no limit
+
+        struct Budget {
+            std::chrono::steady_clock::time_point deadline;
+            std::int64_t timeout_ms{0};
+            std::uint32_t interrupts{0}; // when the query started
+        };
+
+        inline thread_local const Budget *budget{nullptr};
+    }
+
+    /**
+     * @brief Cancels the queries running on every thread. It only updates an atomic counter, so a signal handler may
+     * call it.
+     */
+    inline void interrupt() noexcept { detail::interrupts.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief The time every query is given from its start, zero for no limit.
+     */
+    inline void set_timeout(const std::chrono::milliseconds timeout) {
+        detail::timeout_ms.store(timeout.count(), std::memory_order_relaxed);
+    }
+
+    inline std::chrono::milliseconds timeout() {
+        return std::chrono::milliseconds{detail::timeout_ms.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * @brief The memory a query may be estimated to need, in bytes, zero for no limit.
+     */
+    inline void set_memory_limit(const std::size_t bytes) {
+        detail::memory_limit.store(bytes, std::memory_order_relaxed);
+    }
+
+    inline std::size_t memory_limit() { return detail::memory_limit.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief The budget of one query on the calling thread, for the lifetime of the guard. A query evaluated inside
+     * another one keeps the budget of the outer query.
+     */
+    class Query {
+        detail::Budget own;
+        const detail::Budget *previous;
+
+    public:
+        Query() : previous(detail::budget) {
+            if (previous != nullptr)
+                return;
+            own.timeout_ms = detail::timeout_ms.load(std::memory_order_relaxed);
+            own.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{own.timeout_ms};
+            own.interrupts = detail::interrupts.load(std::memory_order_relaxed);
+            detail::budget = &own;
+        }
+
+        Query(const Query &) = delete;
+        Query &operator=(const Query &) = delete;
+
+        ~Query() { detail::budget = previous; }
+    };
+
+    /**
+     * @brief The budget of the calling thread, nullptr outside of a query.
+     */
+    inline const detail::Budget *current() { return detail::budget; }
+
+    /**
+     * @brief Makes a worker of a parallel region run under the budget of the thread that started the region, for the
+     * lifetime of the guard.
+     */
+    class Adopt {
+        const detail::Budget *previous;
+
+    public:
+        explicit Adopt(const detail::Budget *budget) : previous(std::exchange(detail::budget, budget)) {}
+
+        Adopt(const Adopt &) = delete;
+        Adopt &operator=(const Adopt &) = delete;
+
+        ~Adopt() { detail::budget = previous; }
+    };
+
+    /**
+     * @brief A cancellation point: throws @ref Cancelled when the query of the calling thread was interrupted or is
+     * past its deadline, does nothing outside of a query.
+     */
+    inline void point() {
+        const detail::Budget *budget{detail::budget};
+        if (budget == nullptr)
+            return;
+        if (detail::interrupts.load(std::memory_order_relaxed) != budget->interrupts)
+            throw Cancelled("The query was interrupted !");
+        if (budget->timeout_ms != 0 && std::chrono::steady_clock::now() > budget->deadline)
+            throw Cancelled("The query ran out of its " + std::to_string(budget->timeout_ms) + " ms !");
+    }
+
+    /**
+     * @brief The bytes of the limbs of a number of @p bits.
+     */
+    constexpr std::size_t bytes_of(const mpfr_prec_t bits) {
+        return static_cast<std::size_t>((bits + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS) * sizeof(mp_limb_t);
+    }
+
+    /**
+     * @brief The estimated bytes of a float1000 held by a query: the number and its limbs, and its text in the answer.
+     */
+    constexpr std::size_t real_bytes{
+        sizeof(float1000) + bytes_of(precision::float1000_bits) + std::numeric_limits<float1000>::digits10 + 8
+    };
+
+    /**
+     * @brief Whether a query estimated to need @p bytes is within the memory limit.
+     */
+    inline bool fits(const std::size_t bytes) {
+        const std::size_t limit{memory_limit()};
+        return limit == 0 || bytes <= limit;
+    }
+
+    /**
+     * @brief The message of a query estimated to need @p bytes, above the memory limit.
+     */
+    inline std::string too_large(const std::size_t bytes) {
+        return "The query needs about " + std::to_string((bytes >> 20) + 1) + " MiB, above the memory limit of " +
+               std::to_string(memory_limit() >> 20) + " MiB !";
+    }
+} // namespace mmqli::core::cancel
+#endif // CANCEL_HPP
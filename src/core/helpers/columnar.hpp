@@ -0,0 +1,336 @@
+#ifndef COLUMNAR_HPP
+#define COLUMNAR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "error.hpp"
+
+#if WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief This namespace contains the bulk map mode: one query template, such as @code COMBINATION $1,$2 @endcode,
+ * applied to every row of a CSV or TSV file. The file is memory-mapped and split into chunks on row boundaries, the
+ * numeric columns are read straight into MPFR numbers without going through the lexer, and the chunks are evaluated
+ * independently so they can run in parallel.
+ */
+namespace mmqli::core::columnar {
+    /**
+     * @brief The chunks are sized for a few of them per worker, within these bounds.
+     */
+    constexpr std::size_t smallest_chunk{1u << 12};
+    constexpr std::size_t largest_chunk{1u << 20};
+    constexpr std::size_t largest_column{1u << 16};
+
+    /**
+     * @brief A file mapped read-only into memory, unmapped when it goes out of scope. An empty file maps to an empty
+     * view.
+     */
+    class MappedFile {
+        const char *data{nullptr};
+        std::size_t size{0};
+#if WIN32
+        HANDLE file{INVALID_HANDLE_VALUE};
+        HANDLE mapping{nullptr};
+#endif
+
+        MappedFile() = default;
+
+        void release() noexcept {
+#if WIN32
+            if (data != nullptr)
+                UnmapViewOfFile(data);
+            if (mapping != nullptr)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+#else
+            if (data != nullptr)
+                munmap(const_cast<char *>(data), size);
+#endif
+        }
+
+    public:
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept
+            : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0))
+#if WIN32
+            , file(std::exchange(other.file, INVALID_HANDLE_VALUE)), mapping(std::exchange(other.mapping, nullptr))
+#endif
+        {}
+
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                release();
+                data = std::exchange(other.data, nullptr);
+                size = std::exchange(other.size, 0);
+#if WIN32
+                file = std::exchange(other.file, INVALID_HANDLE_VALUE);
+                mapping = std::exchange(other.mapping, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        ~MappedFile() { release(); }
+
+        [[nodiscard]] std::string_view view() const { return {data, size}; }
+
+        static error::Result<MappedFile> open(const std::string &path) {
+            const auto unreadable{
+                [&] { return error::fail(error::Code::unreadable_file, "Cannot read the file " + path + " !"); }
+            };
+            MappedFile mapped;
+#if WIN32
+            mapped.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            LARGE_INTEGER length{};
+            if (mapped.file == INVALID_HANDLE_VALUE || !GetFileSizeEx(mapped.file, &length))
+                return unreadable();
+            mapped.size = static_cast<std::size_t>(length.QuadPart);
+            if (mapped.size == 0)
+                return mapped;
+            mapped.mapping = CreateFileMappingA(mapped.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapped.mapping == nullptr)
+                return unreadable();
+            mapped.data = static_cast<const char *>(MapViewOfFile(mapped.mapping, FILE_MAP_READ, 0, 0, 0));
+            if (mapped.data == nullptr)
+                return unreadable();
+#else
+            const int descriptor{::open(path.c_str(), O_RDONLY)};
+            if (descriptor < 0)
+                return unreadable();
+            struct stat status{};
+            if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+                close(descriptor);
+                return unreadable();
+            }
+            mapped.size = static_cast<std::size_t>(status.st_size);
+            if (mapped.size != 0) {
+                void *address{mmap(nullptr, mapped.size, PROT_READ, MAP_PRIVATE, descriptor, 0)};
+                if (address == MAP_FAILED) {
+                    close(descriptor);
+                    return unreadable();
+                }
+                madvise(address, mapped.size, MADV_SEQUENTIAL);
+                mapped.data = static_cast<const char *>(address);
+            }
+            close(descriptor); // the mapping outlives the descriptor
+#endif
+            return mapped;
+        }
+    };
+
+    /**
+     * @brief An operand of the template: a 1-based column of the row, or a literal when column is 0.
+     */
+    struct Operand {
+        std::size_t column{0};
+        float1000 literal{0};
+    };
+
+    struct Template {
+        std::string keyword;
+        std::vector<Operand> operands; // one or two
+    };
+
+    /**
+     * @brief Reads @p text into @p x, the whole text has to be a decimal number, surrounding blanks and double quotes
+     * aside. @p scratch holds the null-terminated copy MPFR reads from, the mapped file is not null-terminated.
+     */
+    inline bool parse_number(std::string_view text, mpfr_ptr x, std::string &scratch) {
+        const auto blank{[](const char c) { return c == ' ' || c == '\t' || c == '\r'; }};
+        while (!text.empty() && blank(text.front()))
+            text.remove_prefix(1);
+        while (!text.empty() && blank(text.back()))
+            text.remove_suffix(1);
+        if (text.size() >= 2 && text.front() == '"' && text.back() == '"')
+            text = text.substr(1, text.size() - 2);
+        if (text.empty() || text.size() > largest_column)
+            return false;
+        scratch.assign(text);
+        char *end{nullptr};
+        mpfr_strtofr(x, scratch.c_str(), &end, 10, MPFR_RNDN);
+        return end == scratch.c_str() + scratch.size();
+    }
+
+    /**
+     * @brief Parses a template of the form @code KEYWORD $1,$2 @endcode, an operand is a column @code $n @endcode or
+     * a number.
+     */
+    inline error::Result<Template> parse_template(const std::string_view text) {
+        Template pattern;
+        const std::size_t space{text.find(' ')};
+        pattern.keyword = text.substr(0, space);
+        if (pattern.keyword.empty() || !std::ranges::all_of(pattern.keyword, [](const char c) {
+            return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+        }))
+            return error::fail(error::Code::syntax, "The map " + std::string{text} + " has no keyword !");
+        std::string_view rest{space == std::string_view::npos ? std::string_view{} : text.substr(space + 1)};
+        std::string scratch;
+        while (!rest.empty()) {
+            const std::size_t comma{rest.find(',')};
+            std::string_view operand{rest.substr(0, comma)};
+            rest = comma == std::string_view::npos ? std::string_view{} : rest.substr(comma + 1);
+            while (!operand.empty() && operand.front() == ' ')
+                operand.remove_prefix(1);
+            while (!operand.empty() && operand.back() == ' ')
+                operand.remove_suffix(1);
+            Operand parsed;
+            if (operand.starts_with('$')) {
+                for (const char c: operand.substr(1)) {
+                    if (c < '0' || c > '9' || parsed.column > largest_column)
+                        return error::fail(error::Code::invalid_literal, std::string{operand} + " is not a column !");
+                    parsed.column = parsed.column * 10 + static_cast<std::size_t>(c - '0');
+                }
+                if (parsed.column == 0)
+                    return error::fail(error::Code::invalid_literal, std::string{operand} + " is not a column, "
+                                                                     "the columns start at $1 !");
+            } else if (!parse_number(operand, parsed.literal.backend().data(), scratch)) {
+                return error::fail(error::Code::invalid_number, std::string{operand} + " is not a real number !");
+            }
+            pattern.operands.emplace_back(std::move(parsed));
+        }
+        if (pattern.operands.empty() || pattern.operands.size() > 2)
+            return error::fail(error::Code::syntax, "The map " + std::string{text} + " takes one or two operands !");
+        return pattern;
+    }
+
+    /**
+     * @brief The delimiter of the file: a tab when its first row has one, a comma otherwise.
+     */
+    inline char delimiter_of(const std::string_view data) {
+        const std::string_view first_row{data.substr(0, data.find('\n'))};
+        return first_row.find('\t') != std::string_view::npos ? '\t' : ',';
+    }
+
+    /**
+     * @brief The field of the 1-based @p column of @p row, nothing when the row has fewer fields. A quoted field
+     * holding the delimiter is not split.
+     */
+    inline std::optional<std::string_view> field(const std::string_view row, const char delimiter,
+                                                 const std::size_t column) {
+        std::size_t start{0};
+        for (std::size_t current = 1;; ++current) {
+            std::size_t end{start};
+            for (bool quoted{false}; end < row.size() && (quoted || row[end] != delimiter); ++end)
+                if (row[end] == '"')
+                    quoted = !quoted;
+            if (current == column)
+                return row.substr(start, end - start);
+            if (end >= row.size())
+                return std::nullopt;
+            start = end + 1;
+        }
+    }
+
+    /**
+     * @brief Reads the operands of @p pattern from @p row, the 1-based @p line of the file, into @p operands. The first
+     * line is a header when none of its columns is a number, a row with a number in one column is data, and any row
+     * of data with a column that is missing or not a real number is refused at the first such column.
+     * @return Whether the row holds operands, false for the header, or why the row cannot be read.
+     */
+    inline error::Result<bool> read_row(const Template &pattern, const std::size_t line, const std::string_view row,
+                                        const char delimiter, std::array<float1000, 2> &operands,
+                                        std::string &scratch) {
+        std::optional<error::Error> failure;
+        bool numbers{false}; // whether a column is a number
+        for (std::size_t i = 0; i < pattern.operands.size(); ++i) {
+            const Operand &operand{pattern.operands[i]};
+            if (operand.column == 0) {
+                operands[i] = operand.literal;
+                continue;
+            }
+            const auto text{field(row, delimiter, operand.column)};
+            if (text && parse_number(*text, operands[i].backend().data(), scratch)) {
+                numbers = true;
+                continue;
+            }
+            if (!failure) {
+                const std::size_t column{text ? static_cast<std::size_t>(text->data() - row.data()) + 1 : 0};
+                failure = error::Error{
+                    error::Code::invalid_number, {line, column},
+                    "Column $" + std::to_string(operand.column) + (text ? " is not a real number !" : " is missing !")
+                };
+            }
+            if (line != 1)
+                break; // only the first line reads on, to tell a header from a row of data
+        }
+        if (!failure)
+            return true;
+        if (line == 1 && !numbers)
+            return false;
+        return std::unexpected{std::move(*failure)};
+    }
+
+    /**
+     * @brief A run of whole rows of the file, and the 1-based line of its first row.
+     */
+    struct Chunk {
+        std::string_view rows;
+        std::size_t first_line{1};
+    };
+
+    /**
+     * @brief The size of the chunks of a file of @p size bytes for @p workers workers, a few chunks per worker so
+     * that uneven rows still spread evenly.
+     */
+    inline std::size_t chunk_size(const std::size_t size, const std::size_t workers) {
+        return std::clamp(size / std::max<std::size_t>(1, workers * 4), smallest_chunk, largest_chunk);
+    }
+
+    /**
+     * @brief Splits @p data into chunks of about @p target bytes that end on a row boundary.
+     */
+    inline std::vector<Chunk> split(const std::string_view data, const std::size_t target) {
+        std::vector<Chunk> chunks;
+        std::size_t line{1};
+        for (std::size_t start = 0; start < data.size();) {
+            std::size_t end{std::min(data.size(), start + target)};
+            if (end < data.size()) {
+                const std::size_t newline{data.find('\n', end - 1)};
+                end = newline == std::string_view::npos ? data.size() : newline + 1;
+            }
+            const std::string_view rows{data.substr(start, end - start)};
+            chunks.push_back({rows, line});
+            line += static_cast<std::size_t>(std::ranges::count(rows, '\n'));
+            start = end;
+        }
+        return chunks;
+    }
+
+    /**
+     * @brief Calls @p visit for every non-empty row of @p chunk, with its 1-based line and its text without the line
+     * ending.
+     * @param visit A callable of the form @code void(std::size_t line, std::string_view row) @endcode
+     */
+    template<typename Visit>
+    void for_each_row(const Chunk &chunk, Visit &&visit) {
+        std::string_view rows{chunk.rows};
+        for (std::size_t line{chunk.first_line}; !rows.empty(); ++line) {
+            const std::size_t newline{rows.find('\n')};
+            std::string_view row{rows.substr(0, newline)};
+            rows = newline == std::string_view::npos ? std::string_view{} : rows.substr(newline + 1);
+            if (row.ends_with('\r'))
+                row.remove_suffix(1);
+            if (!row.empty())
+                visit(line, row);
+        }
+    }
+} // namespace mmqli::core::columnar
+#endif // COLUMNAR_HPP
@@ -0,0 +1,320 @@
+#ifndef DENSE_HPP
+#define DENSE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the dense linear algebra for matrices too large for the fixed size kernels of
+ * @code linalg @endcode. The kernels work on square tiles of @code block_size @endcode elements, the tiles are
+ * spread across the worker threads and every worker owns its MPFR temporaries, so the inner loops never allocate.
+ */
+namespace mmqli::core::dense {
+    /**
+     * @brief The edge of the square tiles. A tile of three operands at a few hundred digits stays within the L2
+     * cache of a core.
+     */
+    constexpr std::size_t block_size{32};
+
+    /**
+     * @brief The working precision of the dense kernels in bits. It is the precision of float1000, unless the
+     * @code MMQLC_DENSE_DIGITS @endcode environment variable asks for fewer (or more) decimal digits; large systems
+     * are much faster at a hundred digits than at a thousand.
+     */
+    inline mpfr_prec_t working_bits() {
+        static const mpfr_prec_t bits{
+            [] {
+                if (const char *requested{std::getenv("MMQLC_DENSE_DIGITS")}; requested != nullptr) {
+                    try {
+                        const unsigned long digits{std::max<unsigned long>(1, std::stoul(requested))};
+                        return static_cast<mpfr_prec_t>(std::ceil(digits * 3.3219280948873623)) + 16; // guard bits
+                    } catch (...) {
+                        // malformed value, fall through to the precision of float1000.
+                    }
+                }
+                return precision::float1000_bits;
+            }()
+        };
+        return bits;
+    }
+
+    /**
+     * @brief A dense matrix of MPFR numbers of one precision. The significands of all the elements live in one
+     * contiguous buffer (MPFR custom interface), rather than in one heap block per element, so a tile is a few
+     * contiguous runs of memory and building or copying a matrix is a single allocation.
+     */
+    class DenseMatrix {
+        std::size_t row_count{0};
+        std::size_t col_count{0};
+        mpfr_prec_t precision_bits{0};
+        std::size_t limbs_per_element{0};
+        std::vector<mp_limb_t> limbs;
+        std::vector<__mpfr_struct> cells;
+
+        void allocate() {
+            limbs_per_element = (mpfr_custom_get_size(precision_bits) + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t);
+            limbs.assign(row_count * col_count * limbs_per_element, 0);
+            cells.resize(row_count * col_count);
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                mpfr_custom_init_set(&cells[i], MPFR_ZERO_KIND, 0, precision_bits, &limbs[i * limbs_per_element]);
+        }
+
+    public:
+        DenseMatrix(const std::size_t rows, const std::size_t cols, const mpfr_prec_t bits = working_bits())
+            : row_count(rows), col_count(cols), precision_bits(bits) {
+            allocate();
+        }
+
+        DenseMatrix(const DenseMatrix &other)
+            : row_count(other.row_count), col_count(other.col_count), precision_bits(other.precision_bits) {
+            allocate();
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                mpfr_set(&cells[i], &other.cells[i], MPFR_RNDN);
+        }
+
+        DenseMatrix &operator=(const DenseMatrix &other) {
+            if (this != &other)
+                *this = DenseMatrix(other);
+            return *this;
+        }
+
+        // moving the vectors keeps their buffers, so the significand pointers of the cells stay valid.
+        DenseMatrix(DenseMatrix &&) noexcept = default;
+        DenseMatrix &operator=(DenseMatrix &&) noexcept = default;
+
+        [[nodiscard]] std::size_t rows() const { return row_count; }
+        [[nodiscard]] std::size_t cols() const { return col_count; }
+        [[nodiscard]] mpfr_prec_t bits() const { return precision_bits; }
+
+        mpfr_ptr operator()(const std::size_t row, const std::size_t col) { return &cells[row * col_count + col]; }
+        mpfr_srcptr operator()(const std::size_t row, const std::size_t col) const {
+            return &cells[row * col_count + col];
+        }
+
+        /**
+         * @brief Swaps two rows in O(cols), only the MPFR headers move, the significands stay in place.
+         */
+        void swap_rows(const std::size_t first, const std::size_t second) {
+            std::swap_ranges(cells.begin() + first * col_count, cells.begin() + (first + 1) * col_count,
+                             cells.begin() + second * col_count);
+        }
+
+        static DenseMatrix identity(const std::size_t n, const mpfr_prec_t bits = working_bits()) {
+            DenseMatrix matrix(n, n, bits);
+            for (std::size_t i = 0; i < n; ++i)
+                mpfr_set_ui(matrix(i, i), 1, MPFR_RNDN);
+            return matrix;
+        }
+
+        static DenseMatrix from(const linalg::DynamicMatrix<float1000> &matrix, const mpfr_prec_t bits = working_bits()) {
+            DenseMatrix dense(matrix.rows, matrix.cols, bits);
+            for (std::size_t i = 0; i < dense.cells.size(); ++i)
+                mpfr_set(&dense.cells[i], matrix.elements[i].backend().data(), MPFR_RNDN);
+            return dense;
+        }
+
+        [[nodiscard]] linalg::DynamicMatrix<float1000> to_dynamic(const bool vector = false) const {
+            linalg::DynamicMatrix<float1000> matrix{row_count, col_count, std::vector<float1000>(cells.size()), vector};
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                mpfr_set(matrix.elements[i].backend().data(), &cells[i], MPFR_RNDN);
+            return matrix;
+        }
+    };
+
+    /**
+     * @brief The MPFR temporaries of one worker thread, allocated once per kernel call.
+     */
+    struct Workspace {
+        precision::Register product;
+
+        explicit Workspace(const mpfr_prec_t bits) : product(bits) {}
+    };
+
+    inline std::vector<Workspace> make_workspaces(const mpfr_prec_t bits) {
+        std::vector<Workspace> workspaces;
+        workspaces.reserve(parallel::worker_count());
+        for (std::size_t w = 0; w < parallel::worker_count(); ++w)
+            workspaces.emplace_back(bits);
+        return workspaces;
+    }
+
+    inline std::size_t blocks(const std::size_t n) { return (n + block_size - 1) / block_size; }
+
+    /**
+     * @brief target(i, j) -= left(i, k) * right(k, j) summed over k in [k_begin, k_end), for the tile
+     * [i_begin, i_end) x [j_begin, j_end). The loops run i, k, j so that @p right and @p target are read along rows.
+     */
+    inline void subtract_product(DenseMatrix &target, const DenseMatrix &left, const DenseMatrix &right,
+                                 const std::size_t i_begin, const std::size_t i_end,
+                                 const std::size_t j_begin, const std::size_t j_end,
+                                 const std::size_t k_begin, const std::size_t k_end, Workspace &workspace) {
+        for (std::size_t i = i_begin; i < i_end; ++i)
+            for (std::size_t k = k_begin; k < k_end; ++k) {
+                const mpfr_srcptr factor{left(i, k)};
+                if (mpfr_zero_p(factor))
+                    continue;
+                for (std::size_t j = j_begin; j < j_end; ++j) {
+                    mpfr_mul(workspace.product.get(), factor, right(k, j), MPFR_RNDN);
+                    mpfr_sub(target(i, j), target(i, j), workspace.product.get(), MPFR_RNDN);
+                }
+            }
+    }
+
+    /**
+     * @brief Blocked matrix product. Every tile of the result is owned by one worker and accumulated in a fixed
+     * order, so the result does not depend on the number of threads. The tile is accumulated as -sum by
+     * @code subtract_product @endcode and negated at the end, negation being exact.
+     */
+    inline DenseMatrix multiply(const DenseMatrix &left, const DenseMatrix &right) {
+        if (left.cols() != right.rows())
+            throw std::runtime_error("Matrix dimensions do not agree !");
+        DenseMatrix product(left.rows(), right.cols(), left.bits());
+        auto workspaces{make_workspaces(left.bits())};
+        const std::size_t col_blocks{blocks(right.cols())};
+        parallel::parallel_for(blocks(left.rows()) * col_blocks, [&](const std::size_t tile, const std::size_t worker) {
+            const std::size_t i_begin{tile / col_blocks * block_size};
+            const std::size_t j_begin{tile % col_blocks * block_size};
+            const std::size_t i_end{std::min(left.rows(), i_begin + block_size)};
+            const std::size_t j_end{std::min(right.cols(), j_begin + block_size)};
+            for (std::size_t k = 0; k < left.cols(); k += block_size)
+                subtract_product(product, left, right, i_begin, i_end, j_begin, j_end,
+                                 k, std::min(left.cols(), k + block_size), workspaces[worker]);
+            for (std::size_t i = i_begin; i < i_end; ++i)
+                for (std::size_t j = j_begin; j < j_end; ++j)
+                    mpfr_neg(product(i, j), product(i, j), MPFR_RNDN);
+        });
+        return product;
+    }
+
+    /**
+     * @brief The factors of P*A = L*U, stored in one matrix: L below the diagonal (its unit diagonal is implied) and
+     * U on and above it.
+     */
+    struct LUDecomposition {
+        DenseMatrix factors;
+        std::vector<std::size_t> permutation; // row i of P*A is row permutation[i] of A
+        int sign{1}; // the sign of the permutation, 0 when the matrix is singular
+    };
+
+    /**
+     * @brief Right looking blocked LU factorization with partial pivoting. A panel of @code block_size @endcode
+     * columns is factored first, its rows of U are then solved for, and the trailing matrix is updated tile by tile
+     * across the worker threads, which is where almost all the work is.
+     */
+    inline LUDecomposition lu_decompose(DenseMatrix matrix) {
+        if (matrix.rows() != matrix.cols())
+            throw std::runtime_error("LU factorization is only defined for square matrices !");
+        const std::size_t n{matrix.rows()};
+        LUDecomposition lu{std::move(matrix), std::vector<std::size_t>(n), 1};
+        std::iota(lu.permutation.begin(), lu.permutation.end(), 0);
+        DenseMatrix &a{lu.factors};
+        auto workspaces{make_workspaces(a.bits())};
+        for (std::size_t k_begin = 0; k_begin < n; k_begin += block_size) {
+            const std::size_t k_end{std::min(n, k_begin + block_size)};
+            // panel: columns [k_begin, k_end) of rows [k_begin, n)
+            for (std::size_t j = k_begin; j < k_end; ++j) {
+                std::size_t pivot{j};
+                for (std::size_t i = j + 1; i < n; ++i)
+                    if (mpfr_cmpabs(a(i, j), a(pivot, j)) > 0)
+                        pivot = i;
+                if (mpfr_zero_p(a(pivot, j))) {
+                    lu.sign = 0;
+                    return lu;
+                }
+                if (pivot != j) {
+                    a.swap_rows(j, pivot);
+                    std::swap(lu.permutation[j], lu.permutation[pivot]);
+                    lu.sign = -lu.sign;
+                }
+                parallel::parallel_for(blocks(n - j - 1), [&](const std::size_t chunk, const std::size_t worker) {
+                    const std::size_t i_begin{j + 1 + chunk * block_size};
+                    const std::size_t i_end{std::min(n, i_begin + block_size)};
+                    for (std::size_t i = i_begin; i < i_end; ++i)
+                        mpfr_div(a(i, j), a(i, j), a(j, j), MPFR_RNDN);
+                    subtract_product(a, a, a, i_begin, i_end, j + 1, k_end, j, j + 1, workspaces[worker]);
+                });
+            }
+            // rows [k_begin, k_end) of U right of the panel: forward substitution with the unit lower panel.
+            parallel::parallel_for(blocks(n - k_end), [&](const std::size_t chunk, const std::size_t worker) {
+                const std::size_t j_begin{k_end + chunk * block_size};
+                const std::size_t j_end{std::min(n, j_begin + block_size)};
+                for (std::size_t i = k_begin + 1; i < k_end; ++i)
+                    subtract_product(a, a, a, i, i + 1, j_begin, j_end, k_begin, i, workspaces[worker]);
+            });
+            // trailing matrix: A22 -= L21 * U12
+            const std::size_t trailing_blocks{blocks(n - k_end)};
+            parallel::parallel_for(trailing_blocks * trailing_blocks, [&](const std::size_t tile, const std::size_t worker) {
+                const std::size_t i_begin{k_end + tile / trailing_blocks * block_size};
+                const std::size_t j_begin{k_end + tile % trailing_blocks * block_size};
+                subtract_product(a, a, a, i_begin, std::min(n, i_begin + block_size),
+                                 j_begin, std::min(n, j_begin + block_size), k_begin, k_end, workspaces[worker]);
+            });
+        }
+        return lu;
+    }
+
+    inline float1000 determinant(const DenseMatrix &matrix) {
+        const LUDecomposition lu{lu_decompose(matrix)};
+        float1000 result{0};
+        if (lu.sign == 0)
+            return result;
+        precision::Register product{lu.factors.bits()};
+        mpfr_set_si(product.get(), lu.sign, MPFR_RNDN);
+        for (std::size_t i = 0; i < lu.factors.rows(); ++i)
+            mpfr_mul(product.get(), product.get(), lu.factors(i, i), MPFR_RNDN);
+        return product.to_float1000();
+    }
+
+    /**
+     * @brief Solves matrix * x = rhs. The columns of the right hand side are independent, so the substitutions are
+     * spread across the workers by blocks of columns.
+     */
+    inline DenseMatrix solve(const DenseMatrix &matrix, const DenseMatrix &rhs) {
+        if (matrix.rows() != rhs.rows())
+            throw std::runtime_error("Matrix dimensions do not agree !");
+        const LUDecomposition lu{lu_decompose(matrix)};
+        if (lu.sign == 0)
+            throw std::runtime_error("Matrix is singular !");
+        const DenseMatrix &a{lu.factors};
+        const std::size_t n{a.rows()};
+        DenseMatrix x(n, rhs.cols(), a.bits());
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < rhs.cols(); ++j)
+                mpfr_set(x(i, j), rhs(lu.permutation[i], j), MPFR_RNDN);
+        auto workspaces{make_workspaces(a.bits())};
+        parallel::parallel_for(blocks(rhs.cols()), [&](const std::size_t chunk, const std::size_t worker) {
+            const std::size_t j_begin{chunk * block_size};
+            const std::size_t j_end{std::min(rhs.cols(), j_begin + block_size)};
+            for (std::size_t i = 1; i < n; ++i) // L y = P b
+                subtract_product(x, a, x, i, i + 1, j_begin, j_end, 0, i, workspaces[worker]);
+            for (std::size_t i = n; i-- > 0;) { // U x = y
+                subtract_product(x, a, x, i, i + 1, j_begin, j_end, i + 1, n, workspaces[worker]);
+                for (std::size_t j = j_begin; j < j_end; ++j)
+                    mpfr_div(x(i, j), x(i, j), a(i, i), MPFR_RNDN);
+            }
+        });
+        return x;
+    }
+
+    inline DenseMatrix inverse(const DenseMatrix &matrix) {
+        return solve(matrix, DenseMatrix::identity(matrix.rows(), matrix.bits()));
+    }
+
+    inline linalg::DynamicMatrix<float1000> transpose(const linalg::DynamicMatrix<float1000> &matrix) {
+        linalg::DynamicMatrix<float1000> result{matrix.cols, matrix.rows, std::vector<float1000>(matrix.elements.size())};
+        for (std::size_t i = 0; i < matrix.rows; ++i)
+            for (std::size_t j = 0; j < matrix.cols; ++j)
+                result(j, i) = matrix(i, j);
+        return result;
+    }
+} // namespace mmqli::core::dense
+#endif // DENSE_HPP
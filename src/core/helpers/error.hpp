@@ -0,0 +1,84 @@
+#ifndef ERROR_HPP
+#define ERROR_HPP
+
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief This namespace contains the error channel of the pipeline. The lexer, the parser and the core report a query
+ * that cannot be answered as a value holding what went wrong and where, instead of throwing: a bad query yields an
+ * error for its own index only, and the queries around it are still answered.
+ */
+namespace mmqli::core::error {
+    enum class Code : unsigned char {
+        syntax, // the query matches no rule of the grammar, or its keyword is not defined for its operands
+        undefined_variable,
+        invalid_number,
+        invalid_literal, // a malformed list, range, matrix or point set
+        unreadable_file,
+        division_by_zero,
+        domain, // the operands are outside the domain of the query
+        evaluation, // reported by a kernel while evaluating, e.g. a singular matrix
+        plugin, // a plugin that cannot be loaded
+        unwritable_file,
+        cancelled, // interrupted, or past its timeout
+        memory_limit // estimated to need more memory than the limit allows
+    };
+
+    /**
+     * @brief Where an error comes from: the index of the query in its input, and the 1-based column in the text of
+     * the query, 0 when the column is not known (errors found by the core, after the text is gone).
+     */
+    struct Position {
+        std::size_t query{0};
+        std::size_t column{0};
+    };
+
+    struct Error {
+        Code code{Code::syntax};
+        Position where{};
+        std::string message;
+    };
+
+    template<typename T>
+    using Result = std::expected<T, Error>;
+
+    inline std::unexpected<Error> fail(const Code code, std::string message, const Position where = {}) {
+        return std::unexpected<Error>{Error{code, where, std::move(message)}};
+    }
+
+    inline std::string_view name(const Code code) {
+        switch (code) {
+            case Code::syntax: return "syntax";
+            case Code::undefined_variable: return "undefined_variable";
+            case Code::invalid_number: return "invalid_number";
+            case Code::invalid_literal: return "invalid_literal";
+            case Code::unreadable_file: return "unreadable_file";
+            case Code::division_by_zero: return "division_by_zero";
+            case Code::domain: return "domain";
+            case Code::evaluation: return "evaluation";
+            case Code::plugin: return "plugin";
+            case Code::unwritable_file: return "unwritable_file";
+            case Code::cancelled: return "cancelled";
+            case Code::memory_limit: return "memory_limit";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief The error as one line, in the form @code code at column c: message @endcode, the column is left out
+     * when it is not known.
+     */
+    inline std::string describe(const Error &error) {
+        std::string line{name(error.code)};
+        if (error.where.column != 0)
+            line += " at column " + std::to_string(error.where.column);
+        line += ": ";
+        line += error.message;
+        return line;
+    }
+} // namespace mmqli::core::error
+#endif // ERROR_HPP
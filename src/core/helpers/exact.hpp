@@ -0,0 +1,245 @@
+#ifndef EXACT_HPP
+#define EXACT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <gmpxx.h>
+#include "boost_fwd.hpp"
+#include "radix.hpp"
+
+/**
+ * @brief This namespace contains the exact arithmetic of the queries written with integer and rational literals, such
+ * as @code ADD 12345678901234567890,1 @endcode or @code ADD 1/3,1/6 @endcode. Their operands are read into GMP
+ * rationals, and the queries that have an exact answer are answered with GMP's integer and rational kernels: the
+ * four operations, MODULO, POWER by an integer, FACTORIAL, PERMUTATION, COMBINATION, ABSOLUTE, FLOOR and CEILING.
+ * FACTORIAL and COMBINATION are products of integers, not a gamma function rounded back to an integer.
+ *
+ * A query without an exact answer is promoted: its operands are rounded to float1000 and it is evaluated like any real
+ * query. The rational answer of a query written with integers only, DIVIDE 1,3, is promoted as well, a fraction is
+ * only answered to the queries that were written with one.
+ */
+namespace mmqli::core::exact {
+    /**
+     * @brief The largest exact answer of POWER, FACTORIAL and PERMUTATION, about 315000 digits. Larger answers are
+     * promoted, they are rounded to float1000 instead.
+     */
+    constexpr double largest_bits{1 << 20};
+
+    /**
+     * @brief Whether @p literal is an integer or a rational literal, @code -?\d+(/\d+)? @endcode.
+     */
+    inline bool literal(const std::string_view literal) {
+        const std::size_t digits{literal.starts_with('-') ? 1u : 0u};
+        const std::size_t slash{literal.find('/')};
+        const auto all_digits{
+            [](const std::string_view part) {
+                return !part.empty() && part.find_first_not_of("0123456789") == std::string_view::npos;
+            }
+        };
+        if (slash == std::string_view::npos)
+            return all_digits(literal.substr(digits));
+        return all_digits(literal.substr(digits, slash - digits)) && all_digits(literal.substr(slash + 1));
+    }
+
+    /**
+     * @brief The value of an integer or rational literal in lowest terms, 0 for an empty operand, nothing when the
+     * denominator is 0.
+     */
+    inline std::optional<mpq_class> parse(const std::string_view literal) {
+        if (literal.empty())
+            return mpq_class{0};
+        const std::size_t sign{literal.starts_with('-') ? 1u : 0u};
+        const std::size_t slash{literal.find('/')};
+        mpq_class value;
+        value.get_num() = radix::integer(literal.substr(sign, slash - sign));
+        if (sign == 1)
+            value.get_num() = -value.get_num();
+        if (slash != std::string_view::npos)
+            value.get_den() = radix::integer(literal.substr(slash + 1));
+        if (value.get_den() == 0)
+            return std::nullopt;
+        value.canonicalize();
+        return value;
+    }
+
+    /**
+     * @brief The value of a decimal literal, @code -?\d+(\.\d+)?([Ee][+-]\d+)? @endcode, as a rational in lowest
+     * terms: 0.1 is 1/10. Nothing when @p literal is not one, or when its power of ten has more than about
+     * largest_bits bits.
+     */
+    inline std::optional<mpq_class> decimal(const std::string_view literal) {
+        const std::size_t length{radix::real_length(literal)};
+        if (length == 0 || length != literal.size())
+            return std::nullopt;
+        const std::size_t sign{literal.starts_with('-') ? 1u : 0u};
+        const std::size_t marker{literal.find_first_of("Ee")};
+        const std::string_view significand{literal.substr(sign, marker - sign)};
+        const std::size_t point{significand.find('.')};
+        long exponent{0};
+        if (marker != std::string_view::npos) {
+            const std::string_view power{literal.substr(marker + 2)};
+            if (power.find('.') != std::string_view::npos || power.size() > 9)
+                return std::nullopt; // a fractional power of ten is not a rational
+            exponent = std::stol(std::string{power});
+            if (literal[marker + 1] == '-')
+                exponent = -exponent;
+        }
+        std::string digits{significand.substr(0, point)};
+        if (point != std::string_view::npos) {
+            digits.append(significand.substr(point + 1));
+            exponent -= static_cast<long>(significand.size() - point - 1);
+        }
+        if (static_cast<double>(std::abs(exponent)) * 3.321928094887362 > largest_bits)
+            return std::nullopt;
+        mpq_class value{radix::integer(digits)};
+        mpz_class scale;
+        mpz_ui_pow_ui(scale.get_mpz_t(), 10, static_cast<unsigned long>(std::abs(exponent)));
+        if (exponent < 0)
+            value /= scale;
+        else
+            value *= scale;
+        if (sign == 1)
+            value = -value;
+        return value;
+    }
+
+    /**
+     * @brief Whether @p query has an exact kernel.
+     */
+    inline bool handles(const std::string_view query) {
+        return query == "ADD" || query == "SUBTRACT" || query == "MULTIPLY" || query == "DIVIDE" ||
+               query == "MODULO" || query == "POWER" || query == "FACTORIAL" || query == "PERMUTATION" ||
+               query == "COMBINATION" || query == "ABSOLUTE" || query == "FLOOR" || query == "CEILING";
+    }
+
+    inline bool single_operand(const std::string_view query) {
+        return query == "FACTORIAL" || query == "ABSOLUTE" || query == "FLOOR" || query == "CEILING";
+    }
+
+    inline bool integer(const mpq_class &value) {
+        return value.get_den() == 1;
+    }
+
+    /**
+     * @brief @p value rounded to float1000.
+     */
+    inline float1000 promote(const mpq_class &value) {
+        float1000 rounded;
+        mpfr_set_q(rounded.backend().data(), value.get_mpq_t(), MPFR_RNDN);
+        return rounded;
+    }
+
+    /**
+     * @brief The digits of @p value, p/q for a fraction, written straight into the answer.
+     */
+    inline std::string to_str(const mpq_class &value) {
+        std::string text;
+        text.reserve(mpz_sizeinbase(value.get_num_mpz_t(), 10) + mpz_sizeinbase(value.get_den_mpz_t(), 10) + 2);
+        const auto append{[&text](const std::string_view digits) { text.append(digits); }};
+        radix::write(value.get_num_mpz_t(), append);
+        if (!integer(value)) {
+            text += '/';
+            radix::write(value.get_den_mpz_t(), append);
+        }
+        return text;
+    }
+
+    namespace detail {
+        // n as an unsigned long, when it is a nonnegative integer that fits one.
+        inline std::optional<unsigned long> natural(const mpq_class &n) {
+            if (!integer(n) || sgn(n) < 0 || !n.get_num().fits_ulong_p())
+                return std::nullopt;
+            return n.get_num().get_ui();
+        }
+
+        // log2(n! / (n - r)!), estimated from the logarithm of gamma.
+        inline double falling_factorial_bits(const unsigned long n, const unsigned long r) {
+            const auto log_factorial{[](const unsigned long m) { return std::lgamma(static_cast<double>(m) + 1); }};
+            return (log_factorial(n) - log_factorial(n - r)) / std::log(2.0);
+        }
+
+        inline std::optional<mpq_class> power(const mpq_class &a, const mpq_class &b) {
+            if (!integer(b) || !b.get_num().fits_slong_p())
+                return std::nullopt;
+            const long n{b.get_num().get_si()};
+            if (sgn(a) == 0)
+                return n < 0 ? std::nullopt : std::optional<mpq_class>{n == 0 ? 1 : 0};
+            const unsigned long magnitude{n < 0 ? 0ul - static_cast<unsigned long>(n) : static_cast<unsigned long>(n)};
+            const double bits{
+                static_cast<double>(std::max(mpz_sizeinbase(a.get_num_mpz_t(), 2), mpz_sizeinbase(a.get_den_mpz_t(), 2)))
+            };
+            if (bits > 1 && (bits - 1) * static_cast<double>(magnitude) > largest_bits)
+                return std::nullopt;
+            mpq_class r;
+            mpz_pow_ui(r.get_num_mpz_t(), a.get_num_mpz_t(), magnitude);
+            mpz_pow_ui(r.get_den_mpz_t(), a.get_den_mpz_t(), magnitude);
+            if (n < 0)
+                mpq_inv(r.get_mpq_t(), r.get_mpq_t()); // keeps the sign on the numerator
+            return r;
+        }
+
+        // r = a - trunc(a / b) b, the remainder has the sign of a like fmod.
+        inline std::optional<mpq_class> modulo(const mpq_class &a, const mpq_class &b) {
+            if (sgn(b) == 0)
+                return std::nullopt;
+            const mpq_class quotient{a / b};
+            mpz_class truncated;
+            mpz_tdiv_q(truncated.get_mpz_t(), quotient.get_num_mpz_t(), quotient.get_den_mpz_t());
+            return mpq_class{a - mpq_class{truncated} * b};
+        }
+
+        inline std::optional<mpq_class> choose(const bool ordered, const mpq_class &a, const mpq_class &b) {
+            const auto n{natural(a)};
+            const auto r{natural(b)};
+            if (!n || !r || *r > *n)
+                return std::nullopt;
+            if (ordered && falling_factorial_bits(*n, *r) > largest_bits)
+                return std::nullopt;
+            mpz_class result;
+            mpz_bin_uiui(result.get_mpz_t(), *n, *r);
+            if (ordered) { // n! / (n - r)! = C(n, r) r!
+                mpz_class r_factorial;
+                mpz_fac_ui(r_factorial.get_mpz_t(), *r);
+                result *= r_factorial;
+            }
+            return mpq_class{result};
+        }
+    } // namespace detail
+
+    /**
+     * @brief The exact answer of @p query, nothing when it has none: a division by zero, an operand outside the
+     * integers for FACTORIAL, PERMUTATION and COMBINATION, a fractional exponent, or an answer above @ref largest_bits.
+     */
+    inline std::optional<mpq_class> evaluate(const std::string_view query, const mpq_class &a, const mpq_class &b) {
+        if (query == "ADD") return mpq_class{a + b};
+        if (query == "SUBTRACT") return mpq_class{a - b};
+        if (query == "MULTIPLY") return mpq_class{a * b};
+        if (query == "DIVIDE") return sgn(b) == 0 ? std::nullopt : std::optional<mpq_class>{a / b};
+        if (query == "MODULO") return detail::modulo(a, b);
+        if (query == "POWER") return detail::power(a, b);
+        if (query == "ABSOLUTE") return mpq_class{abs(a)};
+        if (query == "FLOOR" || query == "CEILING") {
+            mpz_class rounded;
+            if (query == "FLOOR")
+                mpz_fdiv_q(rounded.get_mpz_t(), a.get_num_mpz_t(), a.get_den_mpz_t());
+            else
+                mpz_cdiv_q(rounded.get_mpz_t(), a.get_num_mpz_t(), a.get_den_mpz_t());
+            return mpq_class{rounded};
+        }
+        if (query == "FACTORIAL") {
+            const auto n{detail::natural(a)};
+            if (!n || detail::falling_factorial_bits(*n, *n) > largest_bits)
+                return std::nullopt;
+            mpz_class factorial;
+            mpz_fac_ui(factorial.get_mpz_t(), *n);
+            return mpq_class{factorial};
+        }
+        if (query == "PERMUTATION") return detail::choose(true, a, b);
+        if (query == "COMBINATION") return detail::choose(false, a, b);
+        return std::nullopt;
+    }
+} // namespace mmqli::core::exact
+#endif // EXACT_HPP
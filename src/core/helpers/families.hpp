@@ -0,0 +1,164 @@
+#ifndef FAMILIES_HPP
+#define FAMILIES_HPP
+
+#include <vector>
+#include "boost_fwd.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the kernels of the fused queries, which answer a whole family of functions of one
+ * operand at once. The family shares a single transcendental core and the rest of it is derived by a few
+ * arithmetic operations: TRIG_ALL takes one sin_cos, HYP_ALL one expm1, LOG_ALL one log divided by the cached ln 2
+ * and ln 10. The separate queries each evaluate a transcendental function of their own, and the reciprocal ones
+ * divide one more time.
+ *
+ * The family is derived in registers a few guard bits wider than float1000 and every member is rounded to float1000
+ * once, so the operations that derive it cost no digits.
+ */
+namespace mmqli::core::families {
+    /**
+     * @brief The bits added to the precision of float1000 while a family is derived from its core.
+     */
+    constexpr mpfr_prec_t guard_bits{32};
+
+    namespace detail {
+        // the members of a family, rounded from their registers, in order.
+        template<std::size_t N>
+        std::vector<float1000> rounded(const precision::Register (&members)[N]) {
+            std::vector<float1000> family(N);
+            for (std::size_t i = 0; i < N; ++i)
+                mpfr_set(family[i].backend().data(), members[i].get(), MPFR_RNDN);
+            return family;
+        }
+
+        // ln 10 at the working precision of the families, computed on first use and then shared.
+        inline mpfr_srcptr log_ten() {
+            static const precision::Register ten{
+                [] {
+                    precision::Register log{precision::float1000_bits + guard_bits};
+                    mpfr_log_ui(log.get(), 10, MPFR_RNDN);
+                    return log;
+                }()
+            };
+            return ten.get();
+        }
+    } // namespace detail
+
+    /**
+     * @brief sin, cos, tan, sec, csc and cot of the angle @p degrees, in this order. The zeros of the sine and the
+     * cosine are found exactly from the degrees, the members that divide by them are infinite there.
+     */
+    inline std::vector<float1000> circular(const float1000 &degrees) {
+        constexpr mpfr_prec_t bits{precision::float1000_bits + guard_bits};
+        mpfr_srcptr x{degrees.backend().data()};
+        precision::Register members[6]{
+            precision::Register{bits}, precision::Register{bits}, precision::Register{bits},
+            precision::Register{bits}, precision::Register{bits}, precision::Register{bits}
+        };
+        auto &[sine, cosine, tangent, secant, cosecant, cotangent] = members;
+        precision::Register residue{precision::float1000_bits};
+        mpfr_fmod_ui(residue.get(), x, 180, MPFR_RNDN);
+        mpfr_abs(residue.get(), residue.get(), MPFR_RNDN);
+        // the angle in radians goes through cosecant, which is overwritten last.
+        mpfr_const_pi(cosecant.get(), MPFR_RNDN);
+        mpfr_mul(cosecant.get(), cosecant.get(), x, MPFR_RNDN);
+        mpfr_div_ui(cosecant.get(), cosecant.get(), 180, MPFR_RNDN);
+        mpfr_sin_cos(sine.get(), cosine.get(), cosecant.get(), MPFR_RNDN);
+        if (mpfr_zero_p(residue.get()))
+            mpfr_set_zero(sine.get(), 1);
+        else if (mpfr_cmp_ui(residue.get(), 90) == 0)
+            mpfr_set_zero(cosine.get(), 1);
+        if (mpfr_zero_p(sine.get())) {
+            mpfr_set_zero(tangent.get(), 1);
+            mpfr_ui_div(secant.get(), 1, cosine.get(), MPFR_RNDN);
+            mpfr_set_inf(cosecant.get(), 1);
+            mpfr_set_inf(cotangent.get(), 1);
+        } else if (mpfr_zero_p(cosine.get())) {
+            mpfr_set_inf(tangent.get(), 1);
+            mpfr_set_inf(secant.get(), 1);
+            mpfr_ui_div(cosecant.get(), 1, sine.get(), MPFR_RNDN);
+            mpfr_set_zero(cotangent.get(), 1);
+        } else {
+            mpfr_div(tangent.get(), sine.get(), cosine.get(), MPFR_RNDN);
+            mpfr_ui_div(secant.get(), 1, cosine.get(), MPFR_RNDN);
+            mpfr_ui_div(cosecant.get(), 1, sine.get(), MPFR_RNDN);
+            mpfr_div(cotangent.get(), cosine.get(), sine.get(), MPFR_RNDN);
+        }
+        return detail::rounded(members);
+    }
+
+    /**
+     * @brief sinh, cosh, tanh, sech, csch and coth of @p x, in this order, from m = e^|x| - 1 alone: sinh |x| is
+     * (m + m / (m + 1)) / 2 and cosh x is (m + 1 + 1 / (m + 1)) / 2. Neither subtracts, so a small |x| loses no
+     * digits to cancellation, the odd members take the sign of @p x last.
+     */
+    inline std::vector<float1000> hyperbolic(const float1000 &x) {
+        constexpr mpfr_prec_t bits{precision::float1000_bits + guard_bits};
+        precision::Register members[6]{
+            precision::Register{bits}, precision::Register{bits}, precision::Register{bits},
+            precision::Register{bits}, precision::Register{bits}, precision::Register{bits}
+        };
+        auto &[sine, cosine, tangent, secant, cosecant, cotangent] = members;
+        // m and e^|x| are kept in cotangent and secant until their members are derived.
+        mpfr_ptr m{cotangent.get()};
+        mpfr_ptr e{secant.get()};
+        mpfr_abs(m, x.backend().data(), MPFR_RNDN);
+        mpfr_expm1(m, m, MPFR_RNDN);
+        mpfr_add_ui(e, m, 1, MPFR_RNDN);
+        if (mpfr_inf_p(e)) {
+            // e^|x| overflows, tanh is 1 to every digit long before.
+            mpfr_set_inf(sine.get(), 1);
+            mpfr_set_inf(cosine.get(), 1);
+            mpfr_set_ui(tangent.get(), 1, MPFR_RNDN);
+        } else {
+            mpfr_div(sine.get(), m, e, MPFR_RNDN);
+            mpfr_add(sine.get(), sine.get(), m, MPFR_RNDN);
+            mpfr_div_2ui(sine.get(), sine.get(), 1, MPFR_RNDN);
+            mpfr_ui_div(cosine.get(), 1, e, MPFR_RNDN);
+            mpfr_add(cosine.get(), cosine.get(), e, MPFR_RNDN);
+            mpfr_div_2ui(cosine.get(), cosine.get(), 1, MPFR_RNDN);
+            mpfr_div(tangent.get(), sine.get(), cosine.get(), MPFR_RNDN);
+        }
+        mpfr_ui_div(secant.get(), 1, cosine.get(), MPFR_RNDN);
+        mpfr_ui_div(cosecant.get(), 1, sine.get(), MPFR_RNDN);
+        mpfr_ui_div(cotangent.get(), 1, tangent.get(), MPFR_RNDN);
+        if (mpfr_signbit(x.backend().data()))
+            for (auto *odd: {&sine, &tangent, &cosecant, &cotangent})
+                mpfr_neg(odd->get(), odd->get(), MPFR_RNDN);
+        return detail::rounded(members);
+    }
+
+    /**
+     * @brief ln, log2 and log10 of @p x > 0, in this order, the last two are ln x divided by ln 2 and ln 10.
+     */
+    inline std::vector<float1000> logarithms(const float1000 &x) {
+        constexpr mpfr_prec_t bits{precision::float1000_bits + guard_bits};
+        precision::Register members[3]{precision::Register{bits}, precision::Register{bits}, precision::Register{bits}};
+        auto &[natural, binary, common] = members;
+        mpfr_log(natural.get(), x.backend().data(), MPFR_RNDN);
+        mpfr_const_log2(binary.get(), MPFR_RNDN);
+        mpfr_div(binary.get(), natural.get(), binary.get(), MPFR_RNDN);
+        mpfr_div(common.get(), natural.get(), detail::log_ten(), MPFR_RNDN);
+        return detail::rounded(members);
+    }
+
+    /**
+     * @brief The modulus of @p z and its argument in degrees, in this order, from one copy of the parts of @p z.
+     * MODULUS and ARGUMENT copy them out of the std::complex each, and convert to degrees with a pi of double precision.
+     */
+    inline std::vector<float1000> polar(const complex1000 &z) {
+        constexpr mpfr_prec_t bits{precision::float1000_bits + guard_bits};
+        precision::Register members[2]{precision::Register{bits}, precision::Register{bits}};
+        auto &[modulus, argument] = members;
+        const float1000 real{z.real()}; // std::complex hands its parts out by value
+        const float1000 imaginary{z.imag()};
+        mpfr_hypot(modulus.get(), real.backend().data(), imaginary.backend().data(), MPFR_RNDN);
+        mpfr_atan2(argument.get(), imaginary.backend().data(), real.backend().data(), MPFR_RNDN);
+        precision::Register pi{bits};
+        mpfr_const_pi(pi.get(), MPFR_RNDN);
+        mpfr_mul_ui(argument.get(), argument.get(), 180, MPFR_RNDN);
+        mpfr_div(argument.get(), argument.get(), pi.get(), MPFR_RNDN);
+        return detail::rounded(members);
+    }
+} // namespace mmqli::core::families
+#endif // FAMILIES_HPP
@@ -0,0 +1,356 @@
+#ifndef GEOMETRY_HPP
+#define GEOMETRY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "batch.hpp"
+#include "linalg.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+#include "reductions.hpp"
+
+/**
+ * @brief This namespace contains the coordinate geometry of the plane over whole sets of points. A point set is
+ * either a matrix of two columns with one point per row, evaluated at the precision of float1000, or a @ref PointSet
+ * of doubles for the FAST_ queries. Both modes run over all the cores, the reductions (areas and collinearity) use
+ * the fixed reduction tree, so their results do not depend on the number of threads.
+ */
+namespace mmqli::core::geometry {
+    /**
+     * @brief The number of consecutive points of the double precision kernels handed to a worker at a time, large
+     * enough for the vectorized loops to run at full speed.
+     */
+    constexpr std::size_t points_per_task{4096};
+
+    /**
+     * @brief A set of points in double precision stored as a struct of arrays, the x and the y coordinates each in
+     * their own contiguous array, so the kernels stream through memory and the compiler vectorizes their loops.
+     */
+    struct PointSet {
+        std::vector<double> x;
+        std::vector<double> y;
+
+        [[nodiscard]] std::size_t size() const { return x.size(); }
+    };
+
+    /**
+     * @brief The number of results of a query over two point sets: the sets are paired point by point, or a set of
+     * a single point is paired with every point of the other one.
+     */
+    inline std::size_t paired_count(const std::size_t first, const std::size_t second) {
+        if (first == second || second == 1)
+            return first;
+        if (first == 1)
+            return second;
+        throw std::runtime_error("Point sets must have the same number of points, or a single point !");
+    }
+
+    /**
+     * @brief A read-only view of a point set written as a matrix of two columns, a vector of two elements is read as
+     * a single point. The matrix is stored row by row, so the coordinates of point i are the elements 2i and 2i+1.
+     */
+    class Points {
+        const float1000 *coordinates;
+        std::size_t count;
+
+    public:
+        explicit Points(const linalg::DynamicMatrix<float1000> &matrix)
+            : coordinates(matrix.elements.data()), count(matrix.elements.size() / 2) {
+            if (!(matrix.cols == 2 || (matrix.vector && matrix.rows == 2)))
+                throw std::runtime_error("Points must be written as rows of two coordinates !");
+        }
+
+        [[nodiscard]] std::size_t size() const { return count; }
+        [[nodiscard]] const float1000 &x(const std::size_t i) const { return coordinates[2 * i]; }
+        [[nodiscard]] const float1000 &y(const std::size_t i) const { return coordinates[2 * i + 1]; }
+    };
+
+    /**
+     * @brief Calls @p body(i, j, k) for every result i, where j and k are the indices of the paired points of
+     * @p first and @p second, spread across the worker threads.
+     */
+    template<typename Body>
+    void for_each_pair(const Points &first, const Points &second, Body &&body) {
+        const std::size_t count{paired_count(first.size(), second.size())};
+        batch::for_each_run(count, [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+                body(i, first.size() == 1 ? 0 : i, second.size() == 1 ? 0 : i);
+        });
+    }
+
+    inline std::vector<float1000> distances(const Points &first, const Points &second) {
+        std::vector<float1000> result(paired_count(first.size(), second.size()));
+        for_each_pair(first, second, [&](const std::size_t i, const std::size_t j, const std::size_t k) {
+            mpfr_hypot(result[i].backend().data(), float1000{second.x(k) - first.x(j)}.backend().data(),
+                       float1000{second.y(k) - first.y(j)}.backend().data(), MPFR_RNDN);
+        });
+        return result;
+    }
+
+    inline linalg::DynamicMatrix<float1000> midpoints(const Points &first, const Points &second) {
+        const std::size_t count{paired_count(first.size(), second.size())};
+        linalg::DynamicMatrix<float1000> result{count, 2, std::vector<float1000>(2 * count)};
+        for_each_pair(first, second, [&](const std::size_t i, const std::size_t j, const std::size_t k) {
+            result(i, 0) = (first.x(j) + second.x(k)) / 2;
+            result(i, 1) = (first.y(j) + second.y(k)) / 2;
+        });
+        return result;
+    }
+
+    /**
+     * @brief The slopes of the lines through the paired points, infinite for vertical lines.
+     */
+    inline std::vector<float1000> slopes(const Points &first, const Points &second) {
+        std::vector<float1000> result(paired_count(first.size(), second.size()));
+        for_each_pair(first, second, [&](const std::size_t i, const std::size_t j, const std::size_t k) {
+            result[i] = (second.y(k) - first.y(j)) / (second.x(k) - first.x(j));
+        });
+        return result;
+    }
+
+    /**
+     * @brief The area of a simple polygon by the shoelace formula. The vertices are translated to the first one
+     * before the cross products are taken, which keeps the terms small for polygons far from the origin and removes
+     * the two terms that close the polygon, since both involve the first vertex.
+     */
+    inline float1000 area(const Points &polygon) {
+        if (polygon.size() < 3)
+            return float1000{0};
+        const float1000 &x0{polygon.x(0)};
+        const float1000 &y0{polygon.y(0)};
+        float1000 twice{
+            reductions::tree_reduce<float1000>(polygon.size() - 1, [&](const std::size_t begin, const std::size_t end) {
+                float1000 sum{0};
+                float1000 u_x{polygon.x(begin) - x0}, u_y{polygon.y(begin) - y0};
+                for (std::size_t i = begin; i < end; ++i) {
+                    const float1000 v_x{polygon.x(i + 1) - x0}, v_y{polygon.y(i + 1) - y0};
+                    sum += u_x * v_y - v_x * u_y;
+                    u_x = v_x;
+                    u_y = v_y;
+                }
+                return sum;
+            }, [](float1000 &left, const float1000 &right) { left += right; })
+        };
+        return float1000{fabs(twice) / 2};
+    }
+
+    /**
+     * @brief The squared distance from the first point to the farthest point of a set, and the index of that point.
+     * Ties go to the lowest index, so the choice does not depend on the shape of the reduction.
+     */
+    template<typename T, typename Squared>
+    std::pair<T, std::size_t> farthest(const std::size_t count, Squared &&squared) {
+        return reductions::tree_reduce<std::pair<T, std::size_t>>(count, [&](const std::size_t begin,
+                                                                             const std::size_t end) {
+            std::pair<T, std::size_t> best{squared(begin), begin};
+            for (std::size_t i = begin + 1; i < end; ++i)
+                if (T candidate{squared(i)}; candidate > best.first)
+                    best = {std::move(candidate), i};
+            return best;
+        }, [](std::pair<T, std::size_t> &left, const std::pair<T, std::size_t> &right) {
+            if (right.first > left.first)
+                left = right;
+        });
+    }
+
+    /**
+     * @brief Whether all the points lie on one line. The line runs from the first point to the point farthest from it,
+     * and every point must be within a relative distance of a few units in the last place of that line, so that
+     * decimal coordinates which are not exact in binary still test as collinear.
+     */
+    inline bool collinear(const Points &points) {
+        const float1000 &x0{points.x(0)};
+        const float1000 &y0{points.y(0)};
+        const auto [length, far]{
+            farthest<float1000>(points.size(), [&](const std::size_t i) {
+                return float1000{(points.x(i) - x0) * (points.x(i) - x0) + (points.y(i) - y0) * (points.y(i) - y0)};
+            })
+        };
+        if (length == 0)
+            return true; // every point is the first point
+        const float1000 d_x{points.x(far) - x0}, d_y{points.y(far) - y0};
+        const float1000 deviation{
+            reductions::tree_reduce<float1000>(points.size(), [&](const std::size_t begin, const std::size_t end) {
+                float1000 largest{0};
+                for (std::size_t i = begin; i < end; ++i)
+                    largest = std::max(largest, float1000{fabs(d_x * (points.y(i) - y0) - d_y * (points.x(i) - x0))});
+                return largest;
+            }, [](float1000 &left, const float1000 &right) { left = std::max(left, right); })
+        };
+        return deviation <= length * ldexp(float1000{1}, 32 - static_cast<int>(precision::float1000_bits));
+    }
+
+    /**
+     * @brief Whether each point lies on the line through the two points of @p line.
+     */
+    inline std::vector<float1000> collinear(const Points &points, const Points &line) {
+        if (line.size() != 2)
+            throw std::runtime_error("A line must be given by two points !");
+        const float1000 d_x{line.x(1) - line.x(0)}, d_y{line.y(1) - line.y(0)};
+        const float1000 tolerance{ldexp(float1000{1}, 32 - static_cast<int>(precision::float1000_bits))};
+        std::vector<float1000> result(points.size());
+        batch::for_each_run(points.size(), [&](const std::size_t begin, const std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const float1000 u_x{points.x(i) - line.x(0)}, u_y{points.y(i) - line.y(0)};
+                const float1000 scale{std::max<float1000>(d_x * d_x + d_y * d_y, u_x * u_x + u_y * u_y)};
+                result[i] = fabs(d_x * u_y - d_y * u_x) <= scale * tolerance ? 1 : 0;
+            }
+        });
+        return result;
+    }
+
+    namespace fast {
+        /**
+         * @brief Relative tolerance of the collinearity tests in double precision.
+         */
+        constexpr double tolerance{64 * std::numeric_limits<double>::epsilon()};
+
+        /**
+         * @brief Calls @p body(begin, end) for consecutive blocks of @code points_per_task @endcode indices in
+         * [0, count), spread across the worker threads.
+         */
+        template<typename Body>
+        void for_each_block(const std::size_t count, Body &&body) {
+            parallel::parallel_for((count + points_per_task - 1) / points_per_task, [&](const std::size_t task) {
+                const std::size_t begin{task * points_per_task};
+                body(begin, std::min(count, begin + points_per_task));
+            });
+        }
+
+        /**
+         * @brief Calls @p kernel(i, ax, ay, bx, by) for every pair of points. The three pairings (point by point, and a
+         * single point on either side) each get their own loop with unit stride accesses, which the compiler
+         * vectorizes once @p kernel is inlined.
+         */
+        template<typename Kernel>
+        void zip(const PointSet &first, const PointSet &second, Kernel &&kernel) {
+            const std::size_t count{paired_count(first.size(), second.size())};
+            const double *ax{first.x.data()}, *ay{first.y.data()}, *bx{second.x.data()}, *by{second.y.data()};
+            for_each_block(count, [&](const std::size_t begin, const std::size_t end) {
+                if (first.size() == second.size()) {
+                    for (std::size_t i = begin; i < end; ++i)
+                        kernel(i, ax[i], ay[i], bx[i], by[i]);
+                } else if (second.size() == 1) {
+                    const double x{bx[0]}, y{by[0]};
+                    for (std::size_t i = begin; i < end; ++i)
+                        kernel(i, ax[i], ay[i], x, y);
+                } else {
+                    const double x{ax[0]}, y{ay[0]};
+                    for (std::size_t i = begin; i < end; ++i)
+                        kernel(i, x, y, bx[i], by[i]);
+                }
+            });
+        }
+
+        inline std::vector<double> distances(const PointSet &first, const PointSet &second) {
+            std::vector<double> result(paired_count(first.size(), second.size()));
+            double *out{result.data()};
+            zip(first, second, [out](const std::size_t i, const double ax, const double ay, const double bx,
+                                     const double by) {
+                const double dx{bx - ax}, dy{by - ay};
+                out[i] = std::sqrt(dx * dx + dy * dy);
+            });
+            return result;
+        }
+
+        inline PointSet midpoints(const PointSet &first, const PointSet &second) {
+            const std::size_t count{paired_count(first.size(), second.size())};
+            PointSet result{std::vector<double>(count), std::vector<double>(count)};
+            double *out_x{result.x.data()}, *out_y{result.y.data()};
+            zip(first, second, [out_x, out_y](const std::size_t i, const double ax, const double ay, const double bx,
+                                              const double by) {
+                out_x[i] = 0.5 * (ax + bx);
+                out_y[i] = 0.5 * (ay + by);
+            });
+            return result;
+        }
+
+        inline std::vector<double> slopes(const PointSet &first, const PointSet &second) {
+            std::vector<double> result(paired_count(first.size(), second.size()));
+            double *out{result.data()};
+            zip(first, second, [out](const std::size_t i, const double ax, const double ay, const double bx,
+                                     const double by) {
+                out[i] = (by - ay) / (bx - ax);
+            });
+            return result;
+        }
+
+        /**
+         * @brief The shoelace area, see @ref geometry::area. Every leaf sums its cross products into four
+         * independent lanes, which the compiler maps to vector registers, and adds the lanes in a fixed order.
+         */
+        inline double area(const PointSet &polygon) {
+            if (polygon.size() < 3)
+                return 0;
+            const double *x{polygon.x.data()}, *y{polygon.y.data()};
+            const double x0{x[0]}, y0{y[0]};
+            auto cross{
+                [=](const std::size_t i) {
+                    return (x[i] - x0) * (y[i + 1] - y0) - (x[i + 1] - x0) * (y[i] - y0);
+                }
+            };
+            const double twice{
+                reductions::tree_reduce<double>(polygon.size() - 1, [&](const std::size_t begin, const std::size_t end) {
+                    double lanes[4]{};
+                    std::size_t i{begin};
+                    for (; i + 4 <= end; i += 4) {
+                        lanes[0] += cross(i);
+                        lanes[1] += cross(i + 1);
+                        lanes[2] += cross(i + 2);
+                        lanes[3] += cross(i + 3);
+                    }
+                    for (; i < end; ++i)
+                        lanes[0] += cross(i);
+                    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+                }, [](double &left, const double right) { left += right; })
+            };
+            return std::fabs(twice) / 2;
+        }
+
+        inline bool collinear(const PointSet &points) {
+            const double *x{points.x.data()}, *y{points.y.data()};
+            const double x0{x[0]}, y0{y[0]};
+            const auto [length, far]{
+                farthest<double>(points.size(), [=](const std::size_t i) {
+                    return (x[i] - x0) * (x[i] - x0) + (y[i] - y0) * (y[i] - y0);
+                })
+            };
+            if (length == 0)
+                return true;
+            const double d_x{x[far] - x0}, d_y{y[far] - y0};
+            const double deviation{
+                reductions::tree_reduce<double>(points.size(), [=](const std::size_t begin, const std::size_t end) {
+                    double largest{0};
+                    for (std::size_t i = begin; i < end; ++i)
+                        largest = std::max(largest, std::fabs(d_x * (y[i] - y0) - d_y * (x[i] - x0)));
+                    return largest;
+                }, [](double &left, const double right) { left = std::max(left, right); })
+            };
+            return deviation <= length * tolerance;
+        }
+
+        inline std::vector<double> collinear(const PointSet &points, const PointSet &line) {
+            if (line.size() != 2)
+                throw std::runtime_error("A line must be given by two points !");
+            const double l_x{line.x[0]}, l_y{line.y[0]};
+            const double d_x{line.x[1] - l_x}, d_y{line.y[1] - l_y};
+            std::vector<double> result(points.size());
+            double *out{result.data()};
+            const double *x{points.x.data()}, *y{points.y.data()};
+            for_each_block(points.size(), [=](const std::size_t begin, const std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const double u_x{x[i] - l_x}, u_y{y[i] - l_y};
+                    const double scale{std::max(d_x * d_x + d_y * d_y, u_x * u_x + u_y * u_y)};
+                    out[i] = std::fabs(d_x * u_y - d_y * u_x) <= scale * tolerance ? 1.0 : 0.0;
+                }
+            });
+            return result;
+        }
+    } // namespace fast
+} // namespace mmqli::core::geometry
+#endif // GEOMETRY_HPP
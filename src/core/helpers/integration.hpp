@@ -0,0 +1,230 @@
+#ifndef INTEGRATION_HPP
+#define INTEGRATION_HPP
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the numerical integration over a finite interval. The integrand is evaluated on the
+ * whole set of nodes at once, as a batch, so the evaluations run in parallel.
+ */
+namespace mmqli::core::integration {
+    enum class Rule { gauss_legendre, tanh_sinh };
+
+    /**
+     * @brief The nodes of a rule on [-1, 1].
+     * Gauss-Legendre: @code abscissae @endcode holds the n nodes x_i and @code weights @endcode their weights.
+     * Tanh-sinh: the nodes are symmetric, @code abscissae @endcode holds 1 - x_k for t_k = k*h, k >= 0 (the distance
+     * to the end point, which keeps its digits where x_k itself rounds to 1), and @code weights @endcode their weights.
+     */
+    struct Nodes {
+        std::vector<float1000> abscissae;
+        std::vector<float1000> weights;
+    };
+
+    constexpr std::size_t first_gauss_legendre_order{16};
+    constexpr std::size_t last_gauss_legendre_order{1024};
+    constexpr std::size_t last_tanh_sinh_level{10}; // step h = 2^-level
+
+    /**
+     * @brief The n Gauss-Legendre nodes, the roots of P_n found by Newton iterations from the classical cosine guess.
+     * Every Newton step doubles the correct digits, so once the root is found at 64 bits the precision is doubled at
+     * every step. The roots are spread across the workers.
+     */
+    inline Nodes gauss_legendre_nodes(const std::size_t order, const mpfr_prec_t bits) {
+        Nodes nodes{std::vector<float1000>(order), std::vector<float1000>(order)};
+        const std::size_t half{(order + 1) / 2};
+        parallel::parallel_for(half, [&](const std::size_t i) {
+            precision::Register x{bits}, p{bits}, previous{bits}, older{bits}, derivative{bits}, scratch{bits};
+            mpfr_set_d(x.get(), std::cos(std::numbers::pi * (i + 0.75) / (order + 0.5)), MPFR_RNDN);
+            // P_n(x) into p and P_{n-1}(x) into previous, then P_n'(x) = n (x P_n - P_{n-1}) / (x^2 - 1)
+            auto legendre{
+                [&] {
+                    mpfr_set_ui(previous.get(), 1, MPFR_RNDN);
+                    mpfr_set(p.get(), x.get(), MPFR_RNDN);
+                    for (std::size_t k = 2; k <= order; ++k) {
+                        mpfr_swap(older.get(), previous.get());
+                        mpfr_swap(previous.get(), p.get());
+                        // k P_k = (2k - 1) x P_{k-1} - (k - 1) P_{k-2}
+                        mpfr_mul(p.get(), x.get(), previous.get(), MPFR_RNDN);
+                        mpfr_mul_ui(p.get(), p.get(), 2 * k - 1, MPFR_RNDN);
+                        mpfr_mul_ui(scratch.get(), older.get(), k - 1, MPFR_RNDN);
+                        mpfr_sub(p.get(), p.get(), scratch.get(), MPFR_RNDN);
+                        mpfr_div_ui(p.get(), p.get(), k, MPFR_RNDN);
+                    }
+                    mpfr_mul(derivative.get(), x.get(), p.get(), MPFR_RNDN);
+                    mpfr_sub(derivative.get(), derivative.get(), previous.get(), MPFR_RNDN);
+                    mpfr_mul_ui(derivative.get(), derivative.get(), order, MPFR_RNDN);
+                    mpfr_sqr(scratch.get(), x.get(), MPFR_RNDN);
+                    mpfr_sub_ui(scratch.get(), scratch.get(), 1, MPFR_RNDN);
+                    mpfr_div(derivative.get(), derivative.get(), scratch.get(), MPFR_RNDN);
+                }
+            };
+            auto newton_step{
+                [&](const mpfr_prec_t step_bits) {
+                    for (auto *r: {&x, &p, &previous, &older, &derivative, &scratch})
+                        mpfr_prec_round(r->get(), step_bits, MPFR_RNDN);
+                    legendre();
+                    mpfr_div(scratch.get(), p.get(), derivative.get(), MPFR_RNDN);
+                    mpfr_sub(x.get(), x.get(), scratch.get(), MPFR_RNDN);
+                }
+            };
+            // converge at 64 bits first, the guess is only good to a few digits.
+            for (int iteration = 0; iteration < 32; ++iteration) {
+                newton_step(64);
+                if (mpfr_zero_p(scratch.get()) || mpfr_get_exp(scratch.get()) < -56)
+                    break;
+            }
+            for (mpfr_prec_t step_bits = 128; step_bits < bits; step_bits *= 2)
+                newton_step(step_bits);
+            newton_step(bits); // from at least half the digits, so this step gives all of them.
+            legendre();
+            // w = 2 / ((1 - x^2) P_n'(x)^2)
+            mpfr_sqr(scratch.get(), x.get(), MPFR_RNDN);
+            mpfr_ui_sub(scratch.get(), 1, scratch.get(), MPFR_RNDN);
+            mpfr_sqr(p.get(), derivative.get(), MPFR_RNDN);
+            mpfr_mul(scratch.get(), scratch.get(), p.get(), MPFR_RNDN);
+            mpfr_ui_div(scratch.get(), 2, scratch.get(), MPFR_RNDN);
+            nodes.abscissae[i] = x.to_float1000();
+            nodes.weights[i] = scratch.to_float1000();
+            nodes.abscissae[order - 1 - i] = -nodes.abscissae[i];
+            nodes.weights[order - 1 - i] = nodes.weights[i];
+        });
+        return nodes;
+    }
+
+    /**
+     * @brief The tanh-sinh nodes of step h = 2^-level: x_k = tanh(u_k), u_k = pi/2 sinh(k h), with weights
+     * w_k = pi/2 h cosh(k h) / cosh(u_k)^2, for k from 0 until the weights drop below the precision.
+     */
+    inline Nodes tanh_sinh_nodes(const std::size_t level, const mpfr_prec_t bits) {
+        const double h{std::ldexp(1.0, -static_cast<int>(level))};
+        // log w(t) ~ log(pi/2 h cosh t) - 2 (u - log 2), solved for the last t with w(t) >= 2^-(bits + 32)
+        const double smallest_log_weight{-(bits + 32) * std::numbers::ln2};
+        std::size_t count{1};
+        for (double t = h;; t += h, ++count) {
+            const double u{std::numbers::pi / 2 * std::sinh(t)};
+            if (std::log(std::numbers::pi / 2 * h * std::cosh(t)) - 2 * (u - std::numbers::ln2) < smallest_log_weight)
+                break;
+        }
+        Nodes nodes{std::vector<float1000>(count), std::vector<float1000>(count)};
+        parallel::parallel_for(count, [&](const std::size_t k) {
+            precision::Register half_pi{bits}, t{bits}, u{bits}, e{bits}, weight{bits}, scratch{bits};
+            mpfr_const_pi(half_pi.get(), MPFR_RNDN);
+            mpfr_div_2ui(half_pi.get(), half_pi.get(), 1, MPFR_RNDN);
+            mpfr_set_ui(t.get(), k, MPFR_RNDN);
+            mpfr_div_2ui(t.get(), t.get(), level, MPFR_RNDN);
+            mpfr_sinh_cosh(u.get(), weight.get(), t.get(), MPFR_RNDN);
+            mpfr_mul(u.get(), u.get(), half_pi.get(), MPFR_RNDN);
+            // 1 - tanh(u) = 2 / (e^2u + 1) and cosh(u)^2 = (e^2u + 2 + e^-2u) / 4
+            mpfr_mul_2ui(e.get(), u.get(), 1, MPFR_RNDN);
+            mpfr_exp(e.get(), e.get(), MPFR_RNDN);
+            mpfr_add_ui(scratch.get(), e.get(), 1, MPFR_RNDN);
+            mpfr_ui_div(scratch.get(), 2, scratch.get(), MPFR_RNDN);
+            nodes.abscissae[k] = scratch.to_float1000();
+            mpfr_ui_div(scratch.get(), 1, e.get(), MPFR_RNDN);
+            mpfr_add(scratch.get(), scratch.get(), e.get(), MPFR_RNDN);
+            mpfr_add_ui(scratch.get(), scratch.get(), 2, MPFR_RNDN);
+            mpfr_div_2ui(scratch.get(), scratch.get(), 2, MPFR_RNDN);
+            mpfr_mul(weight.get(), weight.get(), half_pi.get(), MPFR_RNDN);
+            mpfr_div_2ui(weight.get(), weight.get(), level, MPFR_RNDN);
+            mpfr_div(weight.get(), weight.get(), scratch.get(), MPFR_RNDN);
+            nodes.weights[k] = weight.to_float1000();
+        });
+        return nodes;
+    }
+
+    /**
+     * @brief The nodes of a rule, computed once per (rule, order, precision) and then shared. For the tanh-sinh rule
+     * the order is the level.
+     */
+    inline std::shared_ptr<const Nodes> nodes(const Rule rule, const std::size_t order, const mpfr_prec_t bits) {
+        static std::mutex cache_mutex;
+        static std::map<std::tuple<Rule, std::size_t, mpfr_prec_t>, std::shared_ptr<const Nodes> > cache;
+        const std::scoped_lock lock(cache_mutex);
+        auto &cached{cache[{rule, order, bits}]};
+        if (!cached)
+            cached = std::make_shared<const Nodes>(rule == Rule::gauss_legendre
+                                                       ? gauss_legendre_nodes(order, bits)
+                                                       : tanh_sinh_nodes(order, bits));
+        return cached;
+    }
+
+    /**
+     * @brief One estimate of the integral of @p integrand over [a, b] with the given nodes.
+     * @param integrand A callable of the form @code std::vector<float1000>(const std::vector<float1000> &points) @endcode
+     */
+    template<typename Integrand>
+    float1000 estimate(const Rule rule, const Nodes &nodes, const float1000 &a, const float1000 &b,
+                       Integrand &&integrand) {
+        const float1000 half{(b - a) / 2};
+        const float1000 middle{(a + b) / 2};
+        std::vector<float1000> points;
+        std::vector<const float1000 *> weights;
+        if (rule == Rule::gauss_legendre) {
+            points.reserve(nodes.abscissae.size());
+            for (std::size_t i = 0; i < nodes.abscissae.size(); ++i) {
+                points.emplace_back(middle + half * nodes.abscissae[i]);
+                weights.emplace_back(&nodes.weights[i]);
+            }
+        } else {
+            points.reserve(2 * nodes.abscissae.size());
+            points.emplace_back(middle);
+            weights.emplace_back(&nodes.weights[0]);
+            for (std::size_t k = 1; k < nodes.abscissae.size(); ++k) {
+                const float1000 offset{half * nodes.abscissae[k]};
+                points.emplace_back(a + offset);
+                points.emplace_back(b - offset);
+                weights.emplace_back(&nodes.weights[k]);
+                weights.emplace_back(&nodes.weights[k]);
+            }
+        }
+        const std::vector<float1000> values{integrand(points)};
+        float1000 sum{0};
+        float1000 term;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            mpfr_mul(term.backend().data(), weights[i]->backend().data(), values[i].backend().data(), MPFR_RNDN);
+            mpfr_add(sum.backend().data(), sum.backend().data(), term.backend().data(), MPFR_RNDN);
+        }
+        return float1000{sum * half};
+    }
+
+    /**
+     * @brief The integral of @p integrand over [a, b]. The order (Gauss-Legendre) or the level (tanh-sinh) is raised
+     * until two successive estimates agree to half the digits: both rules at least double the correct digits from
+     * one estimate to the next for the integrands they suit, so the last estimate then has all of them.
+     */
+    template<typename Integrand>
+    float1000 integrate(const Rule rule, const float1000 &a, const float1000 &b, Integrand &&integrand) {
+        const mpfr_prec_t bits{precision::float1000_bits};
+        if (a == b)
+            return float1000{0};
+        const std::size_t first{rule == Rule::gauss_legendre ? first_gauss_legendre_order : 0};
+        const std::size_t last{rule == Rule::gauss_legendre ? last_gauss_legendre_order : last_tanh_sinh_level};
+        const auto next{[rule](const std::size_t order) { return rule == Rule::gauss_legendre ? order * 2 : order + 1; }};
+        float1000 previous{estimate(rule, *nodes(rule, first, bits), a, b, integrand)};
+        for (std::size_t order = next(first); order <= last; order = next(order)) {
+            float1000 current{estimate(rule, *nodes(rule, order, bits), a, b, integrand)};
+            float1000 tolerance{fabs(current)};
+            if (tolerance < 1)
+                tolerance = 1;
+            mpfr_mul_2si(tolerance.backend().data(), tolerance.backend().data(), -bits / 2, MPFR_RNDN);
+            if (fabs(current - previous) <= tolerance)
+                return current;
+            previous = std::move(current);
+        }
+        throw std::runtime_error(rule == Rule::gauss_legendre
+                                     ? "Integral did not converge, INTEGRATE_TANH_SINH handles end point singularities !"
+                                     : "Integral did not converge !");
+    }
+} // namespace mmqli::core::integration
+#endif // INTEGRATION_HPP
@@ -0,0 +1,249 @@
+#ifndef LINALG_HPP
+#define LINALG_HPP
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "boost_fwd.hpp"
+#include "constants.hpp"
+
+/**
+ * @brief This namespace contains the numerical linear algebra for vectors and matrices of up to 5x5 elements. Every
+ * kernel is a template on the dimensions, so the loops are unrolled at compile time and the elements live on the
+ * stack; the only heap memory is the limbs of the MPFR numbers themselves.
+ */
+namespace mmqli::core::linalg {
+    constexpr std::size_t max_dimension{5};
+
+    /**
+     * @brief A matrix whose shape is only known at run time, it is what the parser produces and what the output is
+     * built from. The elements are stored row by row.
+     */
+    template<typename T>
+    struct DynamicMatrix {
+        std::size_t rows{0};
+        std::size_t cols{0};
+        std::vector<T> elements;
+        bool vector{false}; // written as a flat list [a,b,c] rather than as a column [[a],[b],[c]]
+
+        T &operator()(const std::size_t row, const std::size_t col) { return elements[row * cols + col]; }
+        const T &operator()(const std::size_t row, const std::size_t col) const { return elements[row * cols + col]; }
+    };
+
+    /**
+     * @brief A matrix of compile time shape R x C with stack storage, vectors are matrices of one column.
+     */
+    template<typename T, std::size_t R, std::size_t C>
+    struct Matrix {
+        std::array<T, R * C> elements{};
+
+        constexpr T &operator()(const std::size_t row, const std::size_t col) { return elements[row * C + col]; }
+        constexpr const T &operator()(const std::size_t row, const std::size_t col) const {
+            return elements[row * C + col];
+        }
+
+        static Matrix from(const std::vector<T> &elements) {
+            Matrix fixed;
+            std::ranges::copy(elements, fixed.elements.begin());
+            return fixed;
+        }
+
+        static Matrix from(const DynamicMatrix<T> &matrix) { return from(matrix.elements); }
+
+        [[nodiscard]] DynamicMatrix<T> to_dynamic(const bool vector = false) const {
+            return DynamicMatrix<T>{R, C, std::vector<T>(elements.begin(), elements.end()), vector};
+        }
+    };
+
+    /**
+     * @brief Calls @p body with std::integral_constant<std::size_t, I> for I in [0, N), the calls are expanded at
+     * compile time.
+     */
+    template<std::size_t N, typename Body>
+    constexpr void static_for(Body &&body) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (body(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief Calls @code visitor.template operator()<R, C>() @endcode with the compile time constants matching the run
+     * time shape, so that the fixed size kernel of that shape is picked.
+     * @return false when the shape is not in [1, max_dimension] x [1, max_dimension].
+     */
+    template<typename Visitor>
+    bool visit_shape(const std::size_t rows, const std::size_t cols, Visitor &&visitor) {
+        bool visited{false};
+        static_for<max_dimension>([&](auto r) {
+            static_for<max_dimension>([&](auto c) {
+                if (rows == r + 1 && cols == c + 1) {
+                    visitor.template operator()<r + 1, c + 1>();
+                    visited = true;
+                }
+            });
+        });
+        return visited;
+    }
+
+    /**
+     * @brief Calls @code visitor.template operator()<N>() @endcode with the compile time constant matching @p n.
+     * @return false when @p n is not in [1, max_dimension].
+     */
+    template<typename Visitor>
+    bool visit_dimension(const std::size_t n, Visitor &&visitor) {
+        bool visited{false};
+        static_for<max_dimension>([&](auto i) {
+            if (n == i + 1) {
+                visitor.template operator()<i + 1>();
+                visited = true;
+            }
+        });
+        return visited;
+    }
+
+    inline float1000 magnitude(const float1000 &value) { return float1000{fabs(value)}; }
+    inline float1000 magnitude(const complex1000 &value) { return float1000{std::abs(value)}; }
+    inline float1000 conjugate(const float1000 &value) { return value; }
+    inline complex1000 conjugate(const complex1000 &value) { return std::conj(value); }
+
+    template<typename T, std::size_t R, std::size_t C>
+    Matrix<T, C, R> transpose(const Matrix<T, R, C> &matrix) {
+        Matrix<T, C, R> result;
+        static_for<R>([&](auto i) {
+            static_for<C>([&](auto j) { result(j, i) = matrix(i, j); });
+        });
+        return result;
+    }
+
+    template<typename T, std::size_t R, std::size_t K, std::size_t C>
+    Matrix<T, R, C> multiply(const Matrix<T, R, K> &left, const Matrix<T, K, C> &right) {
+        Matrix<T, R, C> result;
+        static_for<R>([&](auto i) {
+            static_for<C>([&](auto j) {
+                T &cell{result(i, j)};
+                cell = left(i, 0) * right(0, j);
+                static_for<K - 1>([&](auto k) { cell += left(i, k + 1) * right(k + 1, j); });
+            });
+        });
+        return result;
+    }
+
+    /**
+     * @brief The inner product of two vectors, the first vector is conjugated for complex numbers.
+     */
+    template<typename T, std::size_t N>
+    T dot(const Matrix<T, N, 1> &left, const Matrix<T, N, 1> &right) {
+        T result{conjugate(left(0, 0)) * right(0, 0)};
+        static_for<N - 1>([&](auto i) { result += conjugate(left(i + 1, 0)) * right(i + 1, 0); });
+        return result;
+    }
+
+    template<typename T>
+    Matrix<T, 3, 1> cross(const Matrix<T, 3, 1> &u, const Matrix<T, 3, 1> &v) {
+        Matrix<T, 3, 1> result;
+        result(0, 0) = u(1, 0) * v(2, 0) - u(2, 0) * v(1, 0);
+        result(1, 0) = u(2, 0) * v(0, 0) - u(0, 0) * v(2, 0);
+        result(2, 0) = u(0, 0) * v(1, 0) - u(1, 0) * v(0, 0);
+        return result;
+    }
+
+    /**
+     * @brief The cross product of two plane vectors, i-e the z component of their cross product in space.
+     */
+    template<typename T>
+    T cross(const Matrix<T, 2, 1> &u, const Matrix<T, 2, 1> &v) {
+        return T{u(0, 0) * v(1, 0) - u(1, 0) * v(0, 0)};
+    }
+
+    /**
+     * @brief Gaussian elimination with partial pivoting of @p matrix, the row operations are applied to @p rhs as
+     * well. On return @p matrix is upper triangular.
+     * @return The sign of the row permutation, or 0 when the matrix is singular.
+     */
+    template<typename T, std::size_t N, std::size_t M>
+    int eliminate(Matrix<T, N, N> &matrix, Matrix<T, N, M> &rhs) {
+        int sign{1};
+        bool singular{false};
+        static_for<N>([&](auto k) {
+            if (singular)
+                return;
+            std::size_t pivot{k};
+            for (std::size_t row = k + 1; row < N; ++row)
+                if (magnitude(matrix(row, k)) > magnitude(matrix(pivot, k)))
+                    pivot = row;
+            if (matrix(pivot, k) == T{0}) {
+                singular = true;
+                return;
+            }
+            if (pivot != k) {
+                static_for<N>([&](auto j) { std::swap(matrix(k, j), matrix(pivot, j)); });
+                static_for<M>([&](auto j) { std::swap(rhs(k, j), rhs(pivot, j)); });
+                sign = -sign;
+            }
+            static_for<N - k - 1>([&](auto offset) {
+                constexpr std::size_t row{k + 1 + offset};
+                const T factor{matrix(row, k) / matrix(k, k)};
+                static_for<N - k>([&](auto j) { matrix(row, k + j) -= factor * matrix(k, k + j); });
+                static_for<M>([&](auto j) { rhs(row, j) -= factor * rhs(k, j); });
+            });
+        });
+        return singular ? 0 : sign;
+    }
+
+    template<typename T, std::size_t N>
+    T determinant(const Matrix<T, N, N> &matrix) {
+        if constexpr (N == 1)
+            return matrix(0, 0);
+        else if constexpr (N == 2)
+            return T{matrix(0, 0) * matrix(1, 1) - matrix(0, 1) * matrix(1, 0)};
+        else if constexpr (N == 3)
+            return T{
+                matrix(0, 0) * (matrix(1, 1) * matrix(2, 2) - matrix(1, 2) * matrix(2, 1))
+                - matrix(0, 1) * (matrix(1, 0) * matrix(2, 2) - matrix(1, 2) * matrix(2, 0))
+                + matrix(0, 2) * (matrix(1, 0) * matrix(2, 1) - matrix(1, 1) * matrix(2, 0))
+            };
+        else {
+            Matrix<T, N, N> upper{matrix};
+            Matrix<T, N, 1> unused;
+            const int sign{eliminate(upper, unused)};
+            if (sign == 0)
+                return T{0};
+            T result{upper(0, 0)};
+            static_for<N - 1>([&](auto i) { result *= upper(i + 1, i + 1); });
+            return sign < 0 ? T{-result} : result;
+        }
+    }
+
+    /**
+     * @brief Solves matrix * x = rhs for x by elimination and back substitution.
+     */
+    template<typename T, std::size_t N, std::size_t M>
+    Matrix<T, N, M> solve(const Matrix<T, N, N> &matrix, const Matrix<T, N, M> &rhs) {
+        Matrix<T, N, N> upper{matrix};
+        Matrix<T, N, M> x{rhs};
+        if (eliminate(upper, x) == 0)
+            throw std::runtime_error("Matrix is singular !");
+        static_for<N>([&](auto reverse) {
+            constexpr std::size_t row{N - 1 - reverse};
+            static_for<M>([&](auto j) {
+                T &cell{x(row, j)};
+                static_for<N - row - 1>([&](auto offset) { cell -= upper(row, row + 1 + offset) * x(row + 1 + offset, j); });
+                cell /= upper(row, row);
+            });
+        });
+        return x;
+    }
+
+    template<typename T, std::size_t N>
+    Matrix<T, N, N> inverse(const Matrix<T, N, N> &matrix) {
+        Matrix<T, N, N> identity;
+        static_for<N>([&](auto i) {
+            static_for<N>([&](auto j) { identity(i, j) = T{i == j ? 1 : 0}; });
+        });
+        return solve(matrix, identity);
+    }
+} // namespace mmqli::core::linalg
+#endif // LINALG_HPP
@@ -0,0 +1,228 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <mpfr.h>
+#include "cancel.hpp"
+
+namespace mmqli::core::parallel {
+    namespace detail {
+        /**
+         * @brief The number of threads the machine offers to mmqlc. It is the hardware concurrency of the machine,
+         * unless the @code MMQLC_THREADS @endcode environment variable asks for another count. An MPFR built without
+         * thread-local storage shares its caches (the constants, the exponent range) between the threads, the
+         * kernels then run on a single thread.
+         */
+        inline std::size_t configured_worker_count() {
+            static const std::size_t count{
+                [] {
+                    if (!mpfr_buildopt_tls_p())
+                        return std::size_t{1};
+                    if (const char *requested{std::getenv("MMQLC_THREADS")}; requested != nullptr) {
+                        try {
+                            return std::max<std::size_t>(1, std::stoul(requested));
+                        } catch (...) {
+                            // malformed value, fall through to the hardware concurrency.
+                        }
+                    }
+                    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+                }()
+            };
+            return count;
+        }
+
+        // zero when the kernels may use every configured worker.
+        inline std::atomic<std::size_t> worker_limit{0};
+    }
+
+    /**
+     * @brief The number of worker threads used by the parallel kernels, the configured count unless
+     * @code limit_workers() @endcode lowered it.
+     * @return The number of worker threads, at least one.
+     */
+    inline std::size_t worker_count() {
+        const std::size_t limit{detail::worker_limit.load(std::memory_order_relaxed)};
+        return limit == 0 ? detail::configured_worker_count() : std::min(limit, detail::configured_worker_count());
+    }
+
+    /**
+     * @brief Lowers the number of workers of the following parallel regions to @p limit, zero lifts the limit. The
+     * count can not grow beyond the configured one, the pool is sized once. Meant for scaling measurements, it must
+     * not be called while a parallel region is running.
+     */
+    inline void limit_workers(const std::size_t limit) {
+        detail::worker_limit.store(limit, std::memory_order_relaxed);
+    }
+
+    namespace detail {
+        // set on the threads that are running a parallel region, nested regions then run sequentially.
+        inline thread_local bool inside_parallel_region{false};
+
+        struct RegionGuard {
+            bool previous{std::exchange(inside_parallel_region, true)};
+            ~RegionGuard() { inside_parallel_region = previous; }
+        };
+    }
+
+    /**
+     * @brief A fixed set of worker threads that are started once and then reused by every parallel region, so a
+     * kernel that runs many short regions (one per column of an LU factorization for example) does not pay for
+     * starting threads every time. One region runs at a time, the calling thread takes part in it as worker 0. A
+     * region submitted by another thread while the pool is busy is refused, its caller runs it alone.
+     */
+    class ThreadPool {
+        std::mutex mutex;
+        std::mutex submit_mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        const std::function<void(std::size_t)> *job{nullptr};
+        std::size_t generation{0};
+        std::size_t unclaimed{0}; // helpers still to join the current region
+        std::size_t running{0}; // helpers that have not finished the current region
+        bool stopping{false};
+        std::vector<std::jthread> threads;
+
+        void work() {
+            detail::inside_parallel_region = true;
+            std::size_t seen{0};
+            std::unique_lock lock(mutex);
+            for (;;) {
+                wake.wait(lock, [&] { return stopping || (generation != seen && unclaimed > 0); });
+                if (stopping)
+                    return;
+                seen = generation;
+                const std::size_t worker{unclaimed--};
+                const auto *region{job};
+                lock.unlock();
+                (*region)(worker);
+                lock.lock();
+                if (--running == 0)
+                    finished.notify_all();
+            }
+        }
+
+    public:
+        explicit ThreadPool(const std::size_t helpers) {
+            threads.reserve(helpers);
+            for (std::size_t i = 0; i < helpers; ++i)
+                threads.emplace_back([this] { work(); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool() {
+            {
+                const std::scoped_lock lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+        } // the jthreads join
+
+        /**
+         * @brief Runs @p region on the calling thread as worker 0 and on @p helpers pool threads as workers
+         * 1..helpers, and returns once all of them have returned. @p region must not throw.
+         * @return false, without running @p region, when the pool is running the region of another thread.
+         */
+        bool try_run(const std::size_t helpers, const std::function<void(std::size_t)> &region) {
+            const std::unique_lock submit(submit_mutex, std::try_to_lock);
+            if (!submit.owns_lock())
+                return false;
+            {
+                const std::scoped_lock lock(mutex);
+                job = &region;
+                unclaimed = std::min(helpers, threads.size());
+                running = unclaimed;
+                ++generation;
+            }
+            wake.notify_all();
+            {
+                const detail::RegionGuard guard;
+                region(0);
+            }
+            std::unique_lock lock(mutex);
+            finished.wait(lock, [&] { return running == 0; });
+            job = nullptr;
+            return true;
+        }
+    };
+
+    /**
+     * @brief The process wide pool, holding one thread less than the configured worker count since the calling
+     * thread works as well.
+     */
+    inline ThreadPool &pool() {
+        static ThreadPool instance(detail::configured_worker_count() - 1);
+        return instance;
+    }
+
+    /**
+     * @brief Calls @p body for every index in [0, count) across the worker threads. Indices are handed out
+     * dynamically, so the body must not depend on which thread runs it. The first exception thrown by the body is
+     * re-thrown on the calling thread once all the workers have stopped. A parallel region started from inside
+     * another one, or while the pool runs the region of another thread, runs sequentially on the calling thread, so
+     * threads evaluating queries side by side never wait for each other. Every index is a cancellation point of the
+     * query that started the region, see @ref cancel::point.
+     * @param count The number of indices.
+     * @param body A callable of the form @code void(std::size_t index) @endcode, or
+     * @code void(std::size_t index, std::size_t worker) @endcode when the body keeps per-worker state, with worker in
+     * [0, worker_count()).
+     */
+    template<typename Body>
+    void parallel_for(const std::size_t count, Body &&body) {
+        auto invoke{
+            [&](const std::size_t i, const std::size_t worker) {
+                if constexpr (std::is_invocable_v<Body &, std::size_t, std::size_t>)
+                    body(i, worker);
+                else
+                    body(i);
+            }
+        };
+        const std::size_t workers{detail::inside_parallel_region ? 1 : std::min(worker_count(), count)};
+        if (workers <= 1) {
+            for (std::size_t i = 0; i < count; ++i) {
+                cancel::point();
+                invoke(i, 0);
+            }
+            return;
+        }
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr failure{nullptr};
+        std::mutex failure_mutex;
+        const auto *budget{cancel::current()}; // the workers are cancelled with the query that started the region
+        const std::function<void(std::size_t)> region{
+            [&](const std::size_t worker) {
+                const cancel::Adopt adopt{budget};
+                for (std::size_t i{next.fetch_add(1)}; i < count; i = next.fetch_add(1)) {
+                    try {
+                        cancel::point();
+                        invoke(i, worker);
+                    } catch (...) {
+                        const std::scoped_lock lock(failure_mutex);
+                        if (!failure)
+                            failure = std::current_exception();
+                        next.store(count); // stop handing out work
+                    }
+                }
+            }
+        };
+        if (!pool().try_run(workers - 1, region)) {
+            const detail::RegionGuard guard;
+            region(0);
+        }
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+} // namespace mmqli::core::parallel
+#endif // PARALLEL_HPP
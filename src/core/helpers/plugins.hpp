@@ -0,0 +1,198 @@
+#ifndef PLUGINS_HPP
+#define PLUGINS_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../../plugins/mmqlc_plugin.h"
+#include "error.hpp"
+
+#if WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+/**
+ * @brief This namespace contains the registry of the functions loaded from plugins, shared objects implementing the
+ * C interface of @code plugins/mmqlc_plugin.h @endcode. The plugins are loaded at startup, before any query is
+ * evaluated, the registry is only read afterwards and can be read by the worker threads without a lock.
+ */
+namespace mmqli::core::plugins {
+    enum class Kind : unsigned char { real = MMQLC_REAL, complex = MMQLC_COMPLEX };
+
+    struct Function {
+        std::string name;
+        unsigned arity{1};
+        mmqlc_real_function real{nullptr};
+        mmqlc_complex_function complex{nullptr};
+        std::array<unsigned, 2> domain{MMQLC_DOMAIN_ANY, MMQLC_DOMAIN_ANY};
+        std::string description;
+    };
+
+    namespace detail {
+        using Registry = std::unordered_map<std::string, Function>;
+
+        inline Registry &registry(const Kind kind) {
+            static Registry real_functions;
+            static Registry complex_functions;
+            return kind == Kind::real ? real_functions : complex_functions;
+        }
+
+        // the functions registered by the plugin being loaded, they reach the registry once its init succeeds.
+        struct Staging {
+            std::vector<std::pair<Kind, Function> > functions;
+        };
+
+        inline bool valid_name(const char *name) {
+            if (name == nullptr || *name == '\0' || (*name >= '0' && *name <= '9'))
+                return false;
+            for (const char *c = name; *c != '\0'; ++c)
+                if (!((*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_'))
+                    return false;
+            const std::string_view keyword{name};
+            return keyword != "GET" && keyword != "SET" && keyword != "SAVE" && keyword != "LOAD";
+        }
+
+        inline int register_function(void *context, const mmqlc_function *function) {
+            auto &staging{*static_cast<Staging *>(context)};
+            if (function == nullptr || !valid_name(function->name) || (function->arity != 1 && function->arity != 2))
+                return 1;
+            if (function->kind != MMQLC_REAL && function->kind != MMQLC_COMPLEX)
+                return 1;
+            const Kind kind{static_cast<Kind>(function->kind)};
+            if ((kind == Kind::real && function->real == nullptr) ||
+                (kind == Kind::complex && function->complex == nullptr))
+                return 1;
+            const std::string name{function->name};
+            if (registry(kind).contains(name))
+                return 1;
+            for (const auto &[staged_kind, staged]: staging.functions)
+                if (staged_kind == kind && staged.name == name)
+                    return 1;
+            staging.functions.emplace_back(kind, Function{
+                                               name, function->arity, function->real, function->complex,
+                                               {function->domain[0], function->domain[1]},
+                                               function->description == nullptr ? "" : function->description
+                                           });
+            return 0;
+        }
+
+        // a library whose functions are registered stays loaded until exit, the registry points into it.
+        inline void *open(const std::string &path, std::string &failure) {
+#if WIN32
+            HMODULE library{LoadLibraryA(path.c_str())};
+            if (library == nullptr)
+                failure = "cannot load " + path;
+            return reinterpret_cast<void *>(library);
+#else
+            void *library{dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)};
+            if (library == nullptr)
+                failure = dlerror();
+            return library;
+#endif
+        }
+
+        inline void *symbol(void *library, const char *name) {
+#if WIN32
+            return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+            return dlsym(library, name);
+#endif
+        }
+
+        // a refused library is closed, nothing points into it.
+        inline void close(void *library) {
+#if WIN32
+            FreeLibrary(static_cast<HMODULE>(library));
+#else
+            dlclose(library);
+#endif
+        }
+    }
+
+    /**
+     * @brief The function registered as @p name for numbers of @p kind, nullptr when no plugin registered it.
+     */
+    inline const Function *find(const std::string &name, const Kind kind) {
+        const detail::Registry &functions{detail::registry(kind)};
+        const auto found{functions.find(name)};
+        return found == functions.end() ? nullptr : &found->second;
+    }
+
+    /**
+     * @brief Whether @p name is a plugin function of a single operand, the lexer accepts it like the built-in ones.
+     */
+    inline bool single_operand(const std::string &name, const Kind kind) {
+        const Function *function{find(name, kind)};
+        return function != nullptr && function->arity == 1;
+    }
+
+    /**
+     * @brief Whether the real number @p x satisfies the domain flags @p domain.
+     */
+    inline bool in_domain(const unsigned domain, mpfr_srcptr x) {
+        if (mpfr_nan_p(x))
+            return domain == MMQLC_DOMAIN_ANY;
+        if ((domain & MMQLC_DOMAIN_NONZERO) && mpfr_zero_p(x))
+            return false;
+        if ((domain & MMQLC_DOMAIN_POSITIVE) && mpfr_sgn(x) <= 0)
+            return false;
+        if ((domain & MMQLC_DOMAIN_NONNEGATIVE) && mpfr_sgn(x) < 0)
+            return false;
+        return !(domain & MMQLC_DOMAIN_INTEGER) || mpfr_integer_p(x);
+    }
+
+    /**
+     * @brief Whether the complex number @p real + @p imaginary i satisfies the domain flags @p domain, the flags
+     * other than nonzero require a real number.
+     */
+    inline bool in_domain(const unsigned domain, mpfr_srcptr real, mpfr_srcptr imaginary) {
+        if (mpfr_zero_p(imaginary))
+            return in_domain(domain, real);
+        return (domain & ~MMQLC_DOMAIN_NONZERO) == 0 && !mpfr_nan_p(imaginary);
+    }
+
+    /**
+     * @brief Loads the plugin at @p path and registers its functions. A plugin that is refused registers nothing and
+     * is closed again.
+     * @return The number of functions registered, or why the plugin was refused.
+     */
+    inline error::Result<std::size_t> load(const std::string &path) {
+        std::string failure;
+        void *library{detail::open(path, failure)};
+        if (library == nullptr)
+            return error::fail(error::Code::plugin, "Cannot load plugin " + path + ": " + failure);
+        const auto refuse{
+            [library](std::string message) {
+                detail::close(library);
+                return error::fail(error::Code::plugin, std::move(message));
+            }
+        };
+        const auto abi_version{
+            reinterpret_cast<mmqlc_plugin_abi_version_function>(
+                detail::symbol(library, MMQLC_PLUGIN_ABI_VERSION_SYMBOL))
+        };
+        const auto init{
+            reinterpret_cast<mmqlc_plugin_init_function>(detail::symbol(library, MMQLC_PLUGIN_INIT_SYMBOL))
+        };
+        if (abi_version == nullptr || init == nullptr)
+            return refuse(path + " is not an mmqlc plugin !");
+        if (const unsigned version{abi_version()}; version != MMQLC_PLUGIN_ABI_VERSION)
+            return refuse(path + " is built for plugin interface " + std::to_string(version) + ", mmqlc implements " +
+                          std::to_string(MMQLC_PLUGIN_ABI_VERSION) + " !");
+        detail::Staging staging;
+        const mmqlc_host host{MMQLC_PLUGIN_ABI_VERSION, &staging, detail::register_function};
+        if (init(&host) != 0)
+            return refuse(path + " failed to register its functions !");
+        for (auto &[kind, function]: staging.functions) {
+            std::string name{function.name};
+            detail::registry(kind).emplace(std::move(name), std::move(function));
+        }
+        return staging.functions.size();
+    }
+} // namespace mmqli::core::plugins
+#endif // PLUGINS_HPP
@@ -0,0 +1,269 @@
+#ifndef POLYNOMIAL_HPP
+#define POLYNOMIAL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "constants.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the polynomial kernels. Coefficients are always given from the highest degree down
+ * to the constant term, i-e @code [1,-3,2] @endcode is x^2 - 3x + 2.
+ */
+namespace mmqli::core::polynomial {
+    /**
+     * @brief The number of points evaluated by one task of the batch evaluation.
+     */
+    constexpr std::size_t points_per_task{256};
+
+    /**
+     * @brief The precision of the first Aberth iterations. The iterations converge globally at this precision, then
+     * the precision is doubled, and every doubling only needs a few iterations since the convergence is cubic.
+     */
+    constexpr mpfr_prec_t initial_bits{64};
+
+    /**
+     * @brief Horner evaluation of the real polynomial at every point, the points are spread across the workers.
+     */
+    inline std::vector<float1000> evaluate(const std::vector<float1000> &coefficients,
+                                           const std::vector<float1000> &points) {
+        if (coefficients.empty())
+            throw std::runtime_error("Polynomial has no coefficients !");
+        std::vector<float1000> values(points.size());
+        parallel::parallel_for((points.size() + points_per_task - 1) / points_per_task, [&](const std::size_t task) {
+            const std::size_t end{std::min(points.size(), (task + 1) * points_per_task)};
+            for (std::size_t p = task * points_per_task; p < end; ++p) {
+                const mpfr_ptr value{values[p].backend().data()};
+                const mpfr_srcptr x{points[p].backend().data()};
+                mpfr_set(value, coefficients.front().backend().data(), MPFR_RNDN);
+                for (std::size_t i = 1; i < coefficients.size(); ++i) {
+                    mpfr_mul(value, value, x, MPFR_RNDN);
+                    mpfr_add(value, value, coefficients[i].backend().data(), MPFR_RNDN);
+                }
+            }
+        });
+        return values;
+    }
+
+    /**
+     * @brief Horner evaluation of the complex polynomial at every point, the points are spread across the workers.
+     */
+    inline std::vector<complex1000> evaluate(const std::vector<complex1000> &coefficients,
+                                             const std::vector<complex1000> &points) {
+        if (coefficients.empty())
+            throw std::runtime_error("Polynomial has no coefficients !");
+        std::vector<complex1000> values(points.size());
+        parallel::parallel_for((points.size() + points_per_task - 1) / points_per_task, [&](const std::size_t task) {
+            const std::size_t end{std::min(points.size(), (task + 1) * points_per_task)};
+            for (std::size_t p = task * points_per_task; p < end; ++p) {
+                complex1000 value{coefficients.front()};
+                for (std::size_t i = 1; i < coefficients.size(); ++i)
+                    value = value * points[p] + coefficients[i];
+                values[p] = std::move(value);
+            }
+        });
+        return values;
+    }
+
+    /**
+     * @brief A complex number held in two registers, so that its precision can be raised between iterations.
+     */
+    struct ComplexRegister {
+        precision::Register re;
+        precision::Register im;
+
+        explicit ComplexRegister(const mpfr_prec_t bits) : re(bits), im(bits) {}
+
+        void raise_precision(const mpfr_prec_t bits) {
+            mpfr_prec_round(re.get(), bits, MPFR_RNDN);
+            mpfr_prec_round(im.get(), bits, MPFR_RNDN);
+        }
+
+        [[nodiscard]] bool is_zero() const { return mpfr_zero_p(re.get()) && mpfr_zero_p(im.get()); }
+    };
+
+    /**
+     * @brief The temporaries of one worker during an Aberth iteration, allocated once per precision level.
+     */
+    struct AberthWorkspace {
+        ComplexRegister value;
+        ComplexRegister derivative;
+        ComplexRegister sum;
+        ComplexRegister term;
+        precision::Register first;
+        precision::Register second;
+        precision::Register third;
+
+        explicit AberthWorkspace(const mpfr_prec_t bits)
+            : value(bits), derivative(bits), sum(bits), term(bits), first(bits), second(bits), third(bits) {}
+
+        // result = a * b, result may alias a or b.
+        void multiply(ComplexRegister &result, const ComplexRegister &a, const ComplexRegister &b) {
+            mpfr_fmms(first.get(), a.re.get(), b.re.get(), a.im.get(), b.im.get(), MPFR_RNDN);
+            mpfr_fmma(second.get(), a.re.get(), b.im.get(), a.im.get(), b.re.get(), MPFR_RNDN);
+            mpfr_set(result.re.get(), first.get(), MPFR_RNDN);
+            mpfr_set(result.im.get(), second.get(), MPFR_RNDN);
+        }
+
+        // result = a / b, result may alias a or b, b must not be zero.
+        void divide(ComplexRegister &result, const ComplexRegister &a, const ComplexRegister &b) {
+            mpfr_fmma(third.get(), b.re.get(), b.re.get(), b.im.get(), b.im.get(), MPFR_RNDN);
+            mpfr_fmma(first.get(), a.re.get(), b.re.get(), a.im.get(), b.im.get(), MPFR_RNDN);
+            mpfr_fmms(second.get(), a.im.get(), b.re.get(), a.re.get(), b.im.get(), MPFR_RNDN);
+            mpfr_div(result.re.get(), first.get(), third.get(), MPFR_RNDN);
+            mpfr_div(result.im.get(), second.get(), third.get(), MPFR_RNDN);
+        }
+
+        // sum += 1 / difference, difference must not be zero.
+        void add_reciprocal(const ComplexRegister &difference) {
+            mpfr_fmma(third.get(), difference.re.get(), difference.re.get(), difference.im.get(),
+                      difference.im.get(), MPFR_RNDN);
+            mpfr_div(first.get(), difference.re.get(), third.get(), MPFR_RNDN);
+            mpfr_div(second.get(), difference.im.get(), third.get(), MPFR_RNDN);
+            mpfr_add(sum.re.get(), sum.re.get(), first.get(), MPFR_RNDN);
+            mpfr_sub(sum.im.get(), sum.im.get(), second.get(), MPFR_RNDN);
+        }
+
+        // |z|^2 into the register
+        void squared_magnitude(const mpfr_ptr result, const ComplexRegister &z) {
+            mpfr_fmma(result, z.re.get(), z.re.get(), z.im.get(), z.im.get(), MPFR_RNDN);
+        }
+    };
+
+    /**
+     * @brief All the complex roots of a polynomial, by Aberth-Ehrlich iterations. Every iteration updates all the
+     * roots from the previous approximations (Jacobi style), so the roots are spread across the workers and the result
+     * does not depend on the number of threads. The iterations start at @code initial_bits @endcode and the precision
+     * is doubled whenever every root has converged at the current one, up to the precision of float1000.
+     * @param coefficients From the highest degree down to the constant term.
+     * @return The roots sorted by real part, then by imaginary part, repeated according to their multiplicity.
+     */
+    inline std::vector<complex1000> roots(std::vector<complex1000> coefficients) {
+        const auto leading{std::ranges::find_if(coefficients, [](const complex1000 &c) { return c != constants::complex_zero; })};
+        coefficients.erase(coefficients.begin(), leading);
+        std::size_t zero_roots{0};
+        while (!coefficients.empty() && coefficients.back() == constants::complex_zero) {
+            coefficients.pop_back();
+            ++zero_roots;
+        }
+        if (coefficients.empty())
+            throw std::runtime_error("Every number is a root of the zero polynomial !");
+        const std::size_t degree{coefficients.size() - 1};
+        const bool real_coefficients{
+            std::ranges::all_of(coefficients, [](const complex1000 &c) { return c.imag() == 0; })
+        };
+        const mpfr_prec_t target_bits{precision::float1000_bits};
+
+        std::vector<ComplexRegister> z;
+        std::vector<ComplexRegister> next;
+        if (degree > 0) {
+            // start on a circle of the radius of the geometric mean of the roots, off the real axis.
+            double radius{std::pow(std::abs(static_cast<double>(abs(coefficients.back())) /
+                                            static_cast<double>(abs(coefficients.front()))), 1.0 / degree)};
+            if (!std::isfinite(radius) || radius == 0)
+                radius = 1;
+            for (std::size_t k = 0; k < degree; ++k) {
+                const double angle{2 * std::numbers::pi * k / degree + 0.7};
+                z.emplace_back(initial_bits);
+                mpfr_set_d(z.back().re.get(), radius * std::cos(angle), MPFR_RNDN);
+                mpfr_set_d(z.back().im.get(), radius * std::sin(angle), MPFR_RNDN);
+                next.emplace_back(initial_bits);
+            }
+        }
+
+        std::vector<char> converged(degree);
+        for (mpfr_prec_t bits = initial_bits; degree > 0; bits = std::min(target_bits, bits * 2)) {
+            std::vector<ComplexRegister> c;
+            for (const auto &coefficient: coefficients) {
+                c.emplace_back(bits);
+                mpfr_set(c.back().re.get(), coefficient.real().backend().data(), MPFR_RNDN);
+                mpfr_set(c.back().im.get(), coefficient.imag().backend().data(), MPFR_RNDN);
+            }
+            for (std::size_t k = 0; k < degree; ++k) {
+                z[k].raise_precision(bits);
+                next[k].raise_precision(bits);
+            }
+            std::vector<AberthWorkspace> workspaces;
+            for (std::size_t w = 0; w < parallel::worker_count(); ++w)
+                workspaces.emplace_back(bits);
+            // multiple roots only converge linearly, so the iterations are capped rather than run to the tolerance.
+            const std::size_t max_iterations{bits == initial_bits ? 1000u : 64u};
+            for (std::size_t iteration = 0; iteration < max_iterations; ++iteration) {
+                parallel::parallel_for(degree, [&](const std::size_t k, const std::size_t worker) {
+                    AberthWorkspace &ws{workspaces[worker]};
+                    mpfr_set(ws.value.re.get(), c[0].re.get(), MPFR_RNDN);
+                    mpfr_set(ws.value.im.get(), c[0].im.get(), MPFR_RNDN);
+                    mpfr_set_zero(ws.derivative.re.get(), 1);
+                    mpfr_set_zero(ws.derivative.im.get(), 1);
+                    for (std::size_t i = 1; i <= degree; ++i) {
+                        ws.multiply(ws.derivative, ws.derivative, z[k]);
+                        mpfr_add(ws.derivative.re.get(), ws.derivative.re.get(), ws.value.re.get(), MPFR_RNDN);
+                        mpfr_add(ws.derivative.im.get(), ws.derivative.im.get(), ws.value.im.get(), MPFR_RNDN);
+                        ws.multiply(ws.value, ws.value, z[k]);
+                        mpfr_add(ws.value.re.get(), ws.value.re.get(), c[i].re.get(), MPFR_RNDN);
+                        mpfr_add(ws.value.im.get(), ws.value.im.get(), c[i].im.get(), MPFR_RNDN);
+                    }
+                    if (ws.value.is_zero() || ws.derivative.is_zero()) {
+                        // an exact root, or a critical point where the step is undefined: keep the approximation.
+                        mpfr_set(next[k].re.get(), z[k].re.get(), MPFR_RNDN);
+                        mpfr_set(next[k].im.get(), z[k].im.get(), MPFR_RNDN);
+                        converged[k] = ws.value.is_zero();
+                        return;
+                    }
+                    ws.divide(ws.value, ws.value, ws.derivative); // Newton correction p/p'
+                    mpfr_set_zero(ws.sum.re.get(), 1);
+                    mpfr_set_zero(ws.sum.im.get(), 1);
+                    for (std::size_t j = 0; j < degree; ++j) {
+                        if (j == k)
+                            continue;
+                        mpfr_sub(ws.term.re.get(), z[k].re.get(), z[j].re.get(), MPFR_RNDN);
+                        mpfr_sub(ws.term.im.get(), z[k].im.get(), z[j].im.get(), MPFR_RNDN);
+                        if (!ws.term.is_zero())
+                            ws.add_reciprocal(ws.term);
+                    }
+                    // step = N / (1 - N * sum)
+                    ws.multiply(ws.term, ws.value, ws.sum);
+                    mpfr_ui_sub(ws.term.re.get(), 1, ws.term.re.get(), MPFR_RNDN);
+                    mpfr_neg(ws.term.im.get(), ws.term.im.get(), MPFR_RNDN);
+                    if (!ws.term.is_zero())
+                        ws.divide(ws.value, ws.value, ws.term);
+                    mpfr_sub(next[k].re.get(), z[k].re.get(), ws.value.re.get(), MPFR_RNDN);
+                    mpfr_sub(next[k].im.get(), z[k].im.get(), ws.value.im.get(), MPFR_RNDN);
+                    // converged when |step| <= |z| * 2^-(bits - 4)
+                    ws.squared_magnitude(ws.first.get(), ws.value);
+                    ws.squared_magnitude(ws.second.get(), z[k]);
+                    mpfr_mul_2si(ws.second.get(), ws.second.get(), -2 * (bits - 4), MPFR_RNDN);
+                    converged[k] = mpfr_lessequal_p(ws.first.get(), ws.second.get());
+                });
+                std::swap(z, next);
+                if (std::ranges::all_of(converged, [](const char done) { return done != 0; }))
+                    break;
+            }
+            if (bits == target_bits)
+                break;
+        }
+
+        std::vector<complex1000> result(zero_roots, constants::complex_zero);
+        for (const auto &root: z) {
+            float1000 re, im;
+            mpfr_set(re.backend().data(), root.re.get(), MPFR_RNDN);
+            mpfr_set(im.backend().data(), root.im.get(), MPFR_RNDN);
+            // the roots of a real polynomial are real or come in conjugate pairs, so an imaginary part at the level
+            // of the rounding errors is dropped.
+            if (real_coefficients && mpfr_cmp_ui(im.backend().data(), 0) != 0 &&
+                fabs(im) <= fabs(re) * std::numeric_limits<float1000>::epsilon() * 1024)
+                im = 0;
+            result.emplace_back(re, im);
+        }
+        std::ranges::sort(result, [](const complex1000 &a, const complex1000 &b) {
+            return a.real() != b.real() ? a.real() < b.real() : a.imag() < b.imag();
+        });
+        return result;
+    }
+} // namespace mmqli::core::polynomial
+#endif // POLYNOMIAL_HPP
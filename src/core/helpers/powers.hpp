@@ -0,0 +1,185 @@
+#ifndef POWERS_HPP
+#define POWERS_HPP
+
+#include "boost_fwd.hpp"
+
+/**
+ * @brief This namespace contains the kernels of POWER and ROOT. The exponent is classified first, and the general
+ * pow (exp and log, for a complex exponent) only runs when no cheaper kernel applies: an integer exponent is a
+ * binary exponentiation, 1/2 and 1/3 are a square or cube root, an integer root is MPFR's rootn, and a complex
+ * number raised to a real exponent goes through its modulus and argument, which only takes real kernels.
+ */
+namespace mmqli::core::powers {
+    /**
+     * @brief The largest magnitude of an integer exponent of a complex number taken by binary exponentiation, at most
+     * 64 multiplications and squarings, each rounded once.
+     */
+    constexpr long largest_binary_exponent{1L << 32};
+
+    enum class Exponent : unsigned char { integer, half, negative_half, third, general };
+
+    /**
+     * @brief The class of the real exponent @p b, @p n is set to its value when it is an integer that fits a long.
+     * An exponent that is 1/3 rounded to its precision is taken to be 1/3.
+     */
+    inline Exponent classify(mpfr_srcptr b, long &n) {
+        if (!mpfr_number_p(b))
+            return Exponent::general;
+        if (mpfr_integer_p(b) && mpfr_fits_slong_p(b, MPFR_RNDN)) {
+            n = mpfr_get_si(b, MPFR_RNDN);
+            return Exponent::integer;
+        }
+        if (mpfr_cmp_d(b, 0.5) == 0)
+            return Exponent::half;
+        if (mpfr_cmp_d(b, -0.5) == 0)
+            return Exponent::negative_half;
+        if (mpfr_get_exp(b) == -1 && mpfr_sgn(b) > 0) { // b in [1/4, 1/2)
+            mpfr_t third;
+            mpfr_init2(third, mpfr_get_prec(b));
+            mpfr_set_ui(third, 1, MPFR_RNDN);
+            mpfr_div_ui(third, third, 3, MPFR_RNDN);
+            const bool is_third{mpfr_equal_p(third, b) != 0};
+            mpfr_clear(third);
+            if (is_third)
+                return Exponent::third;
+        }
+        return Exponent::general;
+    }
+
+    /**
+     * @brief @p r = @p a ^ @p b for real numbers, rounded to nearest like mpfr_pow, which handles the zeros, the
+     * infinities and the negative bases the square and cube roots would treat differently.
+     */
+    inline void power(mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b) {
+        long n{0};
+        const Exponent exponent{classify(b, n)};
+        if (exponent == Exponent::integer) {
+            mpfr_pow_si(r, a, n, MPFR_RNDN);
+            return;
+        }
+        if (mpfr_regular_p(a) && mpfr_sgn(a) > 0) {
+            switch (exponent) {
+                case Exponent::half: mpfr_sqrt(r, a, MPFR_RNDN); return;
+                case Exponent::negative_half: mpfr_rec_sqrt(r, a, MPFR_RNDN); return;
+                case Exponent::third: mpfr_cbrt(r, a, MPFR_RNDN); return;
+                default: break;
+            }
+        }
+        mpfr_pow(r, a, b, MPFR_RNDN);
+    }
+
+    inline float1000 power(const float1000 &a, const float1000 &b) {
+        float1000 r;
+        power(r.backend().data(), a.backend().data(), b.backend().data());
+        return r;
+    }
+
+    /**
+     * @brief @p r = the @p b th root of @p a, a^(1/b), for real numbers. An integer root is MPFR's rootn, which also
+     * gives the real odd roots of a negative number. @p scratch holds 1/b otherwise. @p b is not zero.
+     */
+    inline void root(mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_ptr scratch) {
+        if (mpfr_integer_p(b) && mpfr_fits_slong_p(b, MPFR_RNDN)) {
+            const long n{mpfr_get_si(b, MPFR_RNDN)};
+            if (n == 1) {
+                mpfr_set(r, a, MPFR_RNDN);
+                return;
+            }
+            if (n == 2) {
+                mpfr_sqrt(r, a, MPFR_RNDN);
+                return;
+            }
+            // -n overflows for the smallest long, its magnitude is taken in unsigned arithmetic.
+            const unsigned long magnitude{n < 0 ? 0ul - static_cast<unsigned long>(n) : static_cast<unsigned long>(n)};
+            mpfr_rootn_ui(r, a, magnitude, MPFR_RNDN);
+            if (n < 0)
+                mpfr_ui_div(r, 1, r, MPFR_RNDN);
+            return;
+        }
+        mpfr_ui_div(scratch, 1, b, MPFR_RNDN);
+        mpfr_pow(r, a, scratch, MPFR_RNDN);
+    }
+
+    inline float1000 root(const float1000 &a, const float1000 &b) {
+        float1000 r;
+        float1000 scratch;
+        root(r.backend().data(), a.backend().data(), b.backend().data(), scratch.backend().data());
+        return r;
+    }
+
+    namespace detail {
+        inline float1000 modulus(const complex1000 &z) {
+            float1000 m;
+            mpfr_hypot(m.backend().data(), z.real().backend().data(), z.imag().backend().data(), MPFR_RNDN);
+            return m;
+        }
+
+        inline float1000 argument(const complex1000 &z) {
+            float1000 theta;
+            mpfr_atan2(theta.backend().data(), z.imag().backend().data(), z.real().backend().data(), MPFR_RNDN);
+            return theta;
+        }
+
+        // modulus * (cos(angle) + i sin(angle)), the sine and the cosine from one MPFR call.
+        inline complex1000 from_polar(const float1000 &modulus, const float1000 &angle) {
+            float1000 real_part;
+            float1000 imaginary_part;
+            mpfr_sin_cos(imaginary_part.backend().data(), real_part.backend().data(), angle.backend().data(),
+                         MPFR_RNDN);
+            real_part *= modulus;
+            imaginary_part *= modulus;
+            return {std::move(real_part), std::move(imaginary_part)};
+        }
+
+        // z^n by squaring, z^-n as the reciprocal of z^n.
+        inline complex1000 binary_power(const complex1000 &z, const long n) {
+            complex1000 result{float1000{1}, float1000{0}};
+            complex1000 base{z};
+            unsigned long m{n < 0 ? 0ul - static_cast<unsigned long>(n) : static_cast<unsigned long>(n)};
+            while (m != 0) {
+                if (m & 1)
+                    result *= base;
+                m >>= 1;
+                if (m != 0)
+                    base *= base;
+            }
+            if (n < 0)
+                result = complex1000{float1000{1}, float1000{0}} / result;
+            return result;
+        }
+    }
+
+    /**
+     * @brief z^w for complex numbers. A nonnegative real base and a real exponent stay real, as does a negative real
+     * base raised to an integer; the general pow only runs for a complex exponent.
+     */
+    inline complex1000 power(const complex1000 &z, const complex1000 &w) {
+        if (w.imag() != 0)
+            return std::pow(z, w);
+        long n{0};
+        const Exponent exponent{classify(w.real().backend().data(), n)};
+        if (z.imag() == 0 && (z.real() >= 0 || exponent == Exponent::integer))
+            return {power(z.real(), w.real()), float1000{0}};
+        if (exponent == Exponent::integer && n >= -largest_binary_exponent && n <= largest_binary_exponent)
+            return detail::binary_power(z, n);
+        if (exponent == Exponent::half)
+            return std::sqrt(z);
+        // |z|^w (cos(w arg z) + i sin(w arg z))
+        return detail::from_polar(power(detail::modulus(z), w.real()), detail::argument(z) * w.real());
+    }
+
+    /**
+     * @brief The principal @p w th root of @p z, z^(1/w). A real exponent takes the root of the modulus and divides
+     * the argument, with MPFR's rootn for an integer root; only a complex exponent runs the general pow.
+     */
+    inline complex1000 root(const complex1000 &z, const complex1000 &w) {
+        if (w.imag() != 0)
+            return std::pow(z, complex1000{float1000{1}, float1000{0}} / w);
+        if (z.imag() == 0 && z.real() >= 0)
+            return {root(z.real(), w.real()), float1000{0}};
+        if (w.real() == 2)
+            return std::sqrt(z);
+        return detail::from_polar(root(detail::modulus(z), w.real()), detail::argument(z) / w.real());
+    }
+} // namespace mmqli::core::powers
+#endif // POWERS_HPP
@@ -0,0 +1,62 @@
+#ifndef PRECISION_HPP
+#define PRECISION_HPP
+
+#include <limits>
+#include <utility>
+#include "boost_fwd.hpp"
+
+namespace mmqli::core::precision {
+    /**
+     * @brief The working precision of float1000 in bits.
+     */
+    constexpr mpfr_prec_t float1000_bits{std::numeric_limits<float1000>::digits};
+
+    /**
+     * @brief An MPFR variable of a chosen precision with scoped lifetime. The kernels that work below or above the
+     * precision of float1000 keep their temporaries in registers.
+     */
+    class Register {
+        mpfr_t value{};
+        bool owned{false};
+
+    public:
+        explicit Register(const mpfr_prec_t bits = float1000_bits) : owned(true) {
+            mpfr_init2(value, bits);
+            mpfr_set_zero(value, 1);
+        }
+
+        Register(const Register &) = delete;
+        Register &operator=(const Register &) = delete;
+
+        Register(Register &&other) noexcept : owned(std::exchange(other.owned, false)) {
+            value[0] = other.value[0];
+        }
+
+        Register &operator=(Register &&other) noexcept {
+            if (this != &other) {
+                std::swap(value[0], other.value[0]);
+                std::swap(owned, other.owned);
+            }
+            return *this;
+        }
+
+        ~Register() {
+            if (owned)
+                mpfr_clear(value);
+        }
+
+        mpfr_ptr get() { return value; }
+        [[nodiscard]] mpfr_srcptr get() const { return value; }
+        [[nodiscard]] mpfr_prec_t bits() const { return mpfr_get_prec(value); }
+
+        /**
+         * @brief Rounds the register to a float1000.
+         */
+        [[nodiscard]] float1000 to_float1000() const {
+            float1000 result;
+            mpfr_set(result.backend().data(), value, MPFR_RNDN);
+            return result;
+        }
+    };
+} // namespace mmqli::core::precision
+#endif // PRECISION_HPP
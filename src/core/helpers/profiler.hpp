@@ -0,0 +1,162 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief This namespace contains the timers of the pipeline stages (tokenize, parse, evaluate, format) and of every
+ * opcode evaluated by the Core. The timers are compiled in but disabled by default: a disabled timer costs one
+ * relaxed atomic load. Once enabled, every timer records its duration under its category and name, and optionally
+ * a Chrome trace event that can be opened in chrome://tracing or Perfetto.
+ */
+namespace mmqli::core::profiler {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The statistics of one timer, durations in nanoseconds.
+     */
+    struct Summary {
+        std::string category;
+        std::string name;
+        std::size_t count{0};
+        std::uint64_t total{0};
+        std::uint64_t p50{0};
+        std::uint64_t p99{0};
+    };
+
+    namespace detail {
+        struct TraceEvent {
+            std::string category;
+            std::string name;
+            std::uint64_t start; // nanoseconds since the epoch of the profiler
+            std::uint64_t duration;
+            std::size_t thread;
+        };
+
+        inline std::atomic<bool> enabled{false};
+        inline std::atomic<bool> tracing{false};
+        inline std::mutex mutex;
+        inline std::map<std::pair<std::string, std::string>, std::vector<std::uint64_t> > samples;
+        inline std::vector<TraceEvent> events;
+        inline const Clock::time_point epoch{Clock::now()};
+
+        inline std::size_t thread_index() {
+            static std::atomic<std::size_t> next{0};
+            static thread_local const std::size_t index{next.fetch_add(1)};
+            return index;
+        }
+
+        inline std::uint64_t nanoseconds(const Clock::duration duration) {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+
+        inline void record(const std::string_view category, const std::string_view name, const Clock::time_point start,
+                           const Clock::time_point stop) {
+            const std::uint64_t duration{nanoseconds(stop - start)};
+            const std::scoped_lock lock(mutex);
+            samples[{std::string{category}, std::string{name}}].push_back(duration);
+            if (tracing.load(std::memory_order_relaxed))
+                events.push_back({std::string{category}, std::string{name}, nanoseconds(start - epoch), duration,
+                                  thread_index()});
+        }
+
+        inline void escape(std::string &out, const std::string_view text) {
+            for (const char c: text) {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+            }
+        }
+    }
+
+    /**
+     * @brief Turns the timers on, with @p trace the trace events are kept as well.
+     */
+    inline void enable(const bool trace = false) {
+        detail::tracing.store(trace, std::memory_order_relaxed);
+        detail::enabled.store(true, std::memory_order_relaxed);
+    }
+
+    inline bool enabled() { return detail::enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Times the enclosing scope under @p category and @p name, when the profiler is enabled. The name is
+     * only read, it must outlive the scope.
+     */
+    class Scope {
+        std::string_view category;
+        std::string_view name;
+        bool active{enabled()};
+        Clock::time_point start{active ? Clock::now() : Clock::time_point{}};
+
+    public:
+        Scope(const std::string_view category, const std::string_view name) : category(category), name(name) {}
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            if (active)
+                detail::record(category, name, start, Clock::now());
+        }
+    };
+
+    /**
+     * @brief The statistics of every timer recorded so far, ordered by category and name.
+     */
+    inline std::vector<Summary> summary() {
+        std::vector<Summary> rows;
+        const std::scoped_lock lock(detail::mutex);
+        rows.reserve(detail::samples.size());
+        for (const auto &[key, durations]: detail::samples) {
+            std::vector<std::uint64_t> sorted{durations};
+            std::ranges::sort(sorted);
+            Summary row{key.first, key.second, sorted.size()};
+            for (const std::uint64_t duration: sorted)
+                row.total += duration;
+            row.p50 = sorted[(sorted.size() - 1) * 50 / 100];
+            row.p99 = sorted[(sorted.size() - 1) * 99 / 100];
+            rows.push_back(std::move(row));
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Writes the recorded trace events to @p path in the Chrome trace event format, as complete events.
+     * @return false when the file could not be written.
+     */
+    inline bool write_trace(const std::string &path) {
+        std::string json{"{\"traceEvents\":["};
+        {
+            const std::scoped_lock lock(detail::mutex);
+            for (const auto &[category, name, start, duration, thread]: detail::events) {
+                json += "{\"name\":\"";
+                detail::escape(json, name);
+                json += "\",\"cat\":\"";
+                detail::escape(json, category);
+                // the format counts in microseconds, fractions are allowed.
+                json += "\",\"ph\":\"X\",\"ts\":" + std::to_string(start / 1000) + '.' +
+                        std::to_string(1000 + start % 1000).substr(1) + ",\"dur\":" + std::to_string(duration / 1000) +
+                        '.' + std::to_string(1000 + duration % 1000).substr(1) + ",\"pid\":1,\"tid\":" +
+                        std::to_string(thread) + "},";
+            }
+        }
+        if (json.back() == ',')
+            json.pop_back();
+        json += "],\"displayTimeUnit\":\"ms\"}\n";
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        return static_cast<bool>(file.write(json.data(), static_cast<std::streamsize>(json.size())));
+    }
+} // namespace mmqli::core::profiler
+#endif // PROFILER_HPP
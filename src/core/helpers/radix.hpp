@@ -0,0 +1,209 @@
+#ifndef RADIX_HPP
+#define RADIX_HPP
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <gmpxx.h>
+#include "boost_fwd.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the conversions between huge numbers and their decimal digits: the exact integers,
+ * the digits of a constant and the long literals of a query. A number is split in two around a power of ten
+ * 10^(512 2^k), the two halves are converted on their own and the halves of the halves too, until they are short
+ * enough for GMP's quadratic conversion. The powers of ten are computed once, each is the square of the previous one,
+ * and shared by every conversion and every thread.
+ *
+ * The digits are handed to a sink a chunk at a time, from the first to the last, so a conversion never holds a second
+ * copy of the digits: the sink appends them to the answer, or writes them out. The literals are recognised by a scan of
+ * their characters, std::regex matches a run of digits recursively and overflows the stack on a few ten thousand
+ * digits.
+ */
+namespace mmqli::core::radix {
+    /**
+     * @brief The digits of the shortest part, the conversion of a part up to twice as long is left to GMP.
+     */
+    constexpr std::size_t leaf_digits{512};
+
+    /**
+     * @brief 10^(leaf_digits 2^k), computed on first use and then shared. The table only grows, so the powers are
+     * never moved.
+     */
+    inline const mpz_class &power(const std::size_t k) {
+        static std::mutex table_mutex;
+        static std::deque<mpz_class> table;
+        const std::scoped_lock lock(table_mutex);
+        if (table.empty())
+            mpz_ui_pow_ui(table.emplace_back().get_mpz_t(), 10, leaf_digits);
+        while (table.size() <= k)
+            table.push_back(table.back() * table.back());
+        return table[k];
+    }
+
+    /**
+     * @brief The largest k for which leaf_digits 2^k is below @p digits.
+     */
+    inline std::size_t split_level(const std::size_t digits) {
+        std::size_t k{0};
+        while (leaf_digits << (k + 1) < digits)
+            ++k;
+        return k;
+    }
+
+    namespace detail {
+        // the digits of 0 <= n < 10^width, padded with zeros to width digits.
+        template<typename Sink>
+        void write_padded(mpz_srcptr n, const std::size_t width, Sink &sink) {
+            if (width == 0)
+                return;
+            if (width <= 2 * leaf_digits) {
+                char buffer[2 * leaf_digits + 2];
+                mpz_get_str(buffer, 10, n);
+                const std::string_view digits{buffer};
+                static const std::string zeros(2 * leaf_digits, '0');
+                if (digits.size() < width)
+                    sink(std::string_view{zeros}.substr(0, width - digits.size()));
+                sink(digits);
+                return;
+            }
+            const std::size_t k{split_level(width)};
+            mpz_class high, low;
+            mpz_tdiv_qr(high.get_mpz_t(), low.get_mpz_t(), n, power(k).get_mpz_t());
+            write_padded(high.get_mpz_t(), width - (leaf_digits << k), sink);
+            write_padded(low.get_mpz_t(), leaf_digits << k, sink);
+        }
+
+        // the digits of n > 0, without leading zeros.
+        template<typename Sink>
+        void write(mpz_srcptr n, Sink &sink) {
+            const std::size_t digits{mpz_sizeinbase(n, 10)}; // exact or one more
+            if (digits <= 2 * leaf_digits + 1) {
+                char buffer[2 * leaf_digits + 2];
+                sink(std::string_view{mpz_get_str(buffer, 10, n)});
+                return;
+            }
+            const std::size_t k{split_level(digits - 1)}; // the high part is never 0
+            mpz_class high, low;
+            mpz_tdiv_qr(high.get_mpz_t(), low.get_mpz_t(), n, power(k).get_mpz_t());
+            write(high.get_mpz_t(), sink);
+            write_padded(low.get_mpz_t(), leaf_digits << k, sink);
+        }
+
+        inline void read(mpz_ptr n, const std::string_view digits) {
+            if (digits.size() <= 2 * leaf_digits) {
+                char buffer[2 * leaf_digits + 1];
+                digits.copy(buffer, digits.size());
+                buffer[digits.size()] = '\0';
+                mpz_set_str(n, buffer, 10);
+                return;
+            }
+            const std::size_t k{split_level(digits.size())};
+            const std::size_t low_digits{leaf_digits << k};
+            mpz_class low;
+            read(n, digits.substr(0, digits.size() - low_digits));
+            read(low.get_mpz_t(), digits.substr(digits.size() - low_digits));
+            mpz_mul(n, n, power(k).get_mpz_t());
+            mpz_add(n, n, low.get_mpz_t());
+        }
+    } // namespace detail
+
+    /**
+     * @brief Hands the decimal digits of @p n, with its sign, to @p sink, a callable taking a std::string_view.
+     */
+    template<typename Sink>
+    void write(mpz_srcptr n, Sink &&sink) {
+        if (mpz_sgn(n) == 0) {
+            sink(std::string_view{"0"});
+            return;
+        }
+        if (mpz_sgn(n) < 0) {
+            sink(std::string_view{"-"});
+            mpz_class magnitude;
+            mpz_neg(magnitude.get_mpz_t(), n);
+            detail::write(magnitude.get_mpz_t(), sink);
+            return;
+        }
+        detail::write(n, sink);
+    }
+
+    /**
+     * @brief Hands @p value with @p digits digits after the decimal point to @p sink. The expansion is truncated, not
+     * rounded: the digits are the ones of floor(|value| 10^digits), whose product is exact.
+     */
+    template<typename Sink>
+    void write_fixed(mpfr_srcptr value, const std::size_t digits, Sink &&sink) {
+        mpz_class scale, scaled, integral, fraction;
+        mpz_ui_pow_ui(scale.get_mpz_t(), 10, digits);
+        precision::Register product{mpfr_get_prec(value) +
+                                     static_cast<mpfr_prec_t>(mpz_sizeinbase(scale.get_mpz_t(), 2))};
+        mpfr_mul_z(product.get(), value, scale.get_mpz_t(), MPFR_RNDZ);
+        mpfr_abs(product.get(), product.get(), MPFR_RNDN);
+        mpfr_get_z(scaled.get_mpz_t(), product.get(), MPFR_RNDZ);
+        mpz_tdiv_qr(integral.get_mpz_t(), fraction.get_mpz_t(), scaled.get_mpz_t(), scale.get_mpz_t());
+        if (mpfr_signbit(value) && mpz_sgn(scaled.get_mpz_t()) != 0)
+            sink(std::string_view{"-"});
+        write(integral.get_mpz_t(), sink);
+        sink(std::string_view{"."});
+        detail::write_padded(fraction.get_mpz_t(), digits, sink);
+    }
+
+    /**
+     * @brief The integer written with the decimal digits @p digits, which are not checked.
+     */
+    inline mpz_class integer(const std::string_view digits) {
+        mpz_class n;
+        detail::read(n.get_mpz_t(), digits);
+        return n;
+    }
+
+    /**
+     * @brief The length of the real literal @code -?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)? @endcode at the start of
+     * @p text, 0 when there is none.
+     */
+    inline std::size_t real_length(const std::string_view text) {
+        std::size_t at{0};
+        const auto digits{
+            [&] {
+                const std::size_t first{at};
+                while (at < text.size() && text[at] >= '0' && text[at] <= '9')
+                    ++at;
+                return at > first;
+            }
+        };
+        // an optional part that is dropped when it is not complete.
+        const auto optional{
+            [&](const auto &part) {
+                const std::size_t start{at};
+                if (!part())
+                    at = start;
+            }
+        };
+        const auto fraction{[&] { return at < text.size() && text[at] == '.' && (++at, digits()); }};
+        if (at < text.size() && text[at] == '-')
+            ++at;
+        if (!digits())
+            return 0;
+        optional(fraction);
+        optional([&] {
+            if (at + 1 >= text.size() || (text[at] != 'E' && text[at] != 'e') || (text[at + 1] != '+' && text[at + 1] != '-'))
+                return false;
+            at += 2;
+            if (!digits())
+                return false;
+            optional(fraction);
+            return true;
+        });
+        return at;
+    }
+
+    /**
+     * @brief Whether @p text is a real literal, @code -?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)? @endcode.
+     */
+    inline bool real_literal(const std::string_view text) {
+        return !text.empty() && real_length(text) == text.size();
+    }
+} // namespace mmqli::core::radix
+#endif // RADIX_HPP
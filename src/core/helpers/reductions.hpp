@@ -0,0 +1,284 @@
+#ifndef REDUCTIONS_HPP
+#define REDUCTIONS_HPP
+
+#include <vector>
+#include <stdexcept>
+#include "boost_fwd.hpp"
+#include "constants.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+
+namespace mmqli::core::reductions {
+    /**
+     * @brief The number of elements reduced sequentially by one leaf of the reduction tree. It is a constant so that
+     * the shape of the tree, and therefore every rounding, depends only on the length of the input and never on the
+     * number of threads.
+     */
+    constexpr std::size_t leaf_size{1024};
+
+    /**
+     * @brief The working precision of the compensated reductions. A sum carried as an unevaluated pair (sum, error)
+     * holds about twice the bits of its components, so a little over half the precision of float1000 is enough.
+     */
+    constexpr mpfr_prec_t compensated_bits{precision::float1000_bits / 2 + 64};
+
+    /**
+     * @brief Reduces @p count elements over a fixed tree. The leaves are consecutive runs of @code leaf_size @endcode
+     * elements reduced left to right, the partial results are then combined pairwise, level by level, as (0,1),
+     * (2,3), ... Leaves and the pairs of each level are spread across the worker threads, every partial has its own
+     * slot, so the result is bit-identical whatever the number of threads.
+     * @param count The number of input elements.
+     * @param leaf A callable of the form @code Partial(std::size_t begin, std::size_t end) @endcode
+     * @param combine A callable of the form @code void(Partial &left, const Partial &right) @endcode
+     * @return The partial result at the root of the tree.
+     */
+    template<typename Partial, typename Leaf, typename Combine>
+    Partial tree_reduce(const std::size_t count, Leaf &&leaf, Combine &&combine) {
+        if (count == 0)
+            throw std::runtime_error("Cannot reduce an empty batch !");
+        const std::size_t leaves{(count + leaf_size - 1) / leaf_size};
+        std::vector<Partial> partials(leaves);
+        parallel::parallel_for(leaves, [&](const std::size_t i) {
+            partials[i] = leaf(i * leaf_size, std::min(count, (i + 1) * leaf_size));
+        });
+        for (std::size_t stride = 1; stride < leaves; stride *= 2) {
+            const std::size_t pairs{(leaves + 2 * stride - 1) / (2 * stride)};
+            parallel::parallel_for(pairs, [&](const std::size_t pair) {
+                const std::size_t left{pair * 2 * stride};
+                if (const std::size_t right{left + stride}; right < leaves)
+                    combine(partials[left], partials[right]);
+            });
+        }
+        return std::move(partials.front());
+    }
+
+    /**
+     * @brief A sum carried as the unevaluated pair sum + error at @code compensated_bits @endcode. Every addition is
+     * done with the error free transformation TwoSum, so no rounding error is lost, only the error register itself
+     * is rounded.
+     */
+    class CompensatedSum {
+        precision::Register sum{compensated_bits};
+        precision::Register error{compensated_bits};
+        // scratch registers, allocated once per partial rather than once per term.
+        precision::Register next{compensated_bits};
+        precision::Register b_virtual{compensated_bits};
+        precision::Register a_round_off{compensated_bits};
+        precision::Register b_round_off{compensated_bits};
+        precision::Register head{compensated_bits};
+        precision::Register tail{compensated_bits};
+
+        // TwoSum of sum and term, term must be representable at compensated_bits.
+        void two_sum(mpfr_srcptr term) {
+            mpfr_add(next.get(), sum.get(), term, MPFR_RNDN);
+            mpfr_sub(b_virtual.get(), next.get(), sum.get(), MPFR_RNDN);
+            mpfr_sub(a_round_off.get(), next.get(), b_virtual.get(), MPFR_RNDN);
+            mpfr_sub(a_round_off.get(), sum.get(), a_round_off.get(), MPFR_RNDN);
+            mpfr_sub(b_round_off.get(), term, b_virtual.get(), MPFR_RNDN);
+            mpfr_add(a_round_off.get(), a_round_off.get(), b_round_off.get(), MPFR_RNDN);
+            mpfr_add(error.get(), error.get(), a_round_off.get(), MPFR_RNDN);
+            mpfr_swap(sum.get(), next.get());
+        }
+
+        // splits term into a head at the working precision and the remainder, which is exact because float1000 has
+        // less than twice the bits of the working precision.
+        void split(mpfr_srcptr term) {
+            mpfr_set(head.get(), term, MPFR_RNDN);
+            mpfr_sub(tail.get(), term, head.get(), MPFR_RNDN);
+        }
+
+    public:
+        /**
+         * @brief Adds a term of any precision up to float1000. The head of the term goes through TwoSum and the
+         * remainder goes into the error register.
+         */
+        void add(mpfr_srcptr term) {
+            split(term);
+            mpfr_add(error.get(), error.get(), tail.get(), MPFR_RNDN);
+            two_sum(head.get());
+        }
+
+        /**
+         * @brief Adds the square of @p term. The square of the head is split exactly with an FMA (TwoProduct), the
+         * cross terms are small enough to be rounded once into the error register.
+         */
+        void add_square(mpfr_srcptr term) {
+            split(term);
+            // b_round_off = tail*(2*head + tail), i-e the cross terms of (head + tail)^2
+            mpfr_mul_2ui(b_round_off.get(), head.get(), 1, MPFR_RNDN);
+            mpfr_add(b_round_off.get(), b_round_off.get(), tail.get(), MPFR_RNDN);
+            mpfr_mul(b_round_off.get(), b_round_off.get(), tail.get(), MPFR_RNDN);
+            mpfr_add(error.get(), error.get(), b_round_off.get(), MPFR_RNDN);
+            mpfr_sqr(tail.get(), head.get(), MPFR_RNDN);
+            mpfr_fms(b_round_off.get(), head.get(), head.get(), tail.get(), MPFR_RNDN); // exact error of head^2
+            mpfr_add(error.get(), error.get(), b_round_off.get(), MPFR_RNDN);
+            two_sum(tail.get());
+        }
+
+        void merge(const CompensatedSum &other) {
+            two_sum(other.sum.get());
+            mpfr_add(error.get(), error.get(), other.error.get(), MPFR_RNDN);
+        }
+
+        /**
+         * @brief Rounds sum + error to a float1000.
+         */
+        [[nodiscard]] float1000 to_float1000() const {
+            float1000 result;
+            mpfr_add(result.backend().data(), sum.get(), error.get(), MPFR_RNDN);
+            return result;
+        }
+    };
+
+    /**
+     * @brief Sum of a batch of real numbers at the precision of float1000.
+     */
+    inline float1000 sum(const std::vector<float1000> &operands) {
+        return tree_reduce<float1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+            float1000 partial{operands[begin]};
+            for (std::size_t i = begin + 1; i < end; ++i)
+                mpfr_add(partial.backend().data(), partial.backend().data(), operands[i].backend().data(), MPFR_RNDN);
+            return partial;
+        }, [](float1000 &left, const float1000 &right) {
+            mpfr_add(left.backend().data(), left.backend().data(), right.backend().data(), MPFR_RNDN);
+        });
+    }
+
+    /**
+     * @brief Product of a batch of real numbers at the precision of float1000.
+     */
+    inline float1000 product(const std::vector<float1000> &operands) {
+        return tree_reduce<float1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+            float1000 partial{operands[begin]};
+            for (std::size_t i = begin + 1; i < end; ++i)
+                mpfr_mul(partial.backend().data(), partial.backend().data(), operands[i].backend().data(), MPFR_RNDN);
+            return partial;
+        }, [](float1000 &left, const float1000 &right) {
+            mpfr_mul(left.backend().data(), left.backend().data(), right.backend().data(), MPFR_RNDN);
+        });
+    }
+
+    /**
+     * @brief Arithmetic mean of a batch of real numbers.
+     */
+    inline float1000 mean(const std::vector<float1000> &operands) {
+        float1000 result{sum(operands)};
+        mpfr_div_ui(result.backend().data(), result.backend().data(), operands.size(), MPFR_RNDN);
+        return result;
+    }
+
+    /**
+     * @brief Euclidean norm of a batch of real numbers.
+     */
+    inline float1000 norm(const std::vector<float1000> &operands) {
+        float1000 result{
+            tree_reduce<float1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+                float1000 partial{0};
+                float1000 square;
+                for (std::size_t i = begin; i < end; ++i) {
+                    mpfr_sqr(square.backend().data(), operands[i].backend().data(), MPFR_RNDN);
+                    mpfr_add(partial.backend().data(), partial.backend().data(), square.backend().data(), MPFR_RNDN);
+                }
+                return partial;
+            }, [](float1000 &left, const float1000 &right) {
+                mpfr_add(left.backend().data(), left.backend().data(), right.backend().data(), MPFR_RNDN);
+            })
+        };
+        mpfr_sqrt(result.backend().data(), result.backend().data(), MPFR_RNDN);
+        return result;
+    }
+
+    /**
+     * @brief Compensated sum of a batch of real numbers, evaluated at @code compensated_bits @endcode.
+     */
+    inline float1000 compensated_sum(const std::vector<float1000> &operands) {
+        return tree_reduce<CompensatedSum>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+            CompensatedSum partial;
+            for (std::size_t i = begin; i < end; ++i)
+                partial.add(operands[i].backend().data());
+            return partial;
+        }, [](CompensatedSum &left, const CompensatedSum &right) {
+            left.merge(right);
+        }).to_float1000();
+    }
+
+    /**
+     * @brief Compensated arithmetic mean of a batch of real numbers.
+     */
+    inline float1000 compensated_mean(const std::vector<float1000> &operands) {
+        float1000 result{compensated_sum(operands)};
+        mpfr_div_ui(result.backend().data(), result.backend().data(), operands.size(), MPFR_RNDN);
+        return result;
+    }
+
+    /**
+     * @brief Compensated Euclidean norm of a batch of real numbers.
+     */
+    inline float1000 compensated_norm(const std::vector<float1000> &operands) {
+        float1000 result{
+            tree_reduce<CompensatedSum>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+                CompensatedSum partial;
+                for (std::size_t i = begin; i < end; ++i)
+                    partial.add_square(operands[i].backend().data());
+                return partial;
+            }, [](CompensatedSum &left, const CompensatedSum &right) {
+                left.merge(right);
+            }).to_float1000()
+        };
+        mpfr_sqrt(result.backend().data(), result.backend().data(), MPFR_RNDN);
+        return result;
+    }
+
+    /**
+     * @brief Sum of a batch of complex numbers.
+     */
+    inline complex1000 sum(const std::vector<complex1000> &operands) {
+        return tree_reduce<complex1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+            complex1000 partial{operands[begin]};
+            for (std::size_t i = begin + 1; i < end; ++i)
+                partial += operands[i];
+            return partial;
+        }, [](complex1000 &left, const complex1000 &right) {
+            left += right;
+        });
+    }
+
+    /**
+     * @brief Product of a batch of complex numbers.
+     */
+    inline complex1000 product(const std::vector<complex1000> &operands) {
+        return tree_reduce<complex1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+            complex1000 partial{operands[begin]};
+            for (std::size_t i = begin + 1; i < end; ++i)
+                partial *= operands[i];
+            return partial;
+        }, [](complex1000 &left, const complex1000 &right) {
+            left *= right;
+        });
+    }
+
+    /**
+     * @brief Arithmetic mean of a batch of complex numbers.
+     */
+    inline complex1000 mean(const std::vector<complex1000> &operands) {
+        return sum(operands) / float1000(operands.size());
+    }
+
+    /**
+     * @brief Euclidean norm of a batch of complex numbers, i-e the square root of the sum of |z|^2.
+     */
+    inline float1000 norm(const std::vector<complex1000> &operands) {
+        float1000 result{
+            tree_reduce<float1000>(operands.size(), [&](const std::size_t begin, const std::size_t end) {
+                float1000 partial{0};
+                for (std::size_t i = begin; i < end; ++i)
+                    partial += operands[i].real() * operands[i].real() + operands[i].imag() * operands[i].imag();
+                return partial;
+            }, [](float1000 &left, const float1000 &right) {
+                left += right;
+            })
+        };
+        return float1000{sqrt(result)};
+    }
+} // namespace mmqli::core::reductions
+#endif // REDUCTIONS_HPP
@@ -0,0 +1,378 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "cache.hpp"
+#include "columnar.hpp"
+#include "wire.hpp"
+
+/**
+ * @brief This namespace contains the cache of answers kept on disk across runs, for the scripts that are run again
+ * with most of their queries unchanged. An answer is addressed by a hash of its key: the engine that computed it,
+ * the precision, and the query with the values of its variables substituted. Like the other caches it is only an
+ * accelerator, a file that cannot be read or written is a miss, never an error.
+ *
+ * The answers are appended to a log, and a compact index, sorted by hash, tells where every answer lies in the log.
+ * Both files are memory-mapped when the cache is opened, a lookup is a binary search of the index and a comparison of
+ * the key stored with the answer, nothing else is read from the disk. The index is rewritten when the cache is
+ * closed; the answers appended after the last index, by a run that did not close its cache, are found by reading the
+ * end of the log. Every integer is little-endian:
+ * @code
+ * log:    "MMQLCLOG", u32 version, u32 reserved, then the records
+ * record: u64 hash, u32 key length, u32 answer length, the key, the answer
+ * index:  "MMQLCIDX", u32 version, u32 generation, u64 length of the log it covers, u64 count, then the entries
+ * entry:  u64 hash, u64 offset of the record, u32 generation of its last use, u32 reserved
+ * @endcode
+ * Every run is a generation. When the log outgrows its limit, it is rewritten with the answers used most recently,
+ * down to three quarters of the limit, and the others are evicted.
+ */
+namespace mmqli::core::result_cache {
+    constexpr std::string_view log_magic{"MMQLCLOG"};
+    constexpr std::string_view index_magic{"MMQLCIDX"};
+    constexpr std::uint32_t version{1};
+    constexpr std::size_t log_header_size{16};
+    constexpr std::size_t record_header_size{16};
+    constexpr std::size_t index_header_size{32};
+    constexpr std::size_t entry_size{24};
+    constexpr std::size_t default_limit{std::size_t{256} << 20};
+
+    /**
+     * @brief FNV-1a, the key stored with every answer settles the collisions.
+     */
+    inline std::uint64_t hash(const std::string_view key) {
+        std::uint64_t h{0xcbf29ce484222325};
+        for (const char c: key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3;
+        }
+        return h;
+    }
+
+    inline std::string encode_answers(const std::vector<std::string> &answers) {
+        std::string out;
+        wire::detail::put_unsigned(out, answers.size(), 4);
+        for (const std::string &answer: answers) {
+            wire::detail::put_unsigned(out, answer.size(), 4);
+            out += answer;
+        }
+        return out;
+    }
+
+    inline std::optional<std::vector<std::string> > decode_answers(const std::string_view bytes) {
+        wire::Reader in{bytes};
+        const std::uint64_t count{in.get_unsigned(4)};
+        if (!in.ok() || count > bytes.size())
+            return std::nullopt;
+        std::vector<std::string> answers;
+        answers.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i)
+            answers.emplace_back(in.get_bytes(in.get_unsigned(4)));
+        if (!in.finished())
+            return std::nullopt;
+        return answers;
+    }
+
+    struct Stats {
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t stored{0};
+        std::size_t evicted{0};
+        std::size_t entries{0};
+        std::size_t bytes{0}; // of the log
+        std::size_t limit{0};
+    };
+
+    /**
+     * @brief The cache of one directory, opened for a run and closed at its end. It is safe to use from several
+     * threads of a run; two runs sharing a directory at the same time only lose each other's answers.
+     */
+    class ResultCache {
+        struct Record {
+            std::string_view key;
+            std::string_view answers;
+            std::size_t size{0};
+        };
+
+        // an answer of the log that is not in the index: appended during this run, or by a run that did not close.
+        struct Unindexed {
+            std::uint64_t offset{0};
+            std::uint32_t generation{0};
+            std::string key;
+            std::string answers;
+        };
+
+        struct Entry {
+            std::uint64_t hash{0};
+            std::uint64_t offset{0};
+            std::uint32_t generation{0};
+            std::string_view record; // its bytes, in the mapped log or in an unindexed answer
+        };
+
+        std::filesystem::path log_path;
+        std::filesystem::path index_path;
+        std::string engine; // the prefix of every key
+        std::size_t limit;
+        std::uint32_t generation{1};
+        std::optional<columnar::MappedFile> log;
+        std::optional<columnar::MappedFile> index;
+        std::size_t indexed{0};
+        std::uint64_t log_end{0};
+        std::unordered_set<std::size_t> used; // the entries of the index used by this run
+        std::unordered_multimap<std::uint64_t, Unindexed> unindexed;
+        std::ofstream appender;
+        Stats counters;
+        bool changed{false};
+        bool closed{false}; // the index is written, counters.entries holds its count
+        std::mutex mutex;
+
+        [[nodiscard]] std::string_view index_entry(const std::size_t i) const {
+            return index->view().substr(index_header_size + i * entry_size, entry_size);
+        }
+
+        // the record at offset, nothing when it does not lie within the mapped log.
+        [[nodiscard]] std::optional<Record> record_at(const std::uint64_t offset) const {
+            const std::string_view bytes{log ? log->view() : std::string_view{}};
+            if (offset < log_header_size || offset > bytes.size())
+                return std::nullopt;
+            wire::Reader in{bytes.substr(offset)};
+            in.get_unsigned(8);
+            const std::uint64_t key_length{in.get_unsigned(4)};
+            const std::uint64_t answers_length{in.get_unsigned(4)};
+            const std::string_view key{in.get_bytes(key_length)};
+            const std::string_view answers{in.get_bytes(answers_length)};
+            if (!in.ok())
+                return std::nullopt;
+            return Record{key, answers, record_header_size + key_length + answers_length};
+        }
+
+        static std::string encode_record(const std::uint64_t h, const std::string_view key,
+                                         const std::string_view answers) {
+            std::string out;
+            out.reserve(record_header_size + key.size() + answers.size());
+            wire::detail::put_unsigned(out, h, 8);
+            wire::detail::put_unsigned(out, key.size(), 4);
+            wire::detail::put_unsigned(out, answers.size(), 4);
+            out += key;
+            out += answers;
+            return out;
+        }
+
+        static std::string log_header() {
+            std::string out{log_magic};
+            wire::detail::put_unsigned(out, version, 4);
+            wire::detail::put_unsigned(out, 0, 4);
+            return out;
+        }
+
+        void open() {
+            if (auto mapped{columnar::MappedFile::open(log_path.string())}; mapped) {
+                wire::Reader header{mapped->view().substr(0, log_header_size)};
+                if (header.get_bytes(log_magic.size()) == log_magic && header.get_unsigned(4) == version)
+                    log = std::move(*mapped);
+            }
+            log_end = log ? log->view().size() : 0;
+            std::uint64_t covered{log_header_size};
+            if (auto mapped{columnar::MappedFile::open(index_path.string())}; mapped && log) {
+                const std::string_view bytes{mapped->view()};
+                wire::Reader header{bytes.substr(0, index_header_size)};
+                const bool valid{header.get_bytes(index_magic.size()) == index_magic && header.get_unsigned(4) == version};
+                const std::uint64_t last_generation{header.get_unsigned(4)};
+                const std::uint64_t length{header.get_unsigned(8)};
+                const std::uint64_t count{header.get_unsigned(8)};
+                if (valid && header.ok() && length >= log_header_size && length <= log_end &&
+                    count == (bytes.size() - index_header_size) / entry_size) {
+                    index = std::move(*mapped);
+                    indexed = count;
+                    covered = length;
+                    generation = static_cast<std::uint32_t>(last_generation) + 1;
+                }
+            }
+            // the answers appended after the index, up to the first record that was not written whole.
+            for (std::uint64_t offset{covered}; log && offset < log_end;) {
+                const auto record{record_at(offset)};
+                if (!record)
+                    break;
+                unindexed.emplace(hash(record->key), Unindexed{
+                                      offset, generation - 1, std::string{record->key}, std::string{record->answers}
+                                  });
+                offset += record->size;
+                changed = true;
+            }
+        }
+
+    public:
+        /**
+         * @brief Opens the cache of @p directory, whose log is kept below @p limit bytes. @p engine identifies the
+         * engine that computes the answers, see Core::engine, the answers of another engine are never found.
+         */
+        ResultCache(const std::filesystem::path &directory, const std::size_t limit, std::string engine)
+            : log_path(directory / "results.log"), index_path(directory / "results.idx"), engine(std::move(engine)),
+              limit(limit) {
+            std::error_code ignored;
+            std::filesystem::create_directories(directory, ignored);
+            open();
+        }
+
+        ResultCache(const ResultCache &) = delete;
+        ResultCache &operator=(const ResultCache &) = delete;
+
+        ~ResultCache() { close(); }
+
+        /**
+         * @brief The answers stored for @p key, nothing when there are none.
+         */
+        std::optional<std::vector<std::string> > lookup(const std::string_view key) {
+            const std::string full{engine + '\n' + std::string{key}};
+            const std::uint64_t h{hash(full)};
+            const std::scoped_lock lock(mutex);
+            std::size_t low{0}, high{indexed};
+            while (low < high) { // the first entry of the hash
+                const std::size_t middle{low + (high - low) / 2};
+                if (wire::Reader{index_entry(middle)}.get_unsigned(8) < h)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            for (std::size_t i = low; i < indexed; ++i) {
+                wire::Reader fields{index_entry(i)};
+                if (fields.get_unsigned(8) != h)
+                    break;
+                const auto record{record_at(fields.get_unsigned(8))};
+                if (!record || record->key != full)
+                    continue;
+                auto answers{decode_answers(record->answers)};
+                if (!answers)
+                    break;
+                used.insert(i);
+                changed = true;
+                ++counters.hits;
+                return answers;
+            }
+            for (auto [first, last]{unindexed.equal_range(h)}; first != last; ++first)
+                if (first->second.key == full) {
+                    first->second.generation = generation;
+                    changed = true;
+                    ++counters.hits;
+                    return decode_answers(first->second.answers);
+                }
+            ++counters.misses;
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Appends the @p answers of @p key to the log.
+         */
+        void store(const std::string_view key, const std::vector<std::string> &answers) {
+            std::string full{engine + '\n' + std::string{key}};
+            const std::uint64_t h{hash(full)};
+            std::string encoded{encode_answers(answers)};
+            const std::scoped_lock lock(mutex);
+            if (!appender.is_open()) {
+                if (!log) { // a new log, or one that is not a log of this version
+                    if (!cache::store(log_path, log_header()))
+                        return;
+                    log_end = log_header_size;
+                }
+                appender.open(log_path, std::ios::binary | std::ios::app);
+                if (!appender)
+                    return;
+            }
+            // one write per record, so that a record is either whole or the last one of the log.
+            const std::string record{encode_record(h, full, encoded)};
+            if (!appender.write(record.data(), static_cast<std::streamsize>(record.size())).flush())
+                return;
+            unindexed.emplace(h, Unindexed{log_end, generation, std::move(full), std::move(encoded)});
+            log_end += record.size();
+            ++counters.stored;
+            changed = true;
+        }
+
+        /**
+         * @brief Writes the index of the log, after evicting the answers used least recently when the log outgrew its
+         * limit. Nothing is written when the run neither found nor stored an answer.
+         */
+        void close() {
+            const std::scoped_lock lock(mutex);
+            if (!changed)
+                return;
+            changed = false;
+            appender.close();
+            std::vector<Entry> entries;
+            entries.reserve(indexed + unindexed.size());
+            std::vector<std::string> appended; // the records that are not in the mapped log
+            appended.reserve(unindexed.size());
+            for (std::size_t i = 0; i < indexed; ++i) {
+                wire::Reader fields{index_entry(i)};
+                const std::uint64_t h{fields.get_unsigned(8)};
+                const std::uint64_t offset{fields.get_unsigned(8)};
+                const auto last_use{static_cast<std::uint32_t>(fields.get_unsigned(4))};
+                if (const auto record{record_at(offset)}; record && hash(record->key) == h)
+                    entries.push_back({
+                        h, offset, used.contains(i) ? generation : last_use, log->view().substr(offset, record->size)
+                    });
+            }
+            for (const auto &[h, answer]: unindexed)
+                entries.push_back({
+                    h, answer.offset, answer.generation,
+                    appended.emplace_back(encode_record(h, answer.key, answer.answers))
+                });
+            if (log_end > limit) {
+                // the most recently used first, then the latest.
+                std::ranges::sort(entries, [](const Entry &a, const Entry &b) {
+                    return a.generation != b.generation ? a.generation > b.generation : a.offset > b.offset;
+                });
+                std::string rewritten{log_header()};
+                std::size_t kept{0};
+                for (Entry &entry: entries) {
+                    if (rewritten.size() + entry.record.size() > limit / 4 * 3)
+                        break;
+                    entry.offset = rewritten.size();
+                    rewritten += entry.record;
+                    ++kept;
+                }
+                counters.evicted += entries.size() - kept;
+                entries.resize(kept);
+                if (!cache::store(log_path, rewritten))
+                    return;
+                log_end = rewritten.size();
+            }
+            std::ranges::sort(entries, {}, &Entry::hash);
+            std::string out{index_magic};
+            wire::detail::put_unsigned(out, version, 4);
+            wire::detail::put_unsigned(out, generation, 4);
+            wire::detail::put_unsigned(out, log_end, 8);
+            wire::detail::put_unsigned(out, entries.size(), 8);
+            out.reserve(index_header_size + entries.size() * entry_size);
+            for (const Entry &entry: entries) {
+                wire::detail::put_unsigned(out, entry.hash, 8);
+                wire::detail::put_unsigned(out, entry.offset, 8);
+                wire::detail::put_unsigned(out, entry.generation, 4);
+                wire::detail::put_unsigned(out, 0, 4);
+            }
+            cache::store(index_path, out);
+            counters.entries = entries.size();
+            closed = true;
+        }
+
+        [[nodiscard]] Stats stats() {
+            const std::scoped_lock lock(mutex);
+            Stats current{counters};
+            if (!closed)
+                current.entries = indexed + unindexed.size();
+            current.bytes = log_end;
+            current.limit = limit;
+            return current;
+        }
+    };
+} // namespace mmqli::core::result_cache
+#endif // RESULT_CACHE_HPP
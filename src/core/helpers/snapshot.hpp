@@ -0,0 +1,287 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "cache.hpp"
+#include "columnar.hpp"
+#include "error.hpp"
+#include "wire.hpp"
+
+/**
+ * @brief This namespace contains the snapshots of a session, the files written by @code SAVE path @endcode and read
+ * back by @code LOAD path @endcode. A variable of a session is held as the text the lexer substitutes for it, so the
+ * snapshot keeps that text byte for byte, a restored variable is the exact variable that was saved.
+ *
+ * Every integer is little-endian. The file is a header, a table of fixed size entries sorted by name, and the bytes
+ * of the names, values and definitions:
+ * @code
+ * header: "MMQLSNAP", u32 version, u32 reserved, u64 count, u64 offset of the bytes
+ * entry:  u64 offset of the name within the bytes, u32 name length, u32 value length, u32 definition length,
+ *         u8 kind, 3 reserved bytes; the value and the definition follow the name
+ * @endcode
+ * The file is memory-mapped when it is read, the table can be searched by name without touching the bytes of the
+ * other variables.
+ */
+namespace mmqli::core::snapshot {
+    constexpr std::string_view magic{"MMQLSNAP"};
+    constexpr std::uint32_t version{1};
+    constexpr std::size_t header_size{32};
+    constexpr std::size_t entry_size{24};
+
+    /**
+     * @brief The type of a variable: a real or complex number, or a list, vector or matrix literal.
+     */
+    enum class Kind : std::uint8_t { real = 0, complex = 1, literal = 2 };
+
+    inline Kind kind_of(const std::string_view value) {
+        if (value.starts_with('['))
+            return Kind::literal;
+        return value.ends_with('i') ? Kind::complex : Kind::real;
+    }
+
+    struct Variable {
+        std::string_view name;
+        std::string_view value;
+        std::string_view definition; // the SET query that defined it, empty when it is not known
+        Kind kind{Kind::real};
+    };
+
+    /**
+     * @brief The snapshot of @p variables, with the definitions of the ones found in @p definitions.
+     */
+    inline std::string encode(const std::unordered_map<std::string, std::string> &variables,
+                              const std::unordered_map<std::string, std::string> &definitions) {
+        std::vector<const std::string *> names;
+        names.reserve(variables.size());
+        std::size_t bytes{0};
+        for (const auto &[name, value]: variables) {
+            names.push_back(&name);
+            const auto definition{definitions.find(name)};
+            bytes += name.size() + value.size() + (definition == definitions.end() ? 0 : definition->second.size());
+        }
+        std::ranges::sort(names, [](const std::string *a, const std::string *b) { return *a < *b; });
+        const std::size_t heap{header_size + entry_size * names.size()};
+        std::string out;
+        out.reserve(heap + bytes);
+        out += magic;
+        wire::detail::put_unsigned(out, version, 4);
+        wire::detail::put_unsigned(out, 0, 4);
+        wire::detail::put_unsigned(out, names.size(), 8);
+        wire::detail::put_unsigned(out, heap, 8);
+        std::size_t offset{0};
+        for (const std::string *name: names) {
+            const std::string &value{variables.at(*name)};
+            const auto definition{definitions.find(*name)};
+            const std::size_t definition_length{definition == definitions.end() ? 0 : definition->second.size()};
+            wire::detail::put_unsigned(out, offset, 8);
+            wire::detail::put_unsigned(out, name->size(), 4);
+            wire::detail::put_unsigned(out, value.size(), 4);
+            wire::detail::put_unsigned(out, definition_length, 4);
+            wire::detail::put_unsigned(out, static_cast<std::uint8_t>(kind_of(value)), 1);
+            wire::detail::put_unsigned(out, 0, 3);
+            offset += name->size() + value.size() + definition_length;
+        }
+        for (const std::string *name: names) {
+            out += *name;
+            out += variables.at(*name);
+            if (const auto definition{definitions.find(*name)}; definition != definitions.end())
+                out += definition->second;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Writes the snapshot of @p variables to @p path, a file that is replaced at once, never partially.
+     * @return The number of variables written, or why the file could not be written.
+     */
+    inline error::Result<std::size_t> save(const std::string &path,
+                                           const std::unordered_map<std::string, std::string> &variables,
+                                           const std::unordered_map<std::string, std::string> &definitions) {
+        if (!cache::store(std::filesystem::path{path}, encode(variables, definitions)))
+            return error::fail(error::Code::unwritable_file, "Cannot write the file " + path + " !");
+        return variables.size();
+    }
+
+    /**
+     * @brief A snapshot mapped into memory. The table is checked once when it is opened, the variables are then read
+     * in place, only the pages of the variables looked at are read from the disk.
+     */
+    class Snapshot {
+        columnar::MappedFile file;
+        std::size_t count{0};
+        std::size_t heap{0};
+
+        explicit Snapshot(columnar::MappedFile &&mapped) : file(std::move(mapped)) {}
+
+        [[nodiscard]] std::string_view entry(const std::size_t index) const {
+            return file.view().substr(header_size + index * entry_size, entry_size);
+        }
+
+    public:
+        static error::Result<Snapshot> open(const std::string &path) {
+            auto mapped{columnar::MappedFile::open(path)};
+            if (!mapped)
+                return std::unexpected{std::move(mapped.error())};
+            Snapshot snapshot{std::move(*mapped)};
+            const std::string_view bytes{snapshot.file.view()};
+            const auto malformed{
+                [&] { return error::fail(error::Code::invalid_literal, path + " is not an mmqlc snapshot !"); }
+            };
+            wire::Reader header{bytes.substr(0, header_size)};
+            if (header.get_bytes(magic.size()) != magic)
+                return malformed();
+            if (const auto file_version{header.get_unsigned(4)}; header.ok() && file_version != version)
+                return error::fail(error::Code::invalid_literal, path + " is a snapshot of version " +
+                                                                 std::to_string(file_version) + ", mmqlc reads " +
+                                                                 std::to_string(version) + " !");
+            header.get_unsigned(4);
+            const std::uint64_t count{header.get_unsigned(8)};
+            const std::uint64_t heap{header.get_unsigned(8)};
+            if (!header.ok() || count > (bytes.size() - header_size) / entry_size ||
+                heap != header_size + count * entry_size)
+                return malformed();
+            snapshot.count = count;
+            snapshot.heap = heap;
+            // every variable has to lie within the file, and the names have to be sorted for find.
+            std::string_view previous;
+            for (std::size_t i = 0; i < count; ++i) {
+                wire::Reader fields{snapshot.entry(i)};
+                const std::uint64_t offset{fields.get_unsigned(8)};
+                const std::uint64_t length{fields.get_unsigned(4) + fields.get_unsigned(4) + fields.get_unsigned(4)};
+                if (fields.get_unsigned(1) > static_cast<std::uint8_t>(Kind::literal) ||
+                    offset > bytes.size() - heap || length > bytes.size() - heap - offset)
+                    return malformed();
+                const std::string_view name{snapshot.at(i).name};
+                if (name.empty() || (i > 0 && name <= previous))
+                    return malformed();
+                previous = name;
+            }
+            return snapshot;
+        }
+
+        [[nodiscard]] std::size_t size() const { return count; }
+
+        [[nodiscard]] Variable at(const std::size_t index) const {
+            wire::Reader fields{entry(index)};
+            const std::size_t offset{heap + fields.get_unsigned(8)};
+            const std::size_t name_length{fields.get_unsigned(4)};
+            const std::size_t value_length{fields.get_unsigned(4)};
+            const std::size_t definition_length{fields.get_unsigned(4)};
+            const auto kind{static_cast<Kind>(fields.get_unsigned(1))};
+            const std::string_view bytes{file.view().substr(offset)};
+            return {
+                bytes.substr(0, name_length), bytes.substr(name_length, value_length),
+                bytes.substr(name_length + value_length, definition_length), kind
+            };
+        }
+
+        /**
+         * @brief The variable @p name, by a binary search of the table.
+         */
+        [[nodiscard]] std::optional<Variable> find(const std::string_view name) const {
+            std::size_t low{0}, high{count};
+            while (low < high) {
+                const std::size_t middle{low + (high - low) / 2};
+                const Variable variable{at(middle)};
+                if (variable.name == name)
+                    return variable;
+                if (variable.name < name)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return std::nullopt;
+        }
+    };
+
+    /**
+     * @brief The snapshots loaded into a session, which stay mapped and are read lazily: LOAD only replaces the
+     * variables of the session that the snapshot holds too, the others are copied into the session the first time a
+     * query names them, found by a binary search of the table. A snapshot hides the variables of the ones loaded
+     * before it, a variable of the session hides all of them.
+     */
+    class Loaded {
+        std::vector<Snapshot> snapshots; // in the order they were loaded
+
+        static void restore(const Variable &variable, std::unordered_map<std::string, std::string> &variables,
+                            std::unordered_map<std::string, std::string> &definitions) {
+            variables.insert_or_assign(std::string{variable.name}, std::string{variable.value});
+            if (!variable.definition.empty())
+                definitions.insert_or_assign(std::string{variable.name}, std::string{variable.definition});
+            else
+                definitions.erase(std::string{variable.name});
+        }
+
+        [[nodiscard]] std::optional<Variable> find(const std::string_view name) const {
+            for (auto snapshot{snapshots.rbegin()}; snapshot != snapshots.rend(); ++snapshot)
+                if (auto variable{snapshot->find(name)})
+                    return variable;
+            return std::nullopt;
+        }
+
+    public:
+        /**
+         * @brief Loads @p snapshot, its variables replace the ones of the session with the same name.
+         */
+        void add(Snapshot &&snapshot, std::unordered_map<std::string, std::string> &variables,
+                 std::unordered_map<std::string, std::string> &definitions) {
+            std::vector<Variable> replaced;
+            for (const auto &name: variables | std::views::keys)
+                if (auto variable{snapshot.find(name)})
+                    replaced.push_back(*variable);
+            for (const Variable &variable: replaced)
+                restore(variable, variables, definitions);
+            snapshots.push_back(std::move(snapshot));
+        }
+
+        /**
+         * @brief Copies into the session the variables of the snapshots that @p query names, when the session does
+         * not hold them yet. Every word of the query that may name a variable is looked up.
+         */
+        void resolve(const std::string_view query, std::unordered_map<std::string, std::string> &variables,
+                     std::unordered_map<std::string, std::string> &definitions) const {
+            if (snapshots.empty())
+                return;
+            const auto word{[](const char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }};
+            for (std::size_t start{0}; start < query.size();) {
+                if (!word(query[start])) {
+                    ++start;
+                    continue;
+                }
+                std::size_t end{start};
+                while (end < query.size() && word(query[end]))
+                    ++end;
+                // a variable does not start with a digit, a word that does is a number.
+                if (const std::string_view name{query.substr(start, end - start)};
+                    !std::isdigit(static_cast<unsigned char>(name.front())) && !variables.contains(std::string{name}))
+                    if (const auto variable{find(name)})
+                        restore(*variable, variables, definitions);
+                start = end;
+            }
+        }
+
+        /**
+         * @brief Copies into the session every variable of the snapshots it does not hold yet, and closes them.
+         */
+        void resolve_all(std::unordered_map<std::string, std::string> &variables,
+                         std::unordered_map<std::string, std::string> &definitions) {
+            for (auto snapshot{snapshots.rbegin()}; snapshot != snapshots.rend(); ++snapshot)
+                for (std::size_t i = 0; i < snapshot->size(); ++i)
+                    if (const Variable variable{snapshot->at(i)}; !variables.contains(std::string{variable.name}))
+                        restore(variable, variables, definitions);
+            snapshots.clear();
+        }
+
+        void clear() { snapshots.clear(); }
+    };
+} // namespace mmqli::core::snapshot
+#endif // SNAPSHOT_HPP
@@ -0,0 +1,243 @@
+#ifndef SPECIAL_HPP
+#define SPECIAL_HPP
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "cancel.hpp"
+#include "precision.hpp"
+#include "ziv.hpp"
+
+/**
+ * @brief This namespace contains the special functions: gamma, its logarithm, digamma, zeta, the error functions, the
+ * Bessel functions of integer order and the upper incomplete gamma function. All of them but zeta are MPFR's
+ * correctly rounded kernels, which keep the Bernoulli numbers they need in a cache of their own for the lifetime of
+ * the thread, so the long-lived workers of the pool reuse them from query to query.
+ *
+ * mpfr_zeta rebuilds its tables on every call, at 1000 digits it takes about a third of a second for a non-integer
+ * argument. Zeta is evaluated instead by the alternating series of Borwein, whose coefficients only depend on the
+ * precision: they are built once per size class of the working precision, together with the logarithms of the primes
+ * the terms are formed from, and shared by every query and every thread.
+ */
+namespace mmqli::core::special {
+    /**
+     * @brief log2(3 + sqrt(8)), the bits every term of the series of Borwein adds.
+     */
+    constexpr double bits_per_term{2.5431066063272239};
+    /**
+     * @brief The largest working precision of a table of zeta, a table of p bits takes about p^2 / 20 bytes. Above it
+     * zeta is left to mpfr_zeta.
+     */
+    constexpr mpfr_prec_t largest_table_bits{1 << 14};
+
+    using Function = int (*)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+    inline int log_gamma(mpfr_ptr y, mpfr_srcptr x, const mpfr_rnd_t rounding) {
+        int sign{0};
+        return mpfr_lgamma(y, &sign, x, rounding); // log |gamma(x)|
+    }
+
+    /**
+     * @brief The kernel of a special function of one operand, zeta aside, nothing when @p query is not one of them.
+     */
+    inline Function unary(const std::string_view query) {
+        if (query == "GAMMA") return mpfr_gamma;
+        if (query == "LOG_GAMMA") return log_gamma;
+        if (query == "DIGAMMA") return mpfr_digamma;
+        if (query == "ERROR_FUNCTION") return mpfr_erf;
+        if (query == "COMPLEMENTARY_ERROR_FUNCTION") return mpfr_erfc;
+        return nullptr;
+    }
+
+    /**
+     * @brief Whether the special function @p query of one operand has a pole at @p x: gamma, its logarithm and digamma
+     * at zero and the negative integers, zeta at 1.
+     */
+    inline bool has_pole(const std::string_view query, mpfr_srcptr x) {
+        if (query == "ZETA")
+            return mpfr_cmp_ui(x, 1) == 0;
+        if (query == "GAMMA" || query == "LOG_GAMMA" || query == "DIGAMMA")
+            return mpfr_integer_p(x) && mpfr_sgn(x) <= 0;
+        return false;
+    }
+
+    /**
+     * @brief The order of a Bessel function, nothing when @p n is not an integer that fits a long.
+     */
+    inline std::optional<long> order(mpfr_srcptr n) {
+        if (!mpfr_integer_p(n) || !mpfr_fits_slong_p(n, MPFR_RNDN))
+            return std::nullopt;
+        return mpfr_get_si(n, MPFR_RNDN);
+    }
+
+    /**
+     * @brief The Bessel function of the first kind J_n(x), or of the second kind Y_n(x).
+     */
+    inline int bessel(mpfr_ptr y, const bool second_kind, const long n, mpfr_srcptr x) {
+        return second_kind ? mpfr_yn(y, n, x, MPFR_RNDN) : mpfr_jn(y, n, x, MPFR_RNDN);
+    }
+
+    /**
+     * @brief The coefficients of the series of zeta at one working precision. With d_k = n sum_{i <= k}
+     * (n + i - 1)! 4^i / ((n - i)! (2i)!), the weights are c_k = 1 - d_k / d_n, all within [0, 1].
+     */
+    struct ZetaTable {
+        std::vector<precision::Register> weights; // c_k, k < n
+        std::vector<std::uint32_t> smallest_factor; // of every m <= n
+        std::vector<std::uint32_t> prime_rank; // of every prime m <= n, its logarithm in logarithms
+        std::vector<precision::Register> logarithms; // ln p of the primes p <= n
+    };
+
+    /**
+     * @brief The number of terms for a truncation error below 2^-bits, relative to eta(s) for s >= 1/2.
+     */
+    inline std::size_t zeta_terms(const mpfr_prec_t bits) {
+        return static_cast<std::size_t>(std::ceil(static_cast<double>(bits) / bits_per_term)) + 1;
+    }
+
+    inline ZetaTable zeta_table_of(const mpfr_prec_t bits) {
+        const std::size_t n{zeta_terms(bits)};
+        ZetaTable table;
+        // d_k is an integer, every term of its sum is the previous one times 4 (n + i - 1)(n - i + 1) / (2i (2i - 1)).
+        mpz_t term, partial, total, difference;
+        mpz_inits(term, partial, total, difference, nullptr);
+        const auto next_term{
+            [&](const std::size_t i) {
+                mpz_mul_ui(term, term, static_cast<unsigned long>(4 * (n + i - 1) * (n - i + 1)));
+                mpz_divexact_ui(term, term, static_cast<unsigned long>(2 * i * (2 * i - 1)));
+            }
+        };
+        mpz_set_ui(term, 1);
+        mpz_set_ui(total, 1);
+        for (std::size_t i = 1; i <= n; ++i) {
+            next_term(i);
+            mpz_add(total, total, term);
+        }
+        table.weights.reserve(n);
+        mpz_set_ui(term, 1);
+        mpz_set_ui(partial, 1);
+        for (std::size_t k = 0; k < n; ++k) {
+            if (k > 0) {
+                next_term(k);
+                mpz_add(partial, partial, term);
+            }
+            mpz_sub(difference, total, partial);
+            precision::Register &weight{table.weights.emplace_back(bits)};
+            mpfr_set_z(weight.get(), difference, MPFR_RNDN);
+            mpfr_div_z(weight.get(), weight.get(), total, MPFR_RNDN);
+        }
+        mpz_clears(term, partial, total, difference, nullptr);
+        table.smallest_factor.assign(n + 1, 0);
+        table.prime_rank.assign(n + 1, 0);
+        for (std::uint32_t m = 2; m <= n; ++m) {
+            if (table.smallest_factor[m] != 0)
+                continue;
+            table.prime_rank[m] = static_cast<std::uint32_t>(table.logarithms.size());
+            mpfr_log_ui(table.logarithms.emplace_back(bits).get(), m, MPFR_RNDN);
+            for (std::size_t multiple = m; multiple <= n; multiple += m)
+                if (table.smallest_factor[multiple] == 0)
+                    table.smallest_factor[multiple] = m;
+        }
+        return table;
+    }
+
+    /**
+     * @brief The size class of a working precision of @p bits, the precision of the table it takes: 3 2^(k-1) or 2^k
+     * bits, two classes per octave. A table has at most half as many terms again as its working precision needs, and
+     * the tables up to largest_table_bits take about 28 MB together, whatever the precisions asked for.
+     */
+    inline mpfr_prec_t table_bits(const mpfr_prec_t bits) {
+        const std::uint64_t octave{std::bit_ceil(static_cast<std::uint64_t>(bits))};
+        const std::uint64_t middle{octave / 4 * 3};
+        return static_cast<mpfr_prec_t>(static_cast<std::uint64_t>(bits) <= middle ? middle : octave);
+    }
+
+    /**
+     * @brief The table of zeta for a working precision of @p bits, built at its size class on first use and then
+     * shared.
+     */
+    inline std::shared_ptr<const ZetaTable> zeta_table(const mpfr_prec_t bits) {
+        static std::mutex cache_mutex;
+        static std::map<mpfr_prec_t, std::shared_ptr<const ZetaTable> > cache;
+        const mpfr_prec_t size_class{table_bits(bits)};
+        const std::scoped_lock lock(cache_mutex);
+        auto &cached{cache[size_class]};
+        if (!cached)
+            cached = std::make_shared<const ZetaTable>(zeta_table_of(size_class));
+        return cached;
+    }
+
+    /**
+     * @brief y = zeta(s), with the bound of its error at the precision of @p y. The integers are mpfr_zeta_ui, the
+     * arguments below 1/2 mpfr_zeta; the others take the table of the size class of their working precision, whose n
+     * terms leave a truncation error below 2^-w:
+     * @code
+     * zeta(s) = eta(s) / (1 - 2^(1-s)),  eta(s) = sum_{k < n} (-1)^k c_k (k + 1)^-s + O((3 + sqrt(8))^-n)
+     * @endcode
+     * m^-s is exp(-s ln m) for a prime m and the product of two smaller powers otherwise, so a term costs a
+     * multiplication and only the primes an exponential.
+     *
+     * Every power carries an absolute error below 3 log2(n) 2^-w, w being the working precision, as x e^-x <= 1/e
+     * bounds the error of exp(-s ln p); the weights and the powers lie within [0, 1] and the partial sums of the
+     * alternating series too, so the sum is within n (3 log2(n) + 3) 2^-w of eta(s) >= 0.6. The guard bits absorb it,
+     * only the cancellation of 1 - 2^(1-s) near s = 1 is left to the bound.
+     */
+    inline ziv::Bound zeta(mpfr_ptr y, mpfr_srcptr s) {
+        const mpfr_prec_t bits{mpfr_get_prec(y)};
+        const auto guard{static_cast<mpfr_prec_t>(2 * std::bit_width(static_cast<std::size_t>(bits)) + 8)};
+        const mpfr_prec_t working{bits + guard};
+        if (mpfr_integer_p(s) && mpfr_fits_ulong_p(s, MPFR_RNDN))
+            return ziv::rounded(mpfr_zeta_ui(y, mpfr_get_ui(s, MPFR_RNDN), MPFR_RNDN));
+        if (!mpfr_number_p(s) || mpfr_cmp_d(s, 0.5) < 0 || working > largest_table_bits)
+            return ziv::rounded(mpfr_zeta(y, s, MPFR_RNDN));
+        const std::shared_ptr<const ZetaTable> table{zeta_table(working)};
+        const std::size_t n{table->weights.size()};
+        // only the powers of m <= n/2 are factors of later ones.
+        std::vector<precision::Register> powers;
+        powers.reserve(n / 2 + 1);
+        powers.emplace_back(working);
+        mpfr_set_ui(powers.emplace_back(working).get(), 1, MPFR_RNDN);
+        precision::Register power{working}, sum{working}, term{working};
+        mpfr_set(sum.get(), table->weights[0].get(), MPFR_RNDN);
+        for (std::size_t m = 2; m <= n; ++m) {
+            if (m % 256 == 0)
+                cancel::point();
+            mpfr_ptr current{2 * m <= n ? powers.emplace_back(working).get() : power.get()};
+            if (const std::uint32_t factor{table->smallest_factor[m]}; factor == m) {
+                mpfr_mul(current, s, table->logarithms[table->prime_rank[m]].get(), MPFR_RNDN);
+                mpfr_neg(current, current, MPFR_RNDN);
+                mpfr_exp(current, current, MPFR_RNDN);
+            } else {
+                mpfr_mul(current, powers[factor].get(), powers[m / factor].get(), MPFR_RNDN);
+            }
+            mpfr_mul(term.get(), table->weights[m - 1].get(), current, MPFR_RNDN);
+            if (m % 2 == 1)
+                mpfr_add(sum.get(), sum.get(), term.get(), MPFR_RNDN);
+            else
+                mpfr_sub(sum.get(), sum.get(), term.get(), MPFR_RNDN);
+        }
+        // 1 - 2^(1-s), 2^-s is rounded once whatever the precision of s.
+        precision::Register negated{mpfr_get_prec(s)}, denominator{working};
+        mpfr_neg(negated.get(), s, MPFR_RNDN);
+        mpfr_exp2(power.get(), negated.get(), MPFR_RNDN);
+        mpfr_mul_2ui(power.get(), power.get(), 1, MPFR_RNDN);
+        mpfr_ui_sub(denominator.get(), 1, power.get(), MPFR_RNDN);
+        if (mpfr_zero_p(denominator.get())) {
+            mpfr_set_zero(y, 1); // s is too close to 1 for the working precision
+            return {false, bits};
+        }
+        mpfr_div(sum.get(), sum.get(), denominator.get(), MPFR_RNDN);
+        mpfr_set(y, sum.get(), MPFR_RNDN);
+        // the error of 2^(1-s) is amplified by 2^(1-s) / |1 - 2^(1-s)|.
+        const mpfr_exp_t cancellation{mpfr_get_exp(power.get()) - mpfr_get_exp(denominator.get()) + 1};
+        return {false, 2 + std::max<mpfr_exp_t>(0, cancellation - guard)};
+    }
+} // namespace mmqli::core::special
+#endif // SPECIAL_HPP
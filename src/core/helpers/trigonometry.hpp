@@ -40,6 +40,25 @@ namespace mmqli::core::trigonometry {
             }
         } // namespace converters
 
+        namespace detail {
+            /**
+             * @brief Replaces @p value by its reciprocal in place, the limbs of the argument become the result.
+             */
+            inline float1000 reciprocal(float1000 value) {
+                mpfr_ui_div(value.backend().data(), 1, value.backend().data(), MPFR_RNDN);
+                return value;
+            }
+
+            /**
+             * @brief Evaluates @p function at the reciprocal of @p arg in one float1000, without named temporaries.
+             */
+            inline float1000 of_reciprocal(const float1000& arg, int (*function)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t)) {
+                float1000 result{ reciprocal(arg) };
+                function(result.backend().data(), result.backend().data(), MPFR_RNDN);
+                return result;
+            }
+        } // namespace detail
+
         /**
          * @brief This functions calculates the cotangent using the trigonometric ratio
          * i-e cot(x) = 1/tan(x)
@@ -47,9 +66,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 cotangent(const float1000& arg) {
-            const float1000 tangent { tan(arg) };
-            const float1000 cotangent_result { constants::real_one / tangent };
-            return cotangent_result;
+            return detail::reciprocal(float1000{ tan(arg) });
         }
 
         /**
@@ -59,9 +76,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 secant(const float1000& arg) {
-            const float1000 cosine { cos(arg) };
-            const float1000 secant_result{ constants::real_one / cosine };
-            return secant_result;
+            return detail::reciprocal(float1000{ cos(arg) });
         }
 
         /**
@@ -71,9 +86,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 cosecant(const float1000& arg) {
-            const float1000 sine{ sin(arg) };
-            const float1000 cosecant_result{ constants::real_one / sine };
-            return cosecant_result;
+            return detail::reciprocal(float1000{ sin(arg) });
         }
 
         /**
@@ -83,9 +96,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_cotangent(const float1000& arg) {
-            const float1000 normalized_arg{ constants::real_one / arg };
-            const float1000 inverse_cot{ atan(normalized_arg) };
-            return inverse_cot;
+            return detail::of_reciprocal(arg, mpfr_atan);
         }
 
         /**
@@ -95,9 +106,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_secant(const float1000& arg) {
-            const float1000 normalized_arg{constants::real_one / arg};
-            const float1000 inverse_sec { acos(normalized_arg)};
-            return inverse_sec;
+            return detail::of_reciprocal(arg, mpfr_acos);
         }
 
         /**
@@ -107,9 +116,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_cosecant(const float1000& arg) {
-            const float1000 normalized_arg{constants::real_one / arg};
-            const float1000 inverse_cosec { asin(normalized_arg)};
-            return inverse_cosec;
+            return detail::of_reciprocal(arg, mpfr_asin);
         }
 
         /**
@@ -119,9 +126,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 cotangent_hyperbolic(const float1000& arg) {
-            const float1000 tanh_result { tanh(arg)};
-            const float1000 coth { constants::real_one / tanh_result};
-            return coth;
+            return detail::reciprocal(float1000{ tanh(arg) });
         }
 
         /**
@@ -131,9 +136,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 secant_hyperbolic(const float1000& arg) {
-            const float1000 cosh_result { cosh(arg)};
-            const float1000 sech { constants::real_one / cosh_result};
-            return sech;
+            return detail::reciprocal(float1000{ cosh(arg) });
         }
 
         /**
@@ -143,9 +146,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 cosecant_hyperbolic(const float1000& arg) {
-            const float1000 sinh_result { sinh(arg)};
-            const float1000 csch { constants::real_one / sinh_result };
-            return csch;
+            return detail::reciprocal(float1000{ sinh(arg) });
         }
         /**
          * @brief This function calculates the inverse hyperbolic cotangent using the
@@ -154,9 +155,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_cotangent_hyperbolic(const float1000& arg) {
-            const float1000 normalized_argument{constants::real_one / arg};
-            const float1000 acoth { atanh(normalized_argument)};
-            return acoth;
+            return detail::of_reciprocal(arg, mpfr_atanh);
         }
 
         /**
@@ -166,9 +165,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_secant_hyperbolic(const float1000& arg) {
-            const float1000 normalized_argument{constants::real_one / arg};
-            const float1000 asech{ acosh(normalized_argument) };
-            return asech;
+            return detail::of_reciprocal(arg, mpfr_acosh);
         }
 
         /**
@@ -178,9 +175,7 @@ namespace mmqli::core::trigonometry {
          * @return The calculated result after the operation is successfully performed.
          */
         inline float1000 inverse_cosecant_hyperbolic(const float1000& arg) {
-            const float1000 normalized_argument{ constants::real_one / arg };
-            const float1000 acsch{ asinh(normalized_argument) };
-            return acsch;
+            return detail::of_reciprocal(arg, mpfr_asinh);
         }
 
     } // namespace real
@@ -201,9 +196,7 @@ namespace mmqli::core::trigonometry {
          * cotangent.
          */
         inline complex1000 cotangent(const complex1000& arg) {
-            const complex1000 tangent_result{  std::tan(arg) };
-            complex1000 cotangent_final_result{ constants::complex_one / tangent_result };
-            return cotangent_final_result;
+            return constants::complex_one / std::tan(arg);
         }
 
         /**
@@ -212,9 +205,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the already known reciprocal identity of secant.
          */
         inline complex1000 secant(const complex1000& arg) {
-            const complex1000 cosine_result{ std::cos(arg) };
-            const complex1000 secant_final_result{ constants::complex_one / cosine_result };
-            return secant_final_result;
+            return constants::complex_one / std::cos(arg);
         }
 
         /**
@@ -223,9 +214,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the already known reciprocal identity of secant.
          */
         inline complex1000 cosecant(const complex1000& arg) {
-            const complex1000 sine_result{ std::sin(arg) };
-            complex1000 cosecant_final_result{ constants::complex_one / sine_result };
-            return cosecant_final_result;
+            return constants::complex_one / std::sin(arg);
         }
 
         /**
@@ -234,9 +223,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cotangent.
          */
         inline complex1000 inverse_cotangent(const complex1000& arg) {
-            const complex1000 normalized_argument{ constants::complex_one / arg };
-            complex1000 icot_result{ std::atan(normalized_argument) };
-            return icot_result;
+            return std::atan(constants::complex_one / arg);
         }
 
         /**
@@ -245,9 +232,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of secant.
          */
         inline complex1000 inverse_secant(const complex1000& arg) {
-            const complex1000 normalized_argument{ constants::complex_one / arg };
-            complex1000 isec_result{ std::acos(normalized_argument) };
-            return isec_result;
+            return std::acos(constants::complex_one / arg);
         }
 
         /**
@@ -256,9 +241,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cosecant.
          */
         inline complex1000 inverse_cosecant(const complex1000& arg) {
-            const complex1000 normalized_argument{ constants::complex_one / arg };
-            complex1000 icsc_result{ std::asin(normalized_argument) };
-            return icsc_result;
+            return std::asin(constants::complex_one / arg);
         }
 
         /**
@@ -267,9 +250,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cotangent hyperbolic.
          */
         inline complex1000 cotangent_hyperbolic(const complex1000& arg) {
-            const complex1000 tangent_hyperbolic_result{ std::tanh(arg) };
-            complex1000 cotangent_h_result{ constants::complex_one / tangent_hyperbolic_result };
-            return cotangent_h_result;
+            return constants::complex_one / std::tanh(arg);
         }
 
         /**
@@ -278,9 +259,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of secant hyperbolic.
          */
         inline complex1000 secant_hyperbolic(const complex1000& arg) {
-            const complex1000 cosine_hyperbolic_result{ std::cosh(arg) };
-            complex1000 secant_h_result{  constants::complex_one / cosine_hyperbolic_result };
-            return secant_h_result;
+            return constants::complex_one / std::cosh(arg);
         }
 
         /**
@@ -289,9 +268,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cosecant hyperbolic.
          */
         inline complex1000 cosecant_hyperbolic(const complex1000& arg) {
-            const complex1000 sine_hyperbolic_result{ std::sinh(arg) };
-            complex1000 cosecant_h_final_result{ constants::complex_one / sine_hyperbolic_result };
-            return cosecant_h_final_result;
+            return constants::complex_one / std::sinh(arg);
         }
 
         /**
@@ -300,9 +277,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cotangent hyperbolic.
          */
         inline complex1000 inverse_cotangent_hyperbolic(const complex1000& arg) {
-            const complex1000 normalized_argument{constants::complex_one / arg};
-            complex1000 icoth_result{ std::atanh(normalized_argument) };
-            return icoth_result;
+            return std::atanh(constants::complex_one / arg);
         }
 
         /**
@@ -311,9 +286,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of secant hyperbolic.
          */
         inline complex1000 inverse_secant_hyperbolic(const complex1000& arg) {
-            const complex1000 normalized_argument{constants::complex_one / arg};
-            complex1000 isech_result{ std::acosh(normalized_argument) };
-            return isech_result;
+            return std::acosh(constants::complex_one / arg);
         }
 
         /**
@@ -322,9 +295,7 @@ namespace mmqli::core::trigonometry {
          * @return The result of applying the reciprocal identity of cosecant hyperbolic.
          */
         inline complex1000 inverse_cosecant_hyperbolic(const complex1000& arg) {
-            const complex1000 normalized_argument{ constants::complex_one / arg };
-            complex1000 icsch_result{ std::asinh(normalized_argument) };
-            return icsch_result;
+            return std::asinh(constants::complex_one / arg);
         }
     } // namespace complex
 } // namespace mmqli::core::trigonometry
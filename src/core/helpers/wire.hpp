@@ -0,0 +1,423 @@
+#ifndef WIRE_HPP
+#define WIRE_HPP
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "boost_fwd.hpp"
+#include "error.hpp"
+
+/**
+ * @brief This namespace contains the machine-readable formats of mmqlc: JSON Lines for programs that read text, and a
+ * binary framed format that carries the MPFR numbers as their sign, exponent and limbs, so values pass between
+ * processes (and between chained mmqlc stages) without a decimal conversion.
+ *
+ * Every integer is little-endian. A frame is a u32 length followed by that many bytes of payload:
+ * @code
+ * query:  'Q' u32 id, u16 length, keyword, u8 kind, u8 count, count values of the kind
+ * result: 'R' u32 id, u8 kind, a value of the kind
+ * error:  'E' u32 id, u8 code, u32 column, u32 length, message
+ * @endcode
+ * A real is @code u8 class (0 zero, 1 regular, 2 infinity, 3 nan), u8 sign (1 when negative), i64 exponent,
+ * u64 precision, the limbs of a regular number as u64 from the least significant @endcode with the value
+ * 0.limbs * 2^exponent as in MPFR. A complex is two reals, a batch a u32 count and its elements, a text a u32 length
+ * and its bytes.
+ */
+namespace mmqli::core::wire {
+    static_assert(sizeof(mp_limb_t) == 8, "the binary format carries 64-bit limbs");
+
+    enum class Kind : std::uint8_t { real = 0, complex = 1, real_batch = 2, complex_batch = 3, text = 4 };
+
+    enum class Frame : std::uint8_t { query = 'Q', result = 'R', error = 'E' };
+
+    /**
+     * @brief A result as a value, monostate for the results that only exist as text (matrices, point sets, the
+     * digits of a constant).
+     */
+    using Value = std::variant<std::monostate, float1000, complex1000, std::vector<float1000>, std::vector<complex1000> >;
+
+    /**
+     * @brief The largest precision a frame can carry, a malformed frame cannot make mmqlc allocate more.
+     */
+    constexpr std::uint64_t largest_precision{1u << 26};
+    constexpr std::uint32_t largest_frame{1u << 30};
+
+    namespace detail {
+        inline void put_unsigned(std::string &out, std::uint64_t value, const int bytes) {
+            for (int i = 0; i < bytes; ++i, value >>= 8)
+                out += static_cast<char>(value & 0xff);
+        }
+
+        inline std::uint8_t class_of(mpfr_srcptr x) {
+            if (mpfr_zero_p(x)) return 0;
+            if (mpfr_inf_p(x)) return 2;
+            if (mpfr_nan_p(x)) return 3;
+            return 1;
+        }
+    }
+
+    /**
+     * @brief Reads the fields of a payload in order, every read fails once the payload is exhausted.
+     */
+    class Reader {
+        std::string_view bytes;
+        std::size_t at{0};
+        bool failed{false};
+
+    public:
+        explicit Reader(const std::string_view payload) : bytes(payload) {}
+
+        [[nodiscard]] bool ok() const { return !failed; }
+        [[nodiscard]] bool finished() const { return !failed && at == bytes.size(); }
+        [[nodiscard]] std::size_t remaining() const { return failed ? 0 : bytes.size() - at; }
+
+        std::uint64_t get_unsigned(const int size) {
+            if (failed || bytes.size() - at < static_cast<std::size_t>(size)) {
+                failed = true;
+                return 0;
+            }
+            std::uint64_t value{0};
+            for (int i = 0; i < size; ++i)
+                value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[at + i])) << (8 * i);
+            at += size;
+            return value;
+        }
+
+        std::string_view get_bytes(const std::size_t size) {
+            if (failed || bytes.size() - at < size) {
+                failed = true;
+                return {};
+            }
+            const std::string_view view{bytes.substr(at, size)};
+            at += size;
+            return view;
+        }
+    };
+
+    inline void put(std::string &out, mpfr_srcptr x) {
+        const std::uint8_t number_class{detail::class_of(x)};
+        out += static_cast<char>(number_class);
+        out += static_cast<char>(mpfr_signbit(x) ? 1 : 0);
+        detail::put_unsigned(out, static_cast<std::uint64_t>(number_class == 1 ? mpfr_get_exp(x) : 0), 8);
+        const mpfr_prec_t bits{mpfr_get_prec(x)};
+        detail::put_unsigned(out, static_cast<std::uint64_t>(bits), 8);
+        if (number_class != 1)
+            return;
+        const auto *limbs{static_cast<const mp_limb_t *>(mpfr_custom_get_significand(x))};
+        for (std::size_t i = 0, count = mpfr_custom_get_size(bits) / sizeof(mp_limb_t); i < count; ++i)
+            detail::put_unsigned(out, limbs[i], 8);
+    }
+
+    /**
+     * @brief Reads a real into @p x, rounded to nearest when it carries more bits than @p x.
+     * @return false when the number is malformed.
+     */
+    inline bool get(Reader &in, mpfr_ptr x) {
+        const auto number_class{in.get_unsigned(1)};
+        const bool negative{in.get_unsigned(1) != 0};
+        const auto exponent{static_cast<std::int64_t>(in.get_unsigned(8))};
+        const std::uint64_t bits{in.get_unsigned(8)};
+        if (!in.ok() || number_class > 3 || bits < MPFR_PREC_MIN || bits > largest_precision)
+            return false;
+        if (number_class != 1) {
+            if (number_class == 0) mpfr_set_zero(x, negative ? -1 : 1);
+            else if (number_class == 2) mpfr_set_inf(x, negative ? -1 : 1);
+            else mpfr_set_nan(x);
+            return true;
+        }
+        if (exponent < mpfr_get_emin() || exponent > mpfr_get_emax())
+            return false;
+        const auto precision{static_cast<mpfr_prec_t>(bits)};
+        std::vector<mp_limb_t> limbs(mpfr_custom_get_size(precision) / sizeof(mp_limb_t));
+        for (mp_limb_t &limb: limbs)
+            limb = in.get_unsigned(8);
+        // MPFR requires a normalized significand whose bits below the precision are zero.
+        if (!in.ok() || (limbs.back() >> 63) == 0)
+            return false;
+        if (const auto unused{static_cast<unsigned>(limbs.size() * 64 - bits)}; unused != 0)
+            limbs.front() &= ~((mp_limb_t{1} << unused) - 1);
+        mpfr_t view;
+        mpfr_custom_init_set(view, (negative ? -1 : 1) * MPFR_REGULAR_KIND, exponent, precision, limbs.data());
+        mpfr_set(x, view, MPFR_RNDN);
+        return true;
+    }
+
+    inline void put(std::string &out, const complex1000 &z) {
+        put(out, z.real().backend().data());
+        put(out, z.imag().backend().data());
+    }
+
+    inline bool get(Reader &in, complex1000 &z) {
+        float1000 real, imaginary;
+        if (!get(in, real.backend().data()) || !get(in, imaginary.backend().data()))
+            return false;
+        z = complex1000{std::move(real), std::move(imaginary)};
+        return true;
+    }
+
+    /**
+     * @brief The kind of @p value, text for the values that only exist as text.
+     */
+    inline Kind kind_of(const Value &value) {
+        return value.index() == 0 ? Kind::text : static_cast<Kind>(value.index() - 1);
+    }
+
+    /**
+     * @brief Writes @p value, @p text is written instead when @p value only exists as text.
+     */
+    inline void put(std::string &out, const Value &value, const std::string_view text) {
+        out += static_cast<char>(kind_of(value));
+        std::visit([&]<typename T>(const T &v) {
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                detail::put_unsigned(out, text.size(), 4);
+                out += text;
+            } else if constexpr (std::is_same_v<T, float1000>) {
+                put(out, v.backend().data());
+            } else if constexpr (std::is_same_v<T, complex1000>) {
+                put(out, v);
+            } else {
+                detail::put_unsigned(out, v.size(), 4);
+                for (const auto &element: v) {
+                    if constexpr (std::is_same_v<typename T::value_type, float1000>)
+                        put(out, element.backend().data());
+                    else
+                        put(out, element);
+                }
+            }
+        }, value);
+    }
+
+    /**
+     * @brief Reads a value of @p kind, the text of a text value goes to @p text.
+     */
+    inline bool get(Reader &in, const Kind kind, Value &value, std::string &text) {
+        const auto batch{
+            [&]<typename T>(std::vector<T> &&elements) {
+                const auto count{in.get_unsigned(4)};
+                // a real takes 18 bytes at least and a complex number 36, a count beyond the payload is malformed and
+                // is refused before the elements are made.
+                constexpr std::size_t smallest{std::is_same_v<T, float1000> ? 18 : 36};
+                if (!in.ok() || count > in.remaining() / smallest)
+                    return false;
+                elements.resize(count);
+                for (T &element: elements) {
+                    bool read;
+                    if constexpr (std::is_same_v<T, float1000>)
+                        read = get(in, element.backend().data());
+                    else
+                        read = get(in, element);
+                    if (!read)
+                        return false;
+                }
+                value = std::move(elements);
+                return true;
+            }
+        };
+        switch (kind) {
+            case Kind::real: {
+                float1000 x;
+                if (!get(in, x.backend().data()))
+                    return false;
+                value = std::move(x);
+                return true;
+            }
+            case Kind::complex: {
+                complex1000 z;
+                if (!get(in, z))
+                    return false;
+                value = std::move(z);
+                return true;
+            }
+            case Kind::real_batch: return batch(std::vector<float1000>{});
+            case Kind::complex_batch: return batch(std::vector<complex1000>{});
+            case Kind::text: {
+                const auto length{in.get_unsigned(4)};
+                text = in.get_bytes(length);
+                value = std::monostate{};
+                return in.ok();
+            }
+        }
+        return false;
+    }
+
+    struct Query {
+        std::uint32_t id{0};
+        std::string keyword;
+        Kind kind{Kind::real};
+        std::vector<Value> operands;
+    };
+
+    /**
+     * @brief A result read back from a frame: its value, its text when it only exists as text, or its error.
+     */
+    struct Answer {
+        std::uint32_t id{0};
+        error::Result<Value> value;
+        std::string text;
+    };
+
+    inline void write_frame(std::ostream &out, const std::string &payload) {
+        std::string length;
+        detail::put_unsigned(length, payload.size(), 4);
+        out.write(length.data(), static_cast<std::streamsize>(length.size()));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    }
+
+    /**
+     * @brief The payload of the next frame, nothing at the end of the input or when the frame is cut short.
+     */
+    inline std::optional<std::string> read_frame(std::istream &in) {
+        char length[4];
+        if (!in.read(length, sizeof length))
+            return std::nullopt;
+        Reader reader{std::string_view{length, sizeof length}};
+        const auto size{reader.get_unsigned(4)};
+        if (size > largest_frame)
+            return std::nullopt;
+        std::string payload(size, '\0');
+        if (!in.read(payload.data(), static_cast<std::streamsize>(size)))
+            return std::nullopt;
+        return payload;
+    }
+
+    inline std::string query_frame(const Query &query) {
+        std::string payload{static_cast<char>(Frame::query)};
+        detail::put_unsigned(payload, query.id, 4);
+        detail::put_unsigned(payload, query.keyword.size(), 2);
+        payload += query.keyword;
+        payload += static_cast<char>(query.kind);
+        payload += static_cast<char>(query.operands.size());
+        for (const Value &operand: query.operands)
+            put(payload, operand, {});
+        return payload;
+    }
+
+    /**
+     * @brief The frame of a result, @p text is carried instead of @p value when the value only exists as text.
+     */
+    inline std::string result_frame(const std::uint32_t id, const Value &value, const std::string_view text) {
+        std::string payload{static_cast<char>(Frame::result)};
+        detail::put_unsigned(payload, id, 4);
+        put(payload, value, text);
+        return payload;
+    }
+
+    inline std::string error_frame(const std::uint32_t id, const error::Error &error) {
+        std::string payload{static_cast<char>(Frame::error)};
+        detail::put_unsigned(payload, id, 4);
+        payload += static_cast<char>(error.code);
+        detail::put_unsigned(payload, error.where.column, 4);
+        detail::put_unsigned(payload, error.message.size(), 4);
+        payload += error.message;
+        return payload;
+    }
+
+    /**
+     * @brief Decodes a query frame, the operands of a query frame are all of its kind.
+     */
+    inline std::optional<Query> read_query(const std::string_view payload) {
+        Reader in{payload};
+        if (in.get_unsigned(1) != static_cast<std::uint8_t>(Frame::query))
+            return std::nullopt;
+        Query query;
+        query.id = static_cast<std::uint32_t>(in.get_unsigned(4));
+        query.keyword = in.get_bytes(in.get_unsigned(2));
+        const auto kind{in.get_unsigned(1)};
+        const auto count{in.get_unsigned(1)};
+        if (!in.ok() || kind > static_cast<std::uint8_t>(Kind::complex_batch) || count < 1 || count > 2)
+            return std::nullopt;
+        query.kind = static_cast<Kind>(kind);
+        std::string text;
+        for (std::uint64_t i = 0; i < count; ++i)
+            if (Value operand; in.get_unsigned(1) == kind && get(in, query.kind, operand, text))
+                query.operands.push_back(std::move(operand));
+            else
+                return std::nullopt;
+        return in.finished() ? std::optional<Query>{std::move(query)} : std::nullopt;
+    }
+
+    /**
+     * @brief Decodes a result or an error frame.
+     */
+    inline std::optional<Answer> read_answer(const std::string_view payload) {
+        Reader in{payload};
+        const auto frame{in.get_unsigned(1)};
+        Answer answer;
+        answer.id = static_cast<std::uint32_t>(in.get_unsigned(4));
+        if (frame == static_cast<std::uint8_t>(Frame::result)) {
+            const auto kind{in.get_unsigned(1)};
+            Value value;
+            if (kind > static_cast<std::uint8_t>(Kind::text) ||
+                !get(in, static_cast<Kind>(kind), value, answer.text) || !in.finished())
+                return std::nullopt;
+            answer.value = std::move(value);
+            return answer;
+        }
+        if (frame == static_cast<std::uint8_t>(Frame::error)) {
+            const auto code{in.get_unsigned(1)};
+            const auto column{in.get_unsigned(4)};
+            std::string message{in.get_bytes(in.get_unsigned(4))};
+            if (!in.finished() || code > static_cast<std::uint8_t>(error::Code::memory_limit))
+                return std::nullopt;
+            answer.value = error::fail(static_cast<error::Code>(code), std::move(message), {answer.id, column});
+            return answer;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief @p text as a JSON string, with the quotes.
+     */
+    inline std::string json_string(const std::string_view text) {
+        std::string quoted{"\""};
+        quoted.reserve(text.size() + 2);
+        for (const char c: text) {
+            switch (c) {
+                case '"': quoted += "\\\""; break;
+                case '\\': quoted += "\\\\"; break;
+                case '\n': quoted += "\\n"; break;
+                case '\r': quoted += "\\r"; break;
+                case '\t': quoted += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        constexpr char hex[]{"0123456789abcdef"};
+                        quoted += "\\u00";
+                        quoted += hex[(c >> 4) & 0xf];
+                        quoted += hex[c & 0xf];
+                    } else {
+                        quoted += c;
+                    }
+            }
+        }
+        quoted += '"';
+        return quoted;
+    }
+
+    /**
+     * @brief One JSON Lines record: @code {"id":1,"query":"SINE 30","status":"ok","value":"0.5"} @endcode or
+     * @code {"id":1,"query":"...","status":"error","error":{"code":"domain","column":0,"message":"..."}} @endcode
+     * The values are strings, a number of a thousand digits does not survive the doubles of most JSON readers.
+     */
+    inline std::string json_line(const std::size_t id, const std::string_view query,
+                                 const error::Result<std::string> &result) {
+        std::string line{"{\"id\":" + std::to_string(id) + ",\"query\":" + json_string(query)};
+        if (result) {
+            line += ",\"status\":\"ok\",\"value\":";
+            line += json_string(*result);
+        } else {
+            line += ",\"status\":\"error\",\"error\":{\"code\":\"";
+            line += error::name(result.error().code);
+            line += "\",\"column\":" + std::to_string(result.error().where.column) + ",\"message\":";
+            line += json_string(result.error().message);
+            line += '}';
+        }
+        line += "}\n";
+        return line;
+    }
+} // namespace mmqli::core::wire
+#endif // WIRE_HPP
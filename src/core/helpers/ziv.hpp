@@ -0,0 +1,265 @@
+#ifndef ZIV_HPP
+#define ZIV_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <gmpxx.h>
+#include "boost_fwd.hpp"
+#include "cancel.hpp"
+#include "precision.hpp"
+
+/**
+ * @brief This namespace contains the adaptive evaluation of real queries to a requested number of correct digits.
+ * A query is evaluated at a working precision a little above the one the digits need, together with a bound of its
+ * error, and the digits are only printed when every number within the bound rounds to them. Otherwise the working
+ * precision is doubled and the query evaluated again (Ziv's strategy), so a well conditioned query runs once at the
+ * smallest precision that is correct, and only the queries near a cancellation or a pole pay for more bits.
+ */
+namespace mmqli::core::ziv {
+    /**
+     * @brief The bits added to the ones the digits need at the first attempt, they absorb the few bits a composed
+     * query loses in most cases.
+     */
+    constexpr mpfr_prec_t guard_bits{24};
+    /**
+     * @brief The working precision at which the attempts stop, as a multiple of the first one.
+     */
+    constexpr mpfr_prec_t growth_limit{64};
+    constexpr std::size_t largest_digits{1000000};
+
+    namespace detail {
+        // the digits of the session, 0 when the queries are evaluated at the precision of float1000.
+        inline std::atomic<std::size_t> digits{0};
+        // the digits of the calling thread when it evaluates for a session of its own, see ThreadDigits.
+        inline thread_local std::optional<std::size_t> thread_digits;
+    }
+
+    inline void set_digits(const std::size_t digits) { detail::digits.store(digits, std::memory_order_relaxed); }
+
+    /**
+     * @brief The number of correct digits the queries of the calling thread are evaluated to, 0 when the adaptive
+     * evaluation is off.
+     */
+    inline std::size_t digits() {
+        return detail::thread_digits ? *detail::thread_digits : detail::digits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the digits of the calling thread only, until the guard goes out of scope, so threads that evaluate
+     * queries for different sessions can ask for different digits. The adaptive queries are evaluated on the thread
+     * that calls the core.
+     */
+    class ThreadDigits {
+        std::optional<std::size_t> previous;
+
+    public:
+        explicit ThreadDigits(const std::size_t digits) : previous(std::exchange(detail::thread_digits, digits)) {}
+
+        ThreadDigits(const ThreadDigits &) = delete;
+        ThreadDigits &operator=(const ThreadDigits &) = delete;
+
+        ~ThreadDigits() { detail::thread_digits = previous; }
+    };
+
+    /**
+     * @brief The error of one evaluation: either none, or at most 2^lost_bits units in the last place of the working
+     * precision.
+     */
+    struct Bound {
+        bool exact{false};
+        mpfr_prec_t lost_bits{0};
+    };
+
+    /**
+     * @brief The bound of a single correctly rounded MPFR call, exact when its ternary value says so.
+     */
+    inline Bound rounded(const int ternary) { return {ternary == 0, 0}; }
+
+    /**
+     * @brief The bits lost by evaluating a function at an argument that carries a relative error below
+     * 2^(roundings - p), p being the working precision: the error of the argument reaches the result amplified by
+     * the derivative of the function, to first order |f'(u) u| 2^(roundings - p), on top of the half unit of the
+     * final rounding.
+     * @param result The value of the function, f(u).
+     * @param argument The argument u.
+     * @param derivative f'(u), a few bits of it are enough.
+     * @param roundings The error of the argument, as a power of two of the working precision.
+     */
+    inline mpfr_prec_t condition_loss(mpfr_srcptr result, mpfr_srcptr argument, mpfr_srcptr derivative,
+                                      const mpfr_prec_t roundings) {
+        if (!mpfr_regular_p(result))
+            return mpfr_get_prec(result); // a zero that cancelled, or a pole, no digit of it can be trusted
+        if (mpfr_zero_p(argument) || mpfr_zero_p(derivative))
+            return 1;
+        if (!mpfr_number_p(derivative))
+            return mpfr_get_prec(result);
+        const mpfr_exp_t amplified{mpfr_get_exp(derivative) + mpfr_get_exp(argument) + roundings};
+        return std::max<mpfr_exp_t>(0, amplified - mpfr_get_exp(result)) + 1;
+    }
+
+    /**
+     * @brief The working precision of the first attempt for @p digits decimal digits.
+     */
+    inline mpfr_prec_t bits_for(const std::size_t digits) {
+        return static_cast<mpfr_prec_t>(std::ceil(static_cast<double>(digits) * 3.321928094887362)) + guard_bits;
+    }
+
+    /**
+     * @brief Writes @p value with @p digits significant decimal digits, rounded to nearest, trailing zeros are kept:
+     * every digit written is correct.
+     */
+    inline std::string to_digits(mpfr_srcptr value, const std::size_t digits) {
+        if (mpfr_nan_p(value))
+            return "nan";
+        if (mpfr_inf_p(value))
+            return mpfr_signbit(value) ? "-inf" : "inf";
+        if (mpfr_zero_p(value))
+            return "0";
+        mpfr_exp_t exponent{0};
+        char *written{mpfr_get_str(nullptr, &exponent, 10, digits, value, MPFR_RNDN)};
+        std::string significand{written};
+        mpfr_free_str(written);
+        std::string text;
+        if (significand.front() == '-') {
+            text += '-';
+            significand.erase(0, 1);
+        }
+        // value = 0.significand * 10^exponent
+        const auto length{static_cast<mpfr_exp_t>(significand.size())};
+        if (exponent > 0 && exponent <= length) {
+            text.append(significand, 0, exponent);
+            if (exponent < length)
+                text.append(".").append(significand, exponent);
+        } else if (exponent <= 0 && exponent > -5) {
+            text.append("0.").append(-exponent, '0').append(significand);
+        } else {
+            text += significand.front();
+            if (length > 1)
+                text.append(".").append(significand, 1);
+            text += exponent - 1 < 0 ? "e-" : "e+";
+            text += std::to_string(std::abs(exponent - 1));
+        }
+        return text;
+    }
+
+    struct Answer {
+        std::string text; // the correct digits
+        mpfr_prec_t working_bits{0}; // of the attempt that gave them
+        unsigned attempts{0};
+    };
+
+    /**
+     * @brief An operand of an adaptive query. The rational it is written with, 0.1 for the literal 0.1, is read again
+     * at the working precision of every attempt, so the digits are not limited by the bits of float1000; an operand
+     * known by its float1000 value only is exact at any precision above its own.
+     */
+    class Operand {
+        mpfr_srcptr value{nullptr};
+        std::optional<mpq_class> written{0};
+
+    public:
+        Operand() = default; // 0, the missing operand of a unary query
+
+        Operand(mpfr_srcptr value, std::optional<mpq_class> written) : value(value), written(std::move(written)) {}
+
+        [[nodiscard]] const std::optional<mpq_class> &rational() const { return written; }
+
+        /**
+         * @brief Encloses the operand at @p bits between @p low and @p high, its two roundings.
+         * @return Whether it is exact at @p bits, @p low alone then holds it.
+         */
+        bool enclose(const mpfr_prec_t bits, mpfr_ptr low, mpfr_ptr high) const {
+            if (!written) {
+                mpfr_set_prec(low, std::max(bits, mpfr_get_prec(value)));
+                mpfr_set(low, value, MPFR_RNDN);
+                return true;
+            }
+            mpfr_set_prec(low, bits);
+            if (mpfr_set_q(low, written->get_mpq_t(), MPFR_RNDD) == 0)
+                return true;
+            mpfr_set_prec(high, bits);
+            mpfr_set_q(high, written->get_mpq_t(), MPFR_RNDU);
+            return false;
+        }
+    };
+
+    /**
+     * @brief Evaluates @p kernel until @p digits of its result are known to be correct. The kernel runs at every
+     * corner of the enclosures of the operands that are not exact at the working precision, and to first order the
+     * result lies between the corners, like in condition_loss.
+     * @param digits The number of significant decimal digits.
+     * @param first The first operand.
+     * @param second The second operand, an Operand{} for a unary query.
+     * @param kernel A callable of the form @code Bound(mpfr_ptr result, mpfr_srcptr first, mpfr_srcptr second)
+     * @endcode evaluating the query at the precision of @p result and returning the bound of its error for exact
+     * operands.
+     * @return The digits, or nothing when they cannot be certified below the largest working precision, e.g. a result
+     * that is exactly zero but not computed as such.
+     */
+    template<typename Kernel>
+    std::optional<Answer> evaluate(const std::size_t digits, const Operand &first, const Operand &second,
+                                   Kernel &&kernel) {
+        const mpfr_prec_t smallest{bits_for(digits)};
+        precision::Register a[2], b[2]; // the enclosures of the operands
+        unsigned attempts{0};
+        for (mpfr_prec_t working{smallest}; working <= smallest * growth_limit; working *= 2) {
+            ++attempts;
+            cancel::point();
+            const int first_corners{first.enclose(working, a[0].get(), a[1].get()) ? 1 : 2};
+            const int second_corners{second.enclose(working, b[0].get(), b[1].get()) ? 1 : 2};
+            // every number within the bound of every corner has to round to the same digits, the endpoints are
+            // formed exactly.
+            precision::Register low{working + 2};
+            precision::Register high{working + 2};
+            bool certain{true};
+            for (int i = 0; certain && i < first_corners; ++i)
+                for (int j = 0; certain && j < second_corners; ++j) {
+                    precision::Register result{working};
+                    const Bound bound{kernel(result.get(), a[i].get(), b[j].get())};
+                    if ((bound.exact && first_corners * second_corners == 1) || mpfr_nan_p(result.get()) ||
+                        mpfr_inf_p(result.get()))
+                        return Answer{to_digits(result.get(), digits), working, attempts};
+                    // an inexact zero, its digits cancelled
+                    certain = !(mpfr_zero_p(result.get()) && !bound.exact) && bound.lost_bits < working;
+                    if (!certain)
+                        break;
+                    precision::Register radius{2};
+                    if (bound.exact)
+                        mpfr_set_zero(radius.get(), 1);
+                    else
+                        mpfr_set_ui_2exp(radius.get(), 1, mpfr_get_exp(result.get()) - working + bound.lost_bits,
+                                         MPFR_RNDN);
+                    precision::Register below{working + 2};
+                    precision::Register above{working + 2};
+                    mpfr_sub(below.get(), result.get(), radius.get(), MPFR_RNDD);
+                    mpfr_add(above.get(), result.get(), radius.get(), MPFR_RNDU);
+                    if (i + j == 0 || mpfr_cmp(below.get(), low.get()) < 0)
+                        mpfr_set(low.get(), below.get(), MPFR_RNDN);
+                    if (i + j == 0 || mpfr_cmp(above.get(), high.get()) > 0)
+                        mpfr_set(high.get(), above.get(), MPFR_RNDN);
+                }
+            if (!certain)
+                continue;
+            std::string text{to_digits(low.get(), digits)};
+            if (text == to_digits(high.get(), digits))
+                return Answer{std::move(text), working, attempts};
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Evaluates @p kernel, a callable of the form @code Bound(mpfr_ptr result) @endcode without operands,
+     * until @p digits of its result are known to be correct.
+     */
+    template<typename Kernel>
+    std::optional<Answer> evaluate(const std::size_t digits, Kernel &&kernel) {
+        return evaluate(digits, Operand{}, Operand{},
+                        [&kernel](mpfr_ptr result, mpfr_srcptr, mpfr_srcptr) { return kernel(result); });
+    }
+} // namespace mmqli::core::ziv
+#endif // ZIV_HPP
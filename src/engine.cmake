@@ -0,0 +1,19 @@
+# writes engine.hpp, the hash of every source of mmqli_core, run at build time by the mmqli_core target:
+#   cmake -DSOURCE_DIR=<dir> -DSOURCES=<a|b|...> -DOUTPUT=<engine.hpp> -P engine.cmake
+# the header is only rewritten when the hash changes, so an unchanged engine is not recompiled.
+string(REPLACE "|" ";" SOURCES "${SOURCES}")
+list(SORT SOURCES)
+set(digests "")
+foreach (source IN LISTS SOURCES)
+    file(SHA256 "${SOURCE_DIR}/${source}" digest)
+    string(APPEND digests "${source} ${digest}\n")
+endforeach ()
+string(SHA256 hash "${digests}")
+string(SUBSTRING "${hash}" 0 16 hash)
+file(CONFIGURE OUTPUT "${OUTPUT}" CONTENT "#ifndef ENGINE_HPP
+#define ENGINE_HPP
+
+// generated by engine.cmake, the hash of the sources of mmqli_core this build was compiled from.
+#define MMQLC_ENGINE_SOURCES \"${hash}\"
+#endif // ENGINE_HPP
+")
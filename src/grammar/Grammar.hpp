@@ -8,23 +8,38 @@ namespace grammar::queries {
     const std::regex realQueryD(
         R"((?!\d)(\w+)\s(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?),\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
     // double arg real query
+    const std::regex rationalQueryS(R"((?!\d)(\w+)\s(-?\d+/\d+))"); // single arg query over a rational literal
+    const std::regex rationalQueryD(
+        R"((?!\d)(\w+)\s(-?\d+(/\d+|(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)),\s*(-?\d+(/\d+|(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)))");
+    // double arg query over real or rational literals, at least one of them rational
     const std::regex complexQueryS(
         R"((?!\d)(\w+)\s((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     // single arg complex query
     const std::regex complexQueryD(
         R"((?!\d)(\w+)\s((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)),\s*((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     // double arg complex query
-    const std::regex var_get(R"((get)\s(?!\d)(\w+))"); // query used to get the value from mmqlc memory
+    const std::regex var_get(R"((GET)\s(?!\d)(\w+))"); // query used to get the value from mmqlc memory
     const std::regex QuerySV(R"((?!\d)(\w+)\s(\w+))"); // works for both complex and real numbers
     const std::regex QueryDV(R"((?!\d)(\w+)\s(\w+),\s*(\w+))"); // works for both complex and real numbers
+    const std::regex batchQueryS(R"((?!\d)(\w+)\s(\[[^\[\]]*\]))"); // single arg batch query over a list or range
+    const std::regex batchQueryD(R"((?!\d)(\w+)\s(\[[^\[\]]*\]),\s*(\[[^\[\]]*\]))"); // double arg batch query
+    const std::regex integralQuery(R"((INTEGRATE\w*)\s(?!\d)(\w+),\s*(\[[^\[\]]*\]))");
+    // integral of a built-in function over [a,b]
+    const std::regex constantQuery(R"((CONSTANT)\s(?!\d)(\w+),\s*(\d+))"); // named constant to a number of digits
+    const std::regex matrixQueryS(R"((?!\d)(\w+)\s(\[\s*\[[^\[\]]*\](\s*,\s*\[[^\[\]]*\])*\s*\]))"); // single arg matrix query
+    const std::regex matrixQueryD(
+        R"((?!\d)(\w+)\s(\[\s*\[[^\[\]]*\](\s*,\s*\[[^\[\]]*\])*\s*\]),\s*(\[\s*\[[^\[\]]*\](\s*,\s*\[[^\[\]]*\])*\s*\]|\[[^\[\]]*\]))");
+    // double arg matrix query, the second operand is either a matrix or a vector
 }
 
 namespace grammar::queries::internal {
-    const std::regex var_get_internalReal(R"(get\s(?!\d)(\w+)\s*=\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
+    const std::regex var_get_internalReal(R"(GET\s(?!\d)(\w+)\s*=\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
     // that's what the parser will do to get query [REAL NUMBERS] ;
     const std::regex var_get_internalComplex(
-        R"(get\s(?!\d)(\w+)\s*=\s*((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
+        R"(GET\s(?!\d)(\w+)\s*=\s*((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     // that's what the parser will do to get query [COMPLEX NUMBERS] ;
+    const std::regex var_get_internalLiteral(R"(GET\s(?!\d)(\w+)\s*=\s*(\[.*\]))");
+    // that's what the parser will do to get query [LISTS, VECTORS AND MATRICES] ;
 }
 
 namespace grammar::numbers {
@@ -32,20 +47,30 @@ namespace grammar::numbers {
         R"(((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     // regex for complex number
     const std::regex realNum(R"((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))"); // regex  for real number
+    const std::regex realRange(
+        R"(\[\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)\s*:\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)\s*:\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)\s*\])");
+    // regex for range literal [start:stop:step]
+    const std::regex batchList(R"(\[([^\[\]:@]*)\])"); // regex for list literal [a,b,c], elements are split on commas
+    const std::regex matrix(R"(\[\s*\[[^\[\]]*\](\s*,\s*\[[^\[\]]*\])*\s*\])"); // regex for matrix literal [[a,b],[c,d]]
+    const std::regex matrixFile(R"(\[\[@([^\[\]]+)\]\])"); // regex for matrix file literal [[@path]], one row per line
+    const std::regex matrixRow(R"(\[([^\[\]]*)\])"); // regex for one row of a matrix literal [[a,b],[c,d]]
+    const std::regex batchFile(R"(\[@([^\[\]]+)\])"); // regex for file literal [@path], numbers separated by commas or blanks
 }
 
 namespace grammar::variables {
-    const std::regex realVar(R"(set\s(?!\d)(\w+)\s*=\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
-    const std::regex realVarS(R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
+    const std::regex realVar(R"(SET\s(?!\d)(\w+)\s*=\s*(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
+    const std::regex realVarS(R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
     const std::regex realVarD(
-        R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?,-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
+        R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?,-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?))");
     const std::regex complexVar(
-        R"(set\s(?!\d)(\w+)\s*=\s*((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
+        R"(SET\s(?!\d)(\w+)\s*=\s*((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     const std::regex complexVarS(
-        R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
+        R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i)))");
     const std::regex complexVarD(
-        R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i),((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i))))");
-    const std::regex QueryVarD(R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s\w+,\w+))");
-    const std::regex QueryVarS(R"(set\s(?!\d)(\w+)\s*=\s*(\w+\s\w+))");
+        R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s(-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i),((-?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)?(([-+]?\d+(\.\d+)?([Ee][+-]\d+(\.\d+)?)?)i))))");
+    const std::regex QueryVarD(R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s\w+,\w+))");
+    const std::regex QueryVarS(R"(SET\s(?!\d)(\w+)\s*=\s*(\w+\s\w+))");
+    const std::regex literalVar(R"(SET\s(?!\d)(\w+)\s*=\s*(\[.*\]))"); // list, vector or matrix literal
+    const std::regex literalQueryVar(R"(SET\s(?!\d)(\w+)\s*=\s*((?!\d)\w+\s\[.*\]))"); // query over literals
 }
 #endif
\ No newline at end of file
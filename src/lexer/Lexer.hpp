@@ -7,70 +7,167 @@
 #include <unordered_set>
 #include <unordered_map>
 #include "../grammar/Grammar.hpp"
+#include "../core/helpers/profiler.hpp"
+#include "../core/helpers/error.hpp"
+#include "../core/helpers/plugins.hpp"
+#include "../core/helpers/radix.hpp"
+#include "../core/helpers/exact.hpp"
 
+using Token = std::tuple<std::string, std::string, std::string>; // the keyword and the two operands of a query
 
-inline std::vector<std::tuple<std::string, std::string, std::string> >
+/**
+ * @brief Where a token comes from: the index of its query and the 1-based columns of its two operands in the query,
+ * 0 when the operand is not written in the query.
+ */
+struct TokenSource {
+    std::size_t query{0};
+    std::size_t first{0};
+    std::size_t second{0};
+};
+
+/**
+ * @brief The tokens of the queries, with the source of every token, and the queries that could not be tokenized
+ * (a variable that is not defined). The other queries are tokenized all the same.
+ */
+struct TokenizedQueries {
+    std::vector<Token> tokens;
+    std::vector<TokenSource> sources;
+    std::vector<mmqli::core::error::Error> errors;
+};
+
+inline TokenizedQueries
 tokenize(const std::vector<std::string> &queries,
          const std::unordered_map<std::string, std::string> &resolved_varMap = {}) {
-    std::vector<std::tuple<std::string, std::string, std::string> > tokens;
+    const mmqli::core::profiler::Scope timer{"stage", "tokenize"};
+    namespace Errors = mmqli::core::error;
+    namespace Plugins = mmqli::core::plugins;
+    namespace Radix = mmqli::core::radix;
+    TokenizedQueries tokenized;
+    std::size_t index{0}; // of the query being tokenized
+    auto column = [](const std::smatch &matches, const std::size_t group) {
+        return static_cast<std::size_t>(matches.position(group)) + 1;
+    };
+    auto emit = [&](std::string keyWord, std::string firstOperand, std::string secondOperand,
+                    const std::size_t firstColumn, const std::size_t secondColumn) {
+        tokenized.tokens.emplace_back(std::move(keyWord), std::move(firstOperand), std::move(secondOperand));
+        tokenized.sources.push_back({index, firstColumn, secondColumn});
+    };
+    auto undefined = [&](const std::smatch &matches, const std::size_t group) {
+        tokenized.errors.push_back({Errors::Code::undefined_variable, {index, column(matches, group)},
+                                    "Undeclared variable " + matches[group].str() + " called !"});
+        return true;
+    };
     auto getVar = [&resolved_varMap](const std::string &varName) {
         auto it = resolved_varMap.find(varName);
         if (it == resolved_varMap.end())
             return std::string("");
         return it->second;
     };
+    const std::unordered_set<std::string> RealSingleOperand_Queries = {
+        "FACTORIAL",
+        "SINE", "COSINE", "TANGENT",
+        "SECANT", "COSECANT", "COTANGENT",
+        "HYP_SINE", "HYP_COSINE", "HYP_TANGENT",
+        "HYP_SECANT", "HYP_COTANGENT", "HYP_COSECANT",
+        "INVERSE_SINE", "INVERSE_COSINE", "INVERSE_TANGENT",
+        "INVERSE_SECANT", "INVERSE_COSECANT", "INVERSE_COTANGENT",
+        "INVERSE_HYP_SINE", "INVERSE_HYP_COSINE", "INVERSE_HYP_TANGENT",
+        "INVERSE_HYP_SECANT", "INVERSE_HYP_COTANGENT", "INVERSE_HYP_COSECANT",
+        "FLOOR", "CEILING", "ABSOLUTE", "NATURAL_LOGARITHM", "BINARY_LOGARITHM", "COMMON_LOGARITHM",
+        "GAMMA", "LOG_GAMMA", "DIGAMMA", "ZETA", "ERROR_FUNCTION", "COMPLEMENTARY_ERROR_FUNCTION",
+        "TRIG_ALL", "HYP_ALL", "LOG_ALL"
+    };
+    // the plugin functions of a single operand are accepted like the built-in ones.
+    auto realSingleOperand = [&RealSingleOperand_Queries](const std::string &keyWord) {
+        return RealSingleOperand_Queries.contains(keyWord) || Plugins::single_operand(keyWord, Plugins::Kind::real);
+    };
+    // the length of the real or rational literal at the start of text, 0 when there is none.
+    auto literalLength = [](const std::string_view text) {
+        std::size_t length{Radix::real_length(text)};
+        if (length > 0 && length < text.size() && text[length] == '/' && mmqli::core::exact::literal(text.substr(0, length))) {
+            const std::size_t denominator{text.find_first_not_of("0123456789", length + 1)};
+            const std::size_t end{denominator == std::string_view::npos ? text.size() : denominator};
+            if (end > length + 1)
+                length = end;
+        }
+        return length;
+    };
+    // KEYWORD a or KEYWORD a,b over real or rational literals is split by a scan of its characters: the regular
+    // expressions match a run of digits recursively, a literal of a few ten thousand digits overflows the stack.
+    auto processLiterals = [&](const std::string &query) {
+        const std::string_view text{query};
+        const std::size_t space{text.find(' ')};
+        if (space == 0 || space == std::string_view::npos || (text.front() >= '0' && text.front() <= '9') ||
+            text.substr(0, space).find_first_not_of(
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789_") != std::string_view::npos)
+            return false;
+        const std::string keyWord{text.substr(0, space)};
+        const std::size_t first{space + 1};
+        const std::size_t firstLength{literalLength(text.substr(first))};
+        if (firstLength == 0)
+            return false;
+        if (first + firstLength == text.size()) {
+            if (!realSingleOperand(keyWord))
+                return false;
+            emit(keyWord, query.substr(first), "", first + 1, 0);
+            return true;
+        }
+        if (text[first + firstLength] != ',' || realSingleOperand(keyWord))
+            return false;
+        const std::size_t second{text.find_first_not_of(" \t", first + firstLength + 1)};
+        if (second == std::string_view::npos || second + literalLength(text.substr(second)) != text.size())
+            return false;
+        emit(keyWord, query.substr(first, firstLength), query.substr(second), first + 1, second + 1);
+        return true;
+    };
     auto processReal = [&](const std::string &query) {
-        const std::unordered_set<std::string> SingleOperand_Queries = {
-            "FACTORIAL",
-            "SINE", "COSINE", "TANGENT",
-            "SECANT", "COSECANT", "COTANGENT",
-            "HYP_SINE", "HYP_COSINE", "HYP_TANGENT",
-            "HYP_SECANT", "HYP_COTANGENT", "HYP_COSECANT",
-            "INVERSE_SINE", "INVERSE_COSINE", "INVERSE_TANGENT",
-            "INVERSE_SECANT", "INVERSE_COSECANT", "INVERSE_COTANGENT",
-            "INVERSE_HYP_SINE", "INVERSE_HYP_COSINE", "INVERSE_HYP_TANGENT",
-            "INVERSE_HYP_SECANT", "INVERSE_HYP_COTANGENT", "INVERSE_HYP_COSECANT",
-            "FLOOR", "CEILING", "ABSOLUTE", "NATURAL_LOGARITHM", "BINARY_LOGARITHM", "COMMON_LOGARITHM"
-        };
         if (query.rfind("SET", 0) == 0) // if query is variable definition skip tokenization
             return true;
         if (std::smatch matches; std::regex_match(query, matches, grammar::queries::var_get)) {
             if (!resolved_varMap.contains(matches[2].str()))
-                throw std::runtime_error("\nError: Attempt to access undefined variable");
-            std::string keyWord = matches[1].str();
-            std::string firstOperand = matches[2].str();
-            std::string secondOperand = resolved_varMap.at(matches[2].str());
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+                return undefined(matches, 2);
+            emit(matches[1].str(), matches[2].str(), resolved_varMap.at(matches[2].str()), column(matches, 2), 0);
+            return true;
+        } else if (std::regex_match(query, matches, grammar::queries::constantQuery)) {
+            // the name of the constant is kept with the keyword, the digit count is the operand.
+            emit(matches[1].str() + " " + matches[2].str(), matches[3].str(), "", column(matches, 3), 0);
             return true;
         } else if (std::regex_match(query, matches, grammar::queries::realQueryS)) {
-            if (const std::string keyWord = matches[1].str(); SingleOperand_Queries.contains(keyWord)) {
-                std::string firstOperand = matches[2].str();
-                tokens.emplace_back(keyWord, firstOperand, "");
+            if (const std::string keyWord = matches[1].str(); realSingleOperand(keyWord)) {
+                emit(keyWord, matches[2].str(), "", column(matches, 2), 0);
                 return true;
             }
         } else if (std::regex_match(query, matches, grammar::queries::QuerySV)) {
-            if (const std::string keyWord = matches[1].str(); SingleOperand_Queries.contains(keyWord)) {
+            if (const std::string keyWord = matches[1].str(); realSingleOperand(keyWord)) {
                 std::string firstOperand = getVar(matches[2].str());
                 if (firstOperand.empty())
-                    throw std::runtime_error("\nError: Undeclared Variable Called !");
-                tokens.emplace_back(keyWord, firstOperand, "");
+                    return undefined(matches, 2);
+                emit(keyWord, std::move(firstOperand), "", column(matches, 2), 0);
                 return true;
             }
         } else if (std::regex_match(query, matches, grammar::queries::realQueryD)) {
             const std::string keyWord = matches[1].str();
-            if (SingleOperand_Queries.contains(keyWord)) return false;
-            const std::string firstOperand = matches[2].str();
-            const std::string secondOperand = matches[6].str();
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+            if (realSingleOperand(keyWord)) return false;
+            emit(keyWord, matches[2].str(), matches[6].str(), column(matches, 2), column(matches, 6));
             return true;
         } else if (std::regex_match(query, matches, grammar::queries::QueryDV)) {
             const std::string keyWord = matches[1].str();
-            if (SingleOperand_Queries.contains(keyWord)) return false;
-            const std::string firstOperand = getVar(matches[2].str());
-            const std::string secondOperand = getVar(matches[3].str());
+            if (realSingleOperand(keyWord)) return false;
+            std::string firstOperand = getVar(matches[2].str());
+            std::string secondOperand = getVar(matches[3].str());
             if (firstOperand.empty() || secondOperand.empty())
-                throw std::runtime_error("\nError: Undeclared Variable Called !");
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+                return undefined(matches, firstOperand.empty() ? 2 : 3);
+            emit(keyWord, std::move(firstOperand), std::move(secondOperand), column(matches, 2), column(matches, 3));
+            return true;
+        } else if (std::regex_match(query, matches, grammar::queries::rationalQueryS)) {
+            if (const std::string keyWord = matches[1].str(); realSingleOperand(keyWord)) {
+                emit(keyWord, matches[2].str(), "", column(matches, 2), 0);
+                return true;
+            }
+        } else if (std::regex_match(query, matches, grammar::queries::rationalQueryD)) {
+            const std::string keyWord = matches[1].str();
+            if (realSingleOperand(keyWord)) return false;
+            emit(keyWord, matches[2].str(), matches[7].str(), column(matches, 2), column(matches, 7));
             return true;
         }
         return false;
@@ -86,59 +183,104 @@ tokenize(const std::vector<std::string> &queries,
             "HYP_SECANT", "HYP_COSECANT", "HYP_COTANGENT",
             "INVERSE_HYP_SINE", "INVERSE_HYP_COSINE", "INVERSE_HYP_TANGENT",
             "INVERSE_HYP_COSECANT", "INVERSE_HYP_SECANT", "INVERSE_HYP_COTANGENT",
-            "NATURAL_LOGARITHM", "POWER_E"
+            "NATURAL_LOGARITHM", "POWER_E", "POLAR"
+        };
+        auto singleOperand = [&SingleOperand_Queries](const std::string &keyWord) {
+            return SingleOperand_Queries.contains(keyWord) ||
+                   Plugins::single_operand(keyWord, Plugins::Kind::complex);
         };
         if (query.rfind("SET", 0) == 0) // if query is variable definition skip tokenization+parsing
             return true;
         if (std::smatch matches; std::regex_match(query, matches, grammar::queries::var_get)) {
             if (!resolved_varMap.contains(matches[2].str()))
-                throw std::runtime_error("\nError: Attempt to access undefined variable");
-            std::string keyWord = matches[1].str();
-            std::string firstOperand = matches[2].str();
-            std::string secondOperand = resolved_varMap.at(matches[2].str());
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+                return undefined(matches, 2);
+            emit(matches[1].str(), matches[2].str(), resolved_varMap.at(matches[2].str()), column(matches, 2), 0);
             return true;
         } else if (std::regex_match(query, matches, grammar::queries::complexQueryS)) {
-            if (const std::string keyWord = matches[1].str(); SingleOperand_Queries.contains(keyWord)) {
-                const std::string firstOperand = matches[2].str();
-                tokens.emplace_back(keyWord, firstOperand, "");
+            if (const std::string keyWord = matches[1].str(); singleOperand(keyWord)) {
+                emit(keyWord, matches[2].str(), "", column(matches, 2), 0);
                 return true;
             }
         } else if (std::regex_match(query, matches, grammar::queries::QuerySV)) {
-            if (const std::string keyWord = matches[1].str(); SingleOperand_Queries.contains(keyWord)) {
+            if (const std::string keyWord = matches[1].str(); singleOperand(keyWord)) {
                 std::string firstOperand = getVar(matches[2].str());
                 if (firstOperand.empty())
-                    throw std::runtime_error("\nError: Undeclared Variable Called !");
-                tokens.emplace_back(keyWord, firstOperand, "");
+                    return undefined(matches, 2);
+                emit(keyWord, std::move(firstOperand), "", column(matches, 2), 0);
                 return true;
             }
         } else if (std::regex_match(query, matches, grammar::queries::complexQueryD)) {
             const std::string keyWord = matches[1].str();
-            if (SingleOperand_Queries.contains(keyWord)) return false;
-            const std::string firstOperand = matches[2].str();
-            const std::string secondOperand = matches[12].str();
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+            if (singleOperand(keyWord)) return false;
+            emit(keyWord, matches[2].str(), matches[12].str(), column(matches, 2), column(matches, 12));
             return true;
         } else if (std::regex_match(query, matches, grammar::queries::QueryDV)) {
             const std::string keyWord = matches[1].str();
-            if (SingleOperand_Queries.contains(keyWord)) return false;
-            const std::string firstOperand = getVar(matches[2].str());
-            const std::string secondOperand = getVar(matches[3].str());
+            if (singleOperand(keyWord)) return false;
+            std::string firstOperand = getVar(matches[2].str());
+            std::string secondOperand = getVar(matches[3].str());
             if (firstOperand.empty() || secondOperand.empty())
-                throw std::runtime_error("\nError: Undeclared Variable Called !");
-            tokens.emplace_back(keyWord, firstOperand, secondOperand);
+                return undefined(matches, firstOperand.empty() ? 2 : 3);
+            emit(keyWord, std::move(firstOperand), std::move(secondOperand), column(matches, 2), column(matches, 3));
             return true;
         }
         return false;
     };
-    for (const auto &query: queries) {
-        if (processReal(query) || processComplex(query))
+    auto processBatch = [&](const std::string &query) {
+        // list and range operands are kept verbatim, the parser expands them into contiguous batches.
+        if (std::smatch matches; std::regex_match(query, matches, grammar::queries::integralQuery)) {
+            // the integrand is kept with the keyword, the bounds are a batch of two elements.
+            emit(matches[1].str() + " " + matches[2].str(), matches[3].str(), "", column(matches, 3), 0);
+            return true;
+        } else if (std::regex_match(query, matches, grammar::queries::batchQueryS)) {
+            emit(matches[1].str(), matches[2].str(), "", column(matches, 2), 0);
+            return true;
+        } else if (std::regex_match(query, matches, grammar::queries::batchQueryD)) {
+            emit(matches[1].str(), matches[2].str(), matches[3].str(), column(matches, 2), column(matches, 3));
+            return true;
+        }
+        return false;
+    };
+    auto processMatrix = [&](const std::string &query) {
+        if (std::smatch matches; std::regex_match(query, matches, grammar::queries::matrixQueryD)) {
+            emit(matches[1].str(), matches[2].str(), matches[4].str(), column(matches, 2), column(matches, 4));
+            return true;
+        } else if (std::regex_match(query, matches, grammar::queries::matrixQueryS)) {
+            emit(matches[1].str(), matches[2].str(), "", column(matches, 2), 0);
+            return true;
+        }
+        return false;
+    };
+    auto substituteLiterals = [&](const std::string &query) {
+        // variables holding list, vector or matrix literals are replaced by their literal, so that the query
+        // reaches processMatrix and processBatch like a query written with the literals themselves.
+        auto literal = [&](const std::string &varName) {
+            std::string value = getVar(varName);
+            return !value.empty() && value.front() == '[' ? value : std::string("");
+        };
+        if (std::smatch matches; std::regex_match(query, matches, grammar::queries::QueryDV)) {
+            const std::string firstOperand = literal(matches[2].str());
+            const std::string secondOperand = literal(matches[3].str());
+            if (!firstOperand.empty() && !secondOperand.empty())
+                return matches[1].str() + " " + firstOperand + "," + secondOperand;
+        } else if (std::regex_match(query, matches, grammar::queries::QuerySV) && matches[1].str() != "GET") {
+            if (const std::string firstOperand = literal(matches[2].str()); !firstOperand.empty())
+                return matches[1].str() + " " + firstOperand;
+        }
+        return query;
+    };
+    for (; index < queries.size(); ++index) {
+        // the columns of a query with substituted literals are the ones of the substituted query.
+        if (processLiterals(queries[index]))
+            continue;
+        const std::string query = substituteLiterals(queries[index]);
+        if (processMatrix(query) || processBatch(query) || processReal(query) || processComplex(query))
             continue; // if correct  then goto new query and pass it to tokens
         else {
-            tokens.emplace_back(query, "", "");
+            emit(query, "", "", 0, 0);
         }
     }
-    return tokens;
+    return tokenized;
 }
 
 
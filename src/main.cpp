@@ -1,9 +1,11 @@
 #include "cli/CLInterface.hpp"
+#include "core/helpers/arena.hpp"
 #include "fmt/color.h"
 #include <memory>
 
 
 int main(int argc, char *argv[]) {
+    mmqli::core::arena::install(); // before any number is created
     try {
         const auto cli = std::make_unique<mmqli::cli::CLInterface>(argc, argv);
         try {
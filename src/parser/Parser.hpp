@@ -3,114 +3,633 @@
 
 #include "../lexer/Lexer.hpp"
 #include "../core/helpers/constants.hpp"
+#include "../core/helpers/exact.hpp"
+#include "../core/helpers/radix.hpp"
 #include "../core/helpers/boost_fwd.hpp"
+#include "../core/helpers/cancel.hpp"
+#include "../core/helpers/linalg.hpp"
+#include "../core/helpers/geometry.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <complex>
+#include <fstream>
+#include <sstream>
 #include <utility>
 
+/**
+ * @brief Where the parsed queries come from, the source of every query of every kind, in the order the Parser hands
+ * the queries over, and the operands of the real queries as they are written.
+ */
+struct ParsedSources {
+    std::vector<TokenSource> reals;
+    std::vector<std::array<std::string, 2> > real_operands; // aligned with reals, empty for a variable lookup
+    std::vector<TokenSource> complex;
+    std::vector<TokenSource> real_batches;
+    std::vector<TokenSource> complex_batches;
+    std::vector<TokenSource> real_matrices;
+    std::vector<TokenSource> complex_matrices;
+    std::vector<TokenSource> point_sets;
+    std::vector<TokenSource> exact;
+};
+
 class Parser {
-    std::vector<std::tuple<std::string, std::string, std::string> > raw_tokens;
+    using Error = mmqli::core::error::Error;
+    using Code = mmqli::core::error::Code;
+    template<typename T>
+    using Result = mmqli::core::error::Result<T>;
+
+    std::vector<Token> raw_tokens;
+    std::vector<TokenSource> raw_sources;
+    std::vector<std::tuple<std::string, mpq_class, mpq_class> > exactNum_parsed;
     std::vector<std::tuple<std::string, float1000, float1000> > realNum_parsed;
     std::vector<std::tuple<std::string, complex1000, complex1000> > complexNums_parsed;
+    std::vector<std::tuple<std::string, std::vector<float1000>, std::vector<float1000> > > realBatches_parsed;
+    std::vector<std::tuple<std::string, std::vector<complex1000>, std::vector<complex1000> > > complexBatches_parsed;
+    std::vector<std::tuple<std::string, mmqli::core::linalg::DynamicMatrix<float1000>,
+        mmqli::core::linalg::DynamicMatrix<float1000> > > realMatrices_parsed;
+    std::vector<std::tuple<std::string, mmqli::core::linalg::DynamicMatrix<complex1000>,
+        mmqli::core::linalg::DynamicMatrix<complex1000> > > complexMatrices_parsed;
+    std::vector<std::tuple<std::string, mmqli::core::geometry::PointSet,
+        mmqli::core::geometry::PointSet> > pointSets_parsed;
+    ParsedSources sources_parsed;
+    std::vector<Error> errors_parsed;
+    std::unordered_map<std::string, std::vector<std::string> > raw_batches;
+    std::unordered_map<std::string, mmqli::core::linalg::DynamicMatrix<std::string> > raw_matrices;
+    static constexpr std::size_t max_batch_size = 10'000'000; // upper bound on the elements a single literal may expand to
 
-    static float1000 STOD(const std::string &num) {
-        if (std::smatch matches; std::regex_match(num, matches, grammar::numbers::realNum))
-            return float1000(matches[1].str());
-        else if (num.empty())
-            return {0};
+    // a rational literal p/q is a real number too, rounded to float1000 where it is not taken exactly.
+    static Result<float1000> STOD(const std::string &num) {
+        if (mmqli::core::radix::real_literal(num))
+            return float1000(num);
+        else if (num.find('/') != std::string::npos && mmqli::core::exact::literal(num)) {
+            auto exact{to_exact(num)};
+            if (!exact)
+                return std::unexpected{std::move(exact.error())};
+            return mmqli::core::exact::promote(*exact);
+        } else if (num.empty())
+            return float1000{0};
         else
-            throw std::invalid_argument("No Number ??");
+            return mmqli::core::error::fail(Code::invalid_number, num + " is not a real number !");
+    }
+
+    // count numbers of bytes each, against the memory limit of the queries, see cancel::fits.
+    static Result<void> admit(const std::size_t count, const std::size_t bytes) {
+        if (!mmqli::core::cancel::fits(count * bytes))
+            return mmqli::core::error::fail(Code::memory_limit, mmqli::core::cancel::too_large(count * bytes));
+        return {};
+    }
+
+    static Result<mpq_class> to_exact(const std::string &num) {
+        auto exact{mmqli::core::exact::parse(num)};
+        if (!exact)
+            return mmqli::core::error::fail(Code::invalid_number, num + " has a zero denominator !");
+        return std::move(*exact);
     }
 
-    static complex1000 convert_to_complex(const std::string &cmplx_num) {
+    static Result<complex1000> convert_to_complex(const std::string &cmplx_num) {
         if (std::smatch matches; std::regex_match(cmplx_num, matches, grammar::numbers::complexNum)) {
-            const float1000 realPart(matches[2].str());
+            // a number without a real part, such as 2i, is purely imaginary.
+            const float1000 realPart(matches[2].length() == 0 ? float1000(0) : float1000(matches[2].str()));
             const float1000 imagPart(matches[7].str());
-            complex1000 complex1(realPart, imagPart);
-            return complex1;
+            return complex1000(realPart, imagPart);
         } else if (cmplx_num.empty()) {
-            return {float1000(0), float1000(0)};
+            return complex1000{float1000(0), float1000(0)};
         } else
-            throw std::invalid_argument("No Complex Number ??");
+            return mmqli::core::error::fail(Code::invalid_number, cmplx_num + " is not a complex number !");
     }
 
-public:
-    explicit Parser(const std::vector<std::string> &queries,
-                    const std::unordered_map<std::string, std::string> &varMap = {}) {
-        raw_tokens = tokenize(queries, varMap);
+    static Result<std::vector<std::string> > read_batch_file(const std::string &path) {
+        std::ifstream file(path);
+        if (!file)
+            return mmqli::core::error::fail(Code::unreadable_file, "Cannot read the file " + path + " !");
+        std::vector<std::string> elements;
+        for (std::string element; file >> element;) {
+            std::stringstream stream(element); // commas are allowed between the numbers as well
+            for (std::string number; std::getline(stream, number, ',');)
+                if (!number.empty())
+                    elements.emplace_back(std::move(number));
+        }
+        return elements;
+    }
+
+    /**
+     * Splits a list literal @code [a,b,c] @endcode or reads the numbers of a file literal @code [@path] @endcode.
+     * The raw elements are cached, since a batch is looked at both to find its kind and to convert it.
+     */
+    Result<const std::vector<std::string> *> split_batch(const std::string &batch) {
+        if (const auto it = raw_batches.find(batch); it != raw_batches.end())
+            return &it->second;
+        std::smatch matches;
+        std::vector<std::string> elements;
+        if (std::regex_match(batch, matches, grammar::numbers::batchFile)) {
+            auto read{read_batch_file(matches[1].str())};
+            if (!read)
+                return std::unexpected{std::move(read.error())};
+            elements = std::move(*read);
+        } else if (std::regex_match(batch, matches, grammar::numbers::batchList)) {
+            std::stringstream stream(matches[1].str());
+            for (std::string element; std::getline(stream, element, ',');) {
+                std::erase_if(element, [](const unsigned char c) { return std::isspace(c); });
+                if (element.empty())
+                    return mmqli::core::error::fail(Code::invalid_literal, "Empty element in the list " + batch + " !");
+                elements.emplace_back(std::move(element));
+            }
+        } else
+            return mmqli::core::error::fail(Code::invalid_literal, batch + " is not a list !");
+        if (elements.empty())
+            return mmqli::core::error::fail(Code::invalid_literal, "The list " + batch + " is empty !");
+        if (elements.size() > max_batch_size)
+            return mmqli::core::error::fail(Code::invalid_literal, "The list " + batch + " is too large !");
+        return &raw_batches.emplace(batch, std::move(elements)).first->second;
     }
 
-    explicit Parser(const std::vector<std::tuple<std::string, std::string, std::string> > &token) {
-        raw_tokens = token;
+    // a malformed batch is not complex, its error is reported when it is converted.
+    bool holds_complex(const std::string &batch) {
+        if (!is_batch(batch) || std::regex_match(batch, grammar::numbers::realRange))
+            return false;
+        const auto elements{split_batch(batch)};
+        return elements && std::ranges::any_of(**elements, [](const std::string &e) { return e.back() == 'i'; });
     }
 
-    std::vector<std::tuple<std::string, float1000, float1000> > parse_RealNums() {
-        for (const auto &raw_token: raw_tokens) {
-            [[maybe_unused]]
-                    float1000 fOperand(0);
-            [[maybe_unused]]
-                    float1000 sOperand(0);
-            std::string queryToken = std::get < 0 > (raw_token);
-            if (queryToken == "GET") {
-                std::string full = "GET " + std::get < 1 > (raw_token) + " = ";
-                try {
-                    auto s = STOD(std::get < 2 > (raw_token));
-                    full += std::get < 2 > (raw_token);
-                } catch (...) {
-                    continue;
-                }
-                realNum_parsed.emplace_back(full, ZERO, ZERO);
-                continue;
-            }
-            try {
-                fOperand = STOD(std::get < 1 > (raw_token));
-                sOperand = STOD(std::get < 2 > (raw_token));
-            } catch (...) {
-                continue;
-            }
-            if (queryToken == "ERROR") {
-                realNum_parsed.emplace_back(queryToken, ZERO, ZERO);
+    /**
+     * Expands a range literal @code [start:stop:step] @endcode, a list literal @code [a,b,c] @endcode or a file literal
+     * @code [@path] @endcode of real numbers.
+     * Range elements are computed as start + i*step, so no rounding error accumulates along the range.
+     */
+    Result<std::vector<float1000> > expand_real_batch(const std::string &batch) {
+        std::vector<float1000> elements;
+        if (std::smatch matches; std::regex_match(batch, matches, grammar::numbers::realRange)) {
+            const float1000 start(matches[1].str());
+            const float1000 stop(matches[5].str());
+            const float1000 step(matches[9].str());
+            if (step == 0 || (stop - start) / step < 0)
+                return mmqli::core::error::fail(Code::invalid_literal, "The range " + batch + " is empty !");
+            const float1000 span{(stop - start) / step};
+            float1000 last{round(span)};
+            if (fabs(span - last) > std::numeric_limits<float1000>::epsilon() * 16 * (last + 1))
+                last = floor(span); // the stop value is not hit exactly, so it is excluded
+            if (last >= max_batch_size)
+                return mmqli::core::error::fail(Code::invalid_literal, "The range " + batch + " is too large !");
+            const auto count = static_cast<std::size_t>(last) + 1;
+            if (auto admitted{admit(count, mmqli::core::cancel::real_bytes)}; !admitted)
+                return std::unexpected{std::move(admitted.error())};
+            elements.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+                elements.emplace_back(start + step * i);
+            return elements;
+        }
+        const auto raw_elements{split_batch(batch)};
+        if (!raw_elements)
+            return std::unexpected{raw_elements.error()};
+        if (auto admitted{admit((*raw_elements)->size(), mmqli::core::cancel::real_bytes)}; !admitted)
+            return std::unexpected{std::move(admitted.error())};
+        elements.reserve((*raw_elements)->size());
+        for (const auto &element: **raw_elements) {
+            auto number{STOD(element)};
+            if (!number)
+                return std::unexpected{std::move(number.error())};
+            elements.emplace_back(std::move(*number));
+        }
+        return elements;
+    }
+
+    /**
+     * Expands a list or file literal of complex numbers, real elements and real ranges are promoted to complex numbers.
+     */
+    Result<std::vector<complex1000> > expand_complex_batch(const std::string &batch) {
+        std::vector<complex1000> elements;
+        if (std::regex_match(batch, grammar::numbers::realRange)) {
+            auto reals{expand_real_batch(batch)};
+            if (!reals)
+                return std::unexpected{std::move(reals.error())};
+            elements.reserve(reals->size());
+            for (auto &real: *reals)
+                elements.emplace_back(std::move(real), float1000(0));
+            return elements;
+        }
+        const auto raw_elements{split_batch(batch)};
+        if (!raw_elements)
+            return std::unexpected{raw_elements.error()};
+        if (auto admitted{admit((*raw_elements)->size(), 2 * mmqli::core::cancel::real_bytes)}; !admitted)
+            return std::unexpected{std::move(admitted.error())};
+        elements.reserve((*raw_elements)->size());
+        for (const auto &element: **raw_elements) {
+            auto number{to_complex(element)};
+            if (!number)
+                return std::unexpected{std::move(number.error())};
+            elements.emplace_back(std::move(*number));
+        }
+        return elements;
+    }
+
+    // an element of a complex batch or matrix, real elements are promoted.
+    static Result<complex1000> to_complex(const std::string &element) {
+        if (element.back() == 'i')
+            return convert_to_complex(element);
+        auto real{STOD(element)};
+        if (!real)
+            return std::unexpected{std::move(real.error())};
+        return complex1000(std::move(*real), float1000(0));
+    }
+
+    static Result<std::vector<std::string> > split_row(const std::string &row) {
+        std::vector<std::string> elements;
+        std::stringstream stream(row);
+        for (std::string element; std::getline(stream, element, ',');) {
+            std::erase_if(element, [](const unsigned char c) { return std::isspace(c); });
+            if (element.empty())
+                return mmqli::core::error::fail(Code::invalid_literal, "Empty element in the matrix row [" + row + "] !");
+            elements.emplace_back(std::move(element));
+        }
+        return elements;
+    }
+
+    /**
+     * Splits a matrix literal @code [[a,b],[c,d]] @endcode, reads a matrix file @code [[@path]] @endcode holding one
+     * row per line, or takes a vector literal @code [a,b] @endcode / @code [@path] @endcode as a matrix of one column.
+     * The raw elements are cached, since a matrix is looked at both to find its kind and to convert it.
+     */
+    Result<const mmqli::core::linalg::DynamicMatrix<std::string> *> split_matrix(const std::string &literal) {
+        if (const auto it = raw_matrices.find(literal); it != raw_matrices.end())
+            return &it->second;
+        mmqli::core::linalg::DynamicMatrix<std::string> matrix;
+        auto append_row = [&](std::vector<std::string> &&row) -> Result<void> {
+            if (row.empty())
+                return {};
+            if (matrix.rows++ == 0)
+                matrix.cols = row.size();
+            else if (row.size() != matrix.cols)
+                return mmqli::core::error::fail(Code::invalid_literal, "The rows of the matrix differ in length !");
+            std::ranges::move(row, std::back_inserter(matrix.elements));
+            if (matrix.elements.size() > max_batch_size)
+                return mmqli::core::error::fail(Code::invalid_literal, "The matrix is too large !");
+            return admit(matrix.elements.size(), mmqli::core::cancel::real_bytes);
+        };
+        if (std::smatch matches; std::regex_match(literal, matches, grammar::numbers::matrixFile)) {
+            std::ifstream file(matches[1].str());
+            if (!file)
+                return mmqli::core::error::fail(Code::unreadable_file, "Cannot read the file " + matches[1].str() + " !");
+            for (std::string line; std::getline(file, line);) {
+                std::ranges::replace(line, ',', ' ');
+                std::stringstream stream(line);
+                std::vector<std::string> row;
+                for (std::string element; stream >> element;)
+                    row.emplace_back(std::move(element));
+                if (auto appended{append_row(std::move(row))}; !appended)
+                    return std::unexpected{std::move(appended.error())};
             }
-            if (std::get < 2 > (raw_token).empty()) {
-                realNum_parsed.emplace_back(queryToken, fOperand, ZERO);
-            } else {
-                realNum_parsed.emplace_back(queryToken, fOperand, sOperand);
+        } else if (std::regex_match(literal, grammar::numbers::matrix)) {
+            const std::sregex_iterator end;
+            for (std::sregex_iterator row(literal.begin(), literal.end(), grammar::numbers::matrixRow); row != end; ++row) {
+                auto elements{split_row((*row)[1].str())};
+                if (!elements)
+                    return std::unexpected{std::move(elements.error())};
+                if (auto appended{append_row(std::move(*elements))}; !appended)
+                    return std::unexpected{std::move(appended.error())};
             }
+        } else {
+            const auto elements{split_batch(literal)};
+            if (!elements)
+                return std::unexpected{elements.error()};
+            matrix.elements = **elements;
+            matrix.rows = matrix.elements.size();
+            matrix.cols = 1;
+            matrix.vector = true;
         }
-        return realNum_parsed;
+        if (matrix.rows == 0 || matrix.cols == 0)
+            return mmqli::core::error::fail(Code::invalid_literal, "The matrix is empty !");
+        return &raw_matrices.emplace(literal, std::move(matrix)).first->second;
     }
 
-    std::vector<std::tuple<std::string, complex1000, complex1000> > parse_cmplxNums() {
-        for (const auto &raw_token: raw_tokens) {
-            complex1000 fOperand(float1000(0), float1000(0));
-            complex1000 sOperand(float1000(0), float1000(0));
-            std::string queryToken = std::get < 0 > (raw_token);
-            if (queryToken == "GET") {
-                std::string full = "GET " + std::get < 1 > (raw_token) + " = ";
-                try {
-                    auto s = convert_to_complex(std::get < 2 > (raw_token));
-                    full += std::get < 2 > (raw_token);
-                } catch (...) {
+    // a malformed matrix is not complex, its error is reported when it is converted.
+    bool matrix_holds_complex(const std::string &literal) {
+        if (literal.empty())
+            return false;
+        const auto matrix{split_matrix(literal)};
+        return matrix && std::ranges::any_of((*matrix)->elements, [](const std::string &e) { return e.back() == 'i'; });
+    }
+
+    /**
+     * Converts the raw elements of a matrix, @p convert turns one element into a number.
+     */
+    template<typename T, typename Convert>
+    Result<mmqli::core::linalg::DynamicMatrix<T> > expand_matrix(const std::string &literal, Convert &&convert) {
+        const auto raw{split_matrix(literal)};
+        if (!raw)
+            return std::unexpected{raw.error()};
+        mmqli::core::linalg::DynamicMatrix<T> matrix{(*raw)->rows, (*raw)->cols, {}, (*raw)->vector};
+        matrix.elements.reserve((*raw)->elements.size());
+        for (const auto &element: (*raw)->elements) {
+            auto number{convert(element)};
+            if (!number)
+                return std::unexpected{std::move(number.error())};
+            matrix.elements.emplace_back(std::move(*number));
+        }
+        return matrix;
+    }
+
+    static Result<double> to_double(const std::string &num) {
+        double value{0};
+        if (const auto [end, error] = std::from_chars(num.data(), num.data() + num.size(), value);
+            error != std::errc{} || end != num.data() + num.size())
+            return mmqli::core::error::fail(Code::invalid_number, num + " is not a number !");
+        return value;
+    }
+
+    /**
+     * Reads the points of a FAST_ geometry query straight into doubles. A point file @code [[@path]] @endcode is read
+     * in one piece and scanned in place, one point per line, so that sets of millions of points never go through
+     * strings or float1000. Literals go through @ref split_matrix, a vector @code [x,y] @endcode is a single point.
+     */
+    Result<mmqli::core::geometry::PointSet> expand_points(const std::string &literal) {
+        mmqli::core::geometry::PointSet points;
+        auto two_coordinates = [] {
+            return mmqli::core::error::fail(Code::invalid_literal, "A point must have two coordinates !");
+        };
+        if (std::smatch matches; std::regex_match(literal, matches, grammar::numbers::matrixFile)) {
+            std::ifstream file(matches[1].str(), std::ios::binary);
+            if (!file)
+                return mmqli::core::error::fail(Code::unreadable_file, "Cannot read the file " + matches[1].str() + " !");
+            const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            const char *cursor{text.data()};
+            const char *const last{text.data() + text.size()};
+            double line[2];
+            std::size_t on_line{0};
+            while (cursor != last) {
+                if (*cursor == '\n' || *cursor == ' ' || *cursor == ',' || *cursor == '\t' || *cursor == '\r') {
+                    if (*cursor++ == '\n' && on_line != 0) {
+                        if (on_line != 2)
+                            return two_coordinates();
+                        points.x.push_back(line[0]);
+                        points.y.push_back(line[1]);
+                        on_line = 0;
+                    }
                     continue;
                 }
-                complexNums_parsed.emplace_back(full, zero, zero);
-                continue;
-            }
-            try {
-                fOperand = convert_to_complex(std::get < 1 > (raw_token));
-                sOperand = convert_to_complex(std::get < 2 > (raw_token));
-            } catch (...) {
-                continue;
+                if (on_line == 2)
+                    return two_coordinates();
+                const auto [end, error] = std::from_chars(cursor, last, line[on_line++]);
+                if (error != std::errc{})
+                    return mmqli::core::error::fail(Code::invalid_number, "The file " + matches[1].str() +
+                                                                          " holds something else than a number !");
+                cursor = end;
             }
-            if (queryToken == "ERROR") {
-                complexNums_parsed.emplace_back(queryToken, zero, zero);
+            if (on_line == 2) { // last line without a new line
+                points.x.push_back(line[0]);
+                points.y.push_back(line[1]);
+            } else if (on_line != 0)
+                return two_coordinates();
+            if (points.size() == 0 || 2 * points.size() > max_batch_size)
+                return mmqli::core::error::fail(Code::invalid_literal, "The file " + matches[1].str() +
+                                                                       " holds no points or too many !");
+            return points;
+        }
+        const auto raw{split_matrix(literal)};
+        if (!raw)
+            return std::unexpected{raw.error()};
+        const auto &elements{(*raw)->elements};
+        if (!((*raw)->cols == 2 || ((*raw)->vector && (*raw)->rows == 2)))
+            return two_coordinates();
+        points.x.reserve(elements.size() / 2);
+        points.y.reserve(elements.size() / 2);
+        for (std::size_t i = 0; i + 1 < elements.size(); i += 2) {
+            const auto x{to_double(elements[i])};
+            const auto y{to_double(elements[i + 1])};
+            if (!x || !y)
+                return std::unexpected{x ? y.error() : x.error()};
+            points.x.push_back(*x);
+            points.y.push_back(*y);
+        }
+        return points;
+    }
+
+    static bool is_fast_query(const std::string &query) {
+        return query.starts_with("FAST_");
+    }
+
+    static bool is_matrix(const std::string &operand) {
+        return std::regex_match(operand, grammar::numbers::matrix);
+    }
+
+    static bool is_batch(const std::string &operand) {
+        return !operand.empty() && operand.front() == '[';
+    }
+
+    // the error of an operand, placed at the operand in its query.
+    static std::unexpected<Error> at(Error error, const TokenSource &source, const std::size_t column) {
+        error.where = {source.query, column};
+        return std::unexpected{std::move(error)};
+    }
+
+    /**
+     * Converts the operands of one token and files the query under the kind its operands hold: matrices (point sets
+     * for FAST_ queries), batches, then real numbers and complex numbers. The kind is found by looking at the
+     * operands, so every operand is converted once, and a conversion only fails when the query is wrong.
+     * @return the error of the first operand that cannot be converted, at the column of the operand.
+     */
+    Result<void> parse_token(const Token &token, const TokenSource &source) {
+        const auto &[query, first, second] = token;
+        if (query == "GET") {
+            if (is_batch(second) || STOD(second)) { // list, vector or matrix literal, or a real number
+                realNum_parsed.emplace_back("GET " + first + " = " + second, mmqli::core::constants::real_zero,
+                                            mmqli::core::constants::real_zero);
+                sources_parsed.reals.push_back(source);
+                sources_parsed.real_operands.emplace_back();
+                return {};
             }
-            if (std::get < 2 > (raw_token).empty()) {
-                complexNums_parsed.emplace_back(queryToken, fOperand, zero);
-            } else {
-                complexNums_parsed.emplace_back(queryToken, fOperand, sOperand);
+            if (auto value{convert_to_complex(second)}; !value)
+                return at(std::move(value.error()), source, source.first);
+            complexNums_parsed.emplace_back("GET " + first + " = " + second, mmqli::core::constants::complex_zero,
+                                            mmqli::core::constants::complex_zero);
+            sources_parsed.complex.push_back(source);
+            return {};
+        }
+        if (is_batch(first) && is_matrix(first)) {
+            if (is_fast_query(query)) {
+                auto fOperand{expand_points(first)};
+                if (!fOperand)
+                    return at(std::move(fOperand.error()), source, source.first);
+                mmqli::core::geometry::PointSet sOperand;
+                if (!second.empty()) {
+                    auto points{expand_points(second)};
+                    if (!points)
+                        return at(std::move(points.error()), source, source.second);
+                    sOperand = std::move(*points);
+                }
+                pointSets_parsed.emplace_back(query, std::move(*fOperand), std::move(sOperand));
+                sources_parsed.point_sets.push_back(source);
+                return {};
             }
+            if (matrix_holds_complex(first) || matrix_holds_complex(second))
+                return file_matrix<complex1000>(query, first, second, source, to_complex, complexMatrices_parsed,
+                                                sources_parsed.complex_matrices);
+            return file_matrix<float1000>(query, first, second, source, STOD, realMatrices_parsed,
+                                          sources_parsed.real_matrices);
+        }
+        if (is_batch(first)) {
+            if (holds_complex(first) || holds_complex(second))
+                return file_batch(query, first, second, source, &Parser::expand_complex_batch, complexBatches_parsed,
+                                  sources_parsed.complex_batches);
+            return file_batch(query, first, second, source, &Parser::expand_real_batch, realBatches_parsed,
+                              sources_parsed.real_batches);
+        }
+        // integer and rational operands are kept exact for the queries that have an exact answer.
+        if (mmqli::core::exact::handles(query) && mmqli::core::exact::literal(first) &&
+            (second.empty() || mmqli::core::exact::literal(second))) {
+            auto fOperand{to_exact(first)};
+            if (!fOperand)
+                return at(std::move(fOperand.error()), source, source.first);
+            auto sOperand{to_exact(second)};
+            if (!sOperand)
+                return at(std::move(sOperand.error()), source, source.second);
+            exactNum_parsed.emplace_back(query, std::move(*fOperand), std::move(*sOperand));
+            sources_parsed.exact.push_back(source);
+            return {};
+        }
+        // a complex operand ends with i, a real one never does.
+        if (!first.ends_with('i') && !second.ends_with('i')) {
+            auto fOperand{STOD(first)};
+            if (!fOperand)
+                return at(std::move(fOperand.error()), source, source.first);
+            auto sOperand{STOD(second)};
+            if (!sOperand)
+                return at(std::move(sOperand.error()), source, source.second);
+            realNum_parsed.emplace_back(query, std::move(*fOperand), std::move(*sOperand));
+            sources_parsed.reals.push_back(source);
+            sources_parsed.real_operands.push_back({first, second});
+            return {};
+        }
+        auto fOperand{convert_to_complex(first)};
+        if (!fOperand)
+            return at(std::move(fOperand.error()), source, source.first);
+        auto sOperand{convert_to_complex(second)};
+        if (!sOperand)
+            return at(std::move(sOperand.error()), source, source.second);
+        complexNums_parsed.emplace_back(query, std::move(*fOperand), std::move(*sOperand));
+        sources_parsed.complex.push_back(source);
+        return {};
+    }
+
+    template<typename Expand, typename Parsed>
+    Result<void> file_batch(const std::string &query, const std::string &first, const std::string &second,
+                            const TokenSource &source, const Expand expand, Parsed &parsed,
+                            std::vector<TokenSource> &sources) {
+        auto fOperands{(this->*expand)(first)};
+        if (!fOperands)
+            return at(std::move(fOperands.error()), source, source.first);
+        std::remove_cvref_t<decltype(*fOperands)> sOperands;
+        if (is_batch(second)) {
+            auto expanded{(this->*expand)(second)};
+            if (!expanded)
+                return at(std::move(expanded.error()), source, source.second);
+            sOperands = std::move(*expanded);
+        }
+        parsed.emplace_back(query, std::move(*fOperands), std::move(sOperands));
+        sources.push_back(source);
+        return {};
+    }
+
+    template<typename T, typename Convert, typename Parsed>
+    Result<void> file_matrix(const std::string &query, const std::string &first, const std::string &second,
+                             const TokenSource &source, Convert &&convert, Parsed &parsed,
+                             std::vector<TokenSource> &sources) {
+        auto fOperand{expand_matrix<T>(first, convert)};
+        if (!fOperand)
+            return at(std::move(fOperand.error()), source, source.first);
+        mmqli::core::linalg::DynamicMatrix<T> sOperand;
+        if (!second.empty()) {
+            auto expanded{expand_matrix<T>(second, convert)};
+            if (!expanded)
+                return at(std::move(expanded.error()), source, source.second);
+            sOperand = std::move(*expanded);
         }
-        return complexNums_parsed;
+        parsed.emplace_back(query, std::move(*fOperand), std::move(sOperand));
+        sources.push_back(source);
+        return {};
+    }
+
+    void parse_tokens() {
+        for (std::size_t i = 0; i < raw_tokens.size(); ++i)
+            if (auto parsed{parse_token(raw_tokens[i], raw_sources[i])}; !parsed)
+                errors_parsed.push_back(std::move(parsed.error()));
+        // the errors of the lexer come first, they are put back in the order of the queries.
+        std::ranges::stable_sort(errors_parsed, {}, [](const Error &error) { return error.where.query; });
+    }
+
+public:
+    explicit Parser(const std::vector<std::string> &queries,
+                    const std::unordered_map<std::string, std::string> &varMap = {})
+        : Parser(tokenize(queries, varMap)) {}
+
+    /**
+     * The queries that could not be tokenized are reported by @ref parse_Errors, next to the ones that cannot be
+     * parsed.
+     */
+    explicit Parser(TokenizedQueries tokenized)
+        : raw_tokens(std::move(tokenized.tokens)), raw_sources(std::move(tokenized.sources)),
+          errors_parsed(std::move(tokenized.errors)) {
+        parse_tokens();
+    }
+
+    // tokens made by hand have no columns, the token index stands for the query index.
+    explicit Parser(const std::vector<Token> &token) : raw_tokens(token) {
+        for (std::size_t i = 0; i < raw_tokens.size(); ++i)
+            raw_sources.push_back({i, 0, 0});
+        parse_tokens();
+    }
+
+    /**
+     * The queries over integer and rational literals that have an exact answer, see @ref mmqli::core::exact.
+     */
+    std::vector<std::tuple<std::string, mpq_class, mpq_class> > parse_ExactNums() {
+        return std::exchange(exactNum_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, float1000, float1000> > parse_RealNums() {
+        return std::exchange(realNum_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, complex1000, complex1000> > parse_cmplxNums() {
+        return std::exchange(complexNums_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, std::vector<float1000>, std::vector<float1000> > > parse_RealBatches() {
+        return std::exchange(realBatches_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, std::vector<complex1000>, std::vector<complex1000> > > parse_cmplxBatches() {
+        return std::exchange(complexBatches_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, mmqli::core::linalg::DynamicMatrix<float1000>,
+        mmqli::core::linalg::DynamicMatrix<float1000> > > parse_RealMatrices() {
+        return std::exchange(realMatrices_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, mmqli::core::linalg::DynamicMatrix<complex1000>,
+        mmqli::core::linalg::DynamicMatrix<complex1000> > > parse_cmplxMatrices() {
+        return std::exchange(complexMatrices_parsed, {});
+    }
+
+    std::vector<std::tuple<std::string, mmqli::core::geometry::PointSet,
+        mmqli::core::geometry::PointSet> > parse_PointSets() {
+        return std::exchange(pointSets_parsed, {});
+    }
+
+    /**
+     * Where the parsed queries come from, see @ref mmqli::core::Core::locate.
+     */
+    ParsedSources parse_Sources() {
+        return std::exchange(sources_parsed, {});
+    }
+
+    /**
+     * The queries that could not be tokenized or parsed, in the order of the queries. The other queries are parsed
+     * all the same.
+     */
+    std::vector<Error> parse_Errors() {
+        return std::exchange(errors_parsed, {});
     }
 };
 
@@ -0,0 +1,81 @@
+#ifndef MMQLC_PLUGIN_H
+#define MMQLC_PLUGIN_H
+
+/*
+ * The interface between mmqlc and a plugin, a shared object loaded with --plugin <path>. It is plain C, so a plugin
+ * can be written in C or in C++ (with its exported functions declared extern "C") and built with another compiler
+ * than mmqlc.
+ *
+ * A plugin exports two functions:
+ *   unsigned mmqlc_plugin_abi_version(void);         returns MMQLC_PLUGIN_ABI_VERSION
+ *   int mmqlc_plugin_init(const mmqlc_host *host);   registers its functions, returns 0 on success
+ *
+ * Every registered function becomes a query keyword, evaluated like the built-in ones on real or complex numbers and
+ * element-wise on batches. A built-in keyword always takes precedence over a plugin function of the same name.
+ *
+ * The functions receive the MPFR numbers of mmqlc directly. The result is initialized at the precision of mmqlc and
+ * is only written to, with the mpfr_set family, rounding to nearest. The operands and the result must not be
+ * reallocated (no mpfr_set_prec, mpfr_clear or mpfr_swap), so a plugin has to link the same shared MPFR and GMP as
+ * mmqlc. The functions are called from several worker threads at a time, they must be reentrant.
+ */
+
+#include <mpfr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The version of this interface, a plugin built against another version is refused. */
+#define MMQLC_PLUGIN_ABI_VERSION 1u
+
+/* The domain of an operand, a combination of these flags. mmqlc checks it before calling the function, for every
+ * element of a batch, and answers the query with a domain error when an operand is outside of it. The flags other
+ * than MMQLC_DOMAIN_NONZERO also require a complex operand to be real. */
+#define MMQLC_DOMAIN_ANY 0u
+#define MMQLC_DOMAIN_NONZERO 1u
+#define MMQLC_DOMAIN_POSITIVE 2u
+#define MMQLC_DOMAIN_NONNEGATIVE 4u
+#define MMQLC_DOMAIN_INTEGER 8u
+
+typedef enum mmqlc_kind {
+    MMQLC_REAL = 0,
+    MMQLC_COMPLEX = 1
+} mmqlc_kind;
+
+/* Writes f(operands[0]) or f(operands[0], operands[1]) into result. Returns 0, or nonzero when the operands are
+ * outside the domain of the function in a way the domain flags cannot express. */
+typedef int (*mmqlc_real_function)(mpfr_ptr result, const mpfr_srcptr *operands);
+
+/* The complex counterpart, every number is given by its real and imaginary parts. */
+typedef int (*mmqlc_complex_function)(mpfr_ptr result_real, mpfr_ptr result_imaginary,
+                                      const mpfr_srcptr *operands_real, const mpfr_srcptr *operands_imaginary);
+
+typedef struct mmqlc_function {
+    const char *name;               /* the keyword, upper case letters, digits and underscores */
+    unsigned arity;                 /* 1 or 2 */
+    mmqlc_kind kind;
+    mmqlc_real_function real;       /* set when kind is MMQLC_REAL */
+    mmqlc_complex_function complex; /* set when kind is MMQLC_COMPLEX */
+    unsigned domain[2];             /* the domain flags of each operand */
+    const char *description;        /* one line, may be NULL */
+} mmqlc_function;
+
+typedef struct mmqlc_host {
+    unsigned abi_version;
+    void *context;
+    /* Copies the function into the registry of mmqlc. Returns 0, or nonzero when the function is refused: a
+     * malformed name or arity, a missing function, or a name already registered for the same kind. */
+    int (*register_function)(void *context, const mmqlc_function *function);
+} mmqlc_host;
+
+typedef unsigned (*mmqlc_plugin_abi_version_function)(void);
+typedef int (*mmqlc_plugin_init_function)(const mmqlc_host *host);
+
+#define MMQLC_PLUGIN_ABI_VERSION_SYMBOL "mmqlc_plugin_abi_version"
+#define MMQLC_PLUGIN_INIT_SYMBOL "mmqlc_plugin_init"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MMQLC_PLUGIN_H */
@@ -0,0 +1,109 @@
+#include "../mmqlc_plugin.h"
+
+/**
+ * A sample plugin, built as a shared object next to mmqlc. Load it with
+ * @code mmqlc --plugin path/to/libmmqlc_sample_plugin.so @endcode and query
+ * @code SINC 0.5 @endcode @code HERMITE 3,0.5 @endcode @code JOUKOWSKI 1+1i @endcode
+ * or the same keywords over batches, e.g. @code SINC [0:1:0.25] @endcode
+ */
+namespace {
+    // the largest degree of HERMITE, the recurrence takes a step per degree.
+    constexpr unsigned long largest_degree{100000};
+
+    /**
+     * @brief sin(x)/x, 1 at zero.
+     */
+    int sinc(mpfr_ptr result, const mpfr_srcptr *operands) {
+        const mpfr_srcptr x{operands[0]};
+        if (mpfr_zero_p(x)) {
+            mpfr_set_ui(result, 1, MPFR_RNDN);
+            return 0;
+        }
+        mpfr_sin(result, x, MPFR_RNDN);
+        mpfr_div(result, result, x, MPFR_RNDN);
+        return 0;
+    }
+
+    /**
+     * @brief The physicists' Hermite polynomial of degree n at x, by the three-term recurrence
+     * @code H(k+1) = 2x H(k) - 2k H(k-1) @endcode
+     */
+    int hermite(mpfr_ptr result, const mpfr_srcptr *operands) {
+        if (mpfr_cmp_ui(operands[0], largest_degree) > 0)
+            return 1;
+        const unsigned long degree{mpfr_get_ui(operands[0], MPFR_RNDN)};
+        const mpfr_srcptr x{operands[1]};
+        mpfr_set_ui(result, 1, MPFR_RNDN);
+        if (degree == 0)
+            return 0;
+        // the recurrence runs on temporaries, the result is only written to at the end.
+        mpfr_t terms[3];
+        for (mpfr_t &term: terms)
+            mpfr_init2(term, mpfr_get_prec(result));
+        mpfr_ptr previous{terms[0]}, current{terms[1]}, next{terms[2]};
+        mpfr_set_ui(previous, 1, MPFR_RNDN); // H(0)
+        mpfr_mul_ui(current, x, 2, MPFR_RNDN); // H(1)
+        for (unsigned long k = 1; k < degree; ++k) {
+            mpfr_mul(next, current, x, MPFR_RNDN);
+            mpfr_mul_ui(next, next, 2, MPFR_RNDN);
+            mpfr_mul_ui(previous, previous, 2 * k, MPFR_RNDN);
+            mpfr_sub(next, next, previous, MPFR_RNDN);
+            const mpfr_ptr free_term{previous};
+            previous = current;
+            current = next;
+            next = free_term;
+        }
+        mpfr_set(result, current, MPFR_RNDN);
+        for (mpfr_t &term: terms)
+            mpfr_clear(term);
+        return 0;
+    }
+
+    /**
+     * @brief The Joukowski map z + 1/z, defined for a nonzero z.
+     */
+    int joukowski(mpfr_ptr result_real, mpfr_ptr result_imaginary,
+                  const mpfr_srcptr *operands_real, const mpfr_srcptr *operands_imaginary) {
+        const mpfr_srcptr a{operands_real[0]};
+        const mpfr_srcptr b{operands_imaginary[0]};
+        mpfr_t norm, part;
+        mpfr_init2(norm, mpfr_get_prec(result_real));
+        mpfr_init2(part, mpfr_get_prec(result_real));
+        mpfr_sqr(norm, a, MPFR_RNDN);
+        mpfr_sqr(part, b, MPFR_RNDN);
+        mpfr_add(norm, norm, part, MPFR_RNDN);
+        // 1/z = (a - bi)/(a^2 + b^2)
+        mpfr_div(part, a, norm, MPFR_RNDN);
+        mpfr_add(result_real, a, part, MPFR_RNDN);
+        mpfr_div(part, b, norm, MPFR_RNDN);
+        mpfr_sub(result_imaginary, b, part, MPFR_RNDN);
+        mpfr_clear(norm);
+        mpfr_clear(part);
+        return 0;
+    }
+}
+
+extern "C" {
+#if WIN32
+__declspec(dllexport)
+#endif
+unsigned mmqlc_plugin_abi_version(void) { return MMQLC_PLUGIN_ABI_VERSION; }
+
+#if WIN32
+__declspec(dllexport)
+#endif
+int mmqlc_plugin_init(const mmqlc_host *host) {
+    const mmqlc_function functions[]{
+        {"SINC", 1, MMQLC_REAL, sinc, nullptr, {MMQLC_DOMAIN_ANY, MMQLC_DOMAIN_ANY}, "sin(x)/x"},
+        {
+            "HERMITE", 2, MMQLC_REAL, hermite, nullptr,
+            {MMQLC_DOMAIN_NONNEGATIVE | MMQLC_DOMAIN_INTEGER, MMQLC_DOMAIN_ANY}, "Hermite polynomial H(n, x)"
+        },
+        {"JOUKOWSKI", 1, MMQLC_COMPLEX, nullptr, joukowski, {MMQLC_DOMAIN_NONZERO, MMQLC_DOMAIN_ANY}, "z + 1/z"},
+    };
+    for (const mmqlc_function &function: functions)
+        if (host->register_function(host->context, &function) != 0)
+            return 1;
+    return 0;
+}
+}
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../core/Core.hpp"
+#include "../core/helpers/arena.hpp"
+#include "check.hpp"
+
+/**
+ * Warm queries allocate nothing. Every query shape is evaluated until its free lists are warm, then evaluated once
+ * more: the arenas must not call malloc for the limbs of its numbers, and, for the shapes answered with a single
+ * number kept as a value, nothing may call operator new either. The answers are kept as values without their text:
+ * the answer strings are the output of a query, not a part of its evaluation, and so are the vector a batch is
+ * answered with and the text of an exact answer, which is never kept as a value.
+ */
+namespace {
+    std::atomic<std::uint64_t> new_calls{0};
+
+    // out of line, so that the compiler does not pair the free of a block with the operator new that allocated it.
+    [[gnu::noinline]] void release(void *block) noexcept { std::free(block); }
+}
+
+void *operator new(const std::size_t size) {
+    new_calls.fetch_add(1, std::memory_order_relaxed);
+    if (void *block{std::malloc(size == 0 ? 1 : size)}; block != nullptr)
+        return block;
+    throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size) { return ::operator new(size); }
+void operator delete(void *block) noexcept { release(block); }
+void operator delete[](void *block) noexcept { release(block); }
+void operator delete(void *block, std::size_t) noexcept { ::operator delete(block); }
+void operator delete[](void *block, std::size_t) noexcept { ::operator delete[](block); }
+
+namespace {
+    using mmqli::tests::check;
+
+    // a few kernels (the gamma of FACTORIAL) still fill their free lists on their second evaluation.
+    constexpr int warm_up_rounds{2};
+
+    struct Shape {
+        std::string name;
+        std::function<mmqli::core::Core()> make; // the Core is made outside of the measurement
+        bool value; // answered with a single number kept as a value, the evaluation must not call operator new
+    };
+
+    void measure(const Shape &shape) {
+        const auto evaluate{
+            [&] {
+                mmqli::core::Core core{shape.make()};
+                core.keep_values(false);
+                const std::uint64_t system_before{mmqli::core::arena::system_calls()};
+                const std::uint64_t new_before{new_calls.load(std::memory_order_relaxed)};
+                const auto results{core.evaluate()};
+                const std::uint64_t system_calls{mmqli::core::arena::system_calls() - system_before};
+                const std::uint64_t allocations{new_calls.load(std::memory_order_relaxed) - new_before};
+                check(results.size() == 1 && results.front().has_value(), shape.name + " is answered");
+                return std::pair{system_calls, allocations};
+            }
+        };
+        for (int i = 0; i < warm_up_rounds; ++i)
+            evaluate();
+        const auto [system_calls, allocations]{evaluate()};
+        check(system_calls == 0, shape.name + " made " + std::to_string(system_calls) + " arena system calls");
+        if (shape.value)
+            check(allocations == 0, shape.name + " made " + std::to_string(allocations) + " calls to operator new");
+    }
+
+    Shape real(const std::string &query, const double first, const double second) {
+        return {"Real/" + query, [=] {
+            return mmqli::core::Core{{{query, float1000{first}, float1000{second}}}, {}};
+        }, true};
+    }
+
+    Shape complex(const std::string &query) {
+        return {"Complex/" + query, [=] {
+            return mmqli::core::Core{{}, {{query, complex1000{float1000{0.5}, float1000{0.25}},
+                                           complex1000{float1000{1.5}, float1000{-0.75}}}}};
+        }, true};
+    }
+
+    Shape exact(const std::string &query, const long first, const long second) {
+        return {"Exact/" + query, [=] {
+            return mmqli::core::Core{{}, {}, {}, {}, {}, {}, {}, {{query, mpq_class{first}, mpq_class{second}}}};
+        }, false};
+    }
+
+    Shape batch(const std::string &query) {
+        return {"RealBatch/" + query, [=] {
+            std::vector<float1000> operands(64);
+            for (std::size_t i = 0; i < operands.size(); ++i)
+                operands[i] = float1000{i};
+            return mmqli::core::Core{{}, {}, {{query, std::move(operands), {}}}};
+        }, false};
+    }
+}
+
+int main() {
+    mmqli::core::arena::install();
+    for (const Shape &shape: {
+             real("ADD", 1.5, 2.5), real("SINE", 30, 0), real("COTANGENT", 30, 0), real("FACTORIAL", 20, 0),
+             real("NATURAL_LOGARITHM", 2.5, 0), real("POWER", 1.5, 7), complex("MULTIPLY"), complex("SINE"),
+             exact("ADD", 1234567890123, 987654321), exact("POWER", 3, 200), batch("SINE"), batch("SUM")
+         })
+        measure(shape);
+    return mmqli::tests::finish();
+}
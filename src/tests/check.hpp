@@ -0,0 +1,30 @@
+#ifndef MMQLC_TESTS_CHECK_HPP
+#define MMQLC_TESTS_CHECK_HPP
+
+#include <cstdio>
+#include <string>
+
+/**
+ * The checks of the tests. A test is a plain executable run by ctest: every failed check is reported with its
+ * message, and the test fails when any check did, after running all of them.
+ */
+namespace mmqli::tests {
+    inline int failures{0};
+
+    inline void check(const bool passed, const std::string &message) {
+        if (passed)
+            return;
+        ++failures;
+        std::fprintf(stderr, "FAILED: %s\n", message.c_str());
+    }
+
+    /**
+     * The exit code of the test, returned by its main.
+     */
+    inline int finish() {
+        if (failures != 0)
+            std::fprintf(stderr, "%d checks failed\n", failures);
+        return failures == 0 ? 0 : 1;
+    }
+} // namespace mmqli::tests
+#endif // MMQLC_TESTS_CHECK_HPP
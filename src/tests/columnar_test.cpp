@@ -0,0 +1,62 @@
+#include <array>
+#include <string>
+#include "../core/helpers/columnar.hpp"
+#include "check.hpp"
+
+/**
+ * The rows of the map mode. A first line none of whose columns is a number is a header; a first line with a number in
+ * one column is a row of data, and is refused like any other row when another column is not a number or is missing,
+ * at the column at fault.
+ */
+namespace {
+    using mmqli::tests::check;
+    namespace Columnar = mmqli::core::columnar;
+    namespace Errors = mmqli::core::error;
+
+    Errors::Result<bool> read(const std::string &map, const std::size_t line, const std::string &row,
+                              std::array<float1000, 2> &operands) {
+        const auto pattern{Columnar::parse_template(map)};
+        check(pattern.has_value(), map + " is a template");
+        std::string scratch;
+        return Columnar::read_row(*pattern, line, row, ',', operands, scratch);
+    }
+
+    void header(const std::string &map, const std::string &row) {
+        std::array<float1000, 2> operands{};
+        const auto read_row{read(map, 1, row, operands)};
+        check(read_row && !*read_row, row + " is the header of " + map);
+    }
+
+    void data(const std::string &map, const std::size_t line, const std::string &row, const double first,
+              const double second) {
+        std::array<float1000, 2> operands{};
+        const auto read_row{read(map, line, row, operands)};
+        check(read_row && *read_row && operands[0] == first && operands[1] == second,
+              row + " on line " + std::to_string(line) + " holds the operands of " + map);
+    }
+
+    void refused(const std::string &map, const std::size_t line, const std::string &row, const std::size_t column) {
+        std::array<float1000, 2> operands{};
+        const auto read_row{read(map, line, row, operands)};
+        check(!read_row && read_row.error().code == Errors::Code::invalid_number &&
+              read_row.error().where.query == line && read_row.error().where.column == column,
+              row + " on line " + std::to_string(line) + " is refused at column " + std::to_string(column) + ", " +
+              (read_row ? std::string{"it was read"} : Errors::describe(read_row.error())));
+    }
+}
+
+int main() {
+    header("ADD $1,$2", "a,b");
+    header("ADD $1,$2", "a");
+    header("ADD $1,4", "first");
+    data("ADD $1,$2", 1, "1.5,2", 1.5, 2);
+    data("ADD $2,4", 1, "x,3", 3, 4);
+
+    // a file without a header whose first row is malformed loses no row.
+    refused("ADD $1,$2", 1, "x,2", 1);
+    refused("ADD $1,$2", 1, "1,y", 3);
+    refused("ADD $1,$2", 1, "1", 0); // $2 is missing
+    refused("ADD $1,$2", 2, "a,b", 1);
+    refused("ADD $1,$2", 7, "1,,", 3);
+    return mmqli::tests::finish();
+}
@@ -0,0 +1,98 @@
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../core/helpers/ziv.hpp"
+#include "../vresolver/VResolver.hpp"
+#include "check.hpp"
+
+/**
+ * Concurrent sessions answer like a single one. Every thread runs sessions of its own through the whole pipeline,
+ * variables included, and compares its answers with the ones of the main thread, so a data race shows up as a wrong
+ * answer, or as a report of ThreadSanitizer in a build configured with MMQLC_SANITIZE_THREAD (the tsan preset). Every
+ * thread also asks for its own number of digits, which its adaptive queries have to honour.
+ */
+namespace {
+    using mmqli::tests::check;
+
+    const std::vector<std::string> definitions{
+        "SET x = SINE 30", "SET y = 2.5", "SET z = 1+2i", "SET v = [1,2,3,4]", "SET w = ADD x,y"
+    };
+
+    // a line of every kind of query, the batch and the integral run parallel regions of their own.
+    const std::vector<std::string> lines{
+        "ADD x,w", "MULTIPLY z,z", "SUM v", "COMBINATION 40,20", "SINE [0:360:1]", "DET [[2,1],[1,3]]",
+        "NATURAL_LOGARITHM 2.5", "SINE 1+2i", "INTEGRATE SINE,[0,90]"
+    };
+
+    constexpr std::size_t rounds{3}; // sessions per thread
+
+    // the answers of a session, the way the interpreter computes them.
+    std::vector<std::string> run_session() {
+        const auto variables{find_and_resolve_vars(definitions)};
+        if (!variables)
+            return {};
+        std::vector<std::string> answers;
+        for (const std::string &line: lines) {
+            Parser parser(tokenize({line}, *variables));
+            mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums(), parser.parse_RealBatches(),
+                                   parser.parse_cmplxBatches(), parser.parse_RealMatrices(),
+                                   parser.parse_cmplxMatrices(), parser.parse_PointSets(),
+                                   parser.parse_ExactNums());
+            for (auto &result: core.evaluate())
+                answers.push_back(result ? std::move(*result) : mmqli::core::error::describe(result.error()));
+        }
+        return answers;
+    }
+
+    // whether an adaptive query answers with the digits of its thread.
+    bool honours_digits(const std::size_t digits) {
+        const mmqli::core::ziv::ThreadDigits scope{digits};
+        Parser parser(tokenize({"NATURAL_LOGARITHM 2.5"}));
+        mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums());
+        const auto answers{core.evaluate()};
+        // "NATURAL_LOGARITHM 2.5 = 0." followed by the digits and a newline
+        return answers.size() == 1 && answers[0] && answers[0]->size() - answers[0]->find('=') - 5 == digits;
+    }
+
+    // runs body on every one of threads threads, and tells which of them it succeeded on.
+    template<typename Body>
+    std::vector<char> on_threads(const std::size_t threads, const Body &body) {
+        std::vector<char> passed(threads, 0);
+        std::vector<std::jthread> workers;
+        workers.reserve(threads);
+        for (std::size_t thread = 0; thread < threads; ++thread)
+            workers.emplace_back([&, thread] { passed[thread] = body(thread); });
+        workers.clear();
+        return passed;
+    }
+}
+
+int main() {
+    const std::vector<std::string> expected{run_session()};
+    check(expected.size() == lines.size(), "the reference session answers every line");
+    for (const std::size_t threads: {2, 4, 8, 16}) {
+        const auto sessions{
+            on_threads(threads, [&](std::size_t) {
+                for (std::size_t round = 0; round < rounds; ++round)
+                    if (run_session() != expected)
+                        return false;
+                return true;
+            })
+        };
+        const auto digits{
+            on_threads(threads, [](const std::size_t thread) {
+                for (std::size_t round = 0; round < rounds; ++round)
+                    if (!honours_digits(20 + 10 * thread))
+                        return false;
+                return true;
+            })
+        };
+        for (std::size_t thread = 0; thread < threads; ++thread) {
+            const std::string where{" on thread " + std::to_string(thread) + " of " + std::to_string(threads)};
+            check(sessions[thread] != 0, "a session answered differently than on a single thread" + where);
+            check(digits[thread] != 0, "an adaptive query ignored the digits of its thread" + where);
+        }
+    }
+    return mmqli::tests::finish();
+}
@@ -0,0 +1,64 @@
+#include <cstddef>
+#include <string>
+#include "../core/helpers/ziv.hpp"
+#include "../vresolver/VResolver.hpp"
+#include "check.hpp"
+
+/**
+ * The digits of the adaptive queries past the precision of float1000. The operands are read again from the literals
+ * they are written with at every working precision, so 0.1 is 1/10 to any number of digits and not its float1000
+ * rounding, which parts from it after about a thousand digits.
+ */
+namespace {
+    using mmqli::tests::check;
+
+    constexpr std::size_t digits{1500}; // above std::numeric_limits<float1000>::digits10
+
+    // the answer of line, the way the interpreter computes it.
+    std::string answer(const std::string &line) {
+        const mmqli::core::ziv::ThreadDigits scope{digits};
+        Parser parser(tokenize({line}));
+        mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums(), parser.parse_RealBatches(),
+                               parser.parse_cmplxBatches(), parser.parse_RealMatrices(), parser.parse_cmplxMatrices(),
+                               parser.parse_PointSets(), parser.parse_ExactNums());
+        core.locate(parser.parse_Sources());
+        const auto results{core.evaluate()};
+        if (results.size() != 1)
+            return std::to_string(results.size()) + " results";
+        return results[0] ? *results[0] : mmqli::core::error::describe(results[0].error());
+    }
+
+    // the digits of the answer of line, after its " = ".
+    std::string value(const std::string &line) {
+        std::string text{answer(line)};
+        const std::size_t equals{text.find(" = ")};
+        if (equals == std::string::npos || !text.ends_with('\n'))
+            return text;
+        return text.substr(equals + 3, text.size() - equals - 4);
+    }
+
+    void answers(const std::string &line, const std::string &expected) {
+        const std::string found{value(line)};
+        check(found == expected, line + " answered " + found.substr(0, 80) + "...");
+    }
+}
+
+int main() {
+    const std::string three_tenths{"0.3" + std::string(digits - 1, '0')};
+    check(std::numeric_limits<float1000>::digits10 < digits, "the digits are past the ones of float1000");
+    answers("ADD 0.1,0.2", three_tenths);
+    answers("SUBTRACT 0.5,0.2", three_tenths);
+    answers("MULTIPLY 0.1,3", three_tenths);
+    answers("DIVIDE 0.9,3", three_tenths);
+    answers("MODULO 0.7,0.4", three_tenths);
+    answers("SUBTRACT 0.1,0.1", "0");
+    answers("MODULO 0.3,0.1", "0");
+    // a rational operand is read as written too, in a real query and in an exact one that has no exact answer.
+    const std::string root{value("ROOT 0.1,2")};
+    answers("POWER 1/10,0.5", root);
+    answers("POWER 1/10,1/2", root);
+    // 0.1 is enclosed at every working precision, ln(0.1) is -ln(10) to the last digit.
+    answers("NATURAL_LOGARITHM 0.1", "-" + value("NATURAL_LOGARITHM 10"));
+    answers("POWER 0.1,2", "0.01" + std::string(digits - 1, '0'));
+    return mmqli::tests::finish();
+}
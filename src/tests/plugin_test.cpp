@@ -0,0 +1,104 @@
+#include <string>
+#include <vector>
+#include "../core/helpers/plugins.hpp"
+#include "../vresolver/VResolver.hpp"
+#include "check.hpp"
+
+#if !WIN32
+#include <dlfcn.h>
+#endif
+
+/**
+ * The plugins, end to end. The sample plugin is loaded through plugins::load and its functions are dispatched through
+ * the whole pipeline like the built-in ones: their answers, an operand outside of their domain, a call with the wrong
+ * number of operands. The plugins built for another version of the interface, or registering a name that is taken,
+ * are refused, register nothing and are closed again.
+ *
+ * Usage: plugin_test <sample plugin> <plugin of another interface> <plugin registering SINC again>
+ */
+namespace {
+    using mmqli::tests::check;
+    namespace Errors = mmqli::core::error;
+    namespace Plugins = mmqli::core::plugins;
+
+    // the result of a line of one query, the way the interpreter evaluates it.
+    Errors::Result<std::string> answer(const std::string &line) {
+        Parser parser(tokenize({line}));
+        mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums(), parser.parse_RealBatches(),
+                               parser.parse_cmplxBatches(), parser.parse_RealMatrices(), parser.parse_cmplxMatrices(),
+                               parser.parse_PointSets(), parser.parse_ExactNums());
+        auto results{core.evaluate()};
+        if (results.size() != 1)
+            return Errors::fail(Errors::Code::syntax, std::to_string(results.size()) + " results");
+        return std::move(results.front());
+    }
+
+    void answers(const std::string &line, const std::string &expected) {
+        const auto result{answer(line)};
+        check(result && *result == line + " = " + expected + "\n",
+              line + " answered " + (result ? *result : Errors::describe(result.error())));
+    }
+
+    void fails(const std::string &line, const Errors::Code code) {
+        const auto result{answer(line)};
+        check(!result && result.error().code == code,
+              line + " answered " + (result ? *result : Errors::describe(result.error())));
+    }
+
+    void fails(const std::string &line) {
+        const auto result{answer(line)};
+        check(!result, line + " answered " + (result ? *result : std::string{}));
+    }
+
+    // whether the library at path is still mapped into the process.
+    bool mapped(const std::string &path) {
+#if WIN32
+        return GetModuleHandleA(path.c_str()) != nullptr;
+#else
+        void *library{dlopen(path.c_str(), RTLD_NOW | RTLD_NOLOAD)};
+        if (library == nullptr)
+            return false;
+        dlclose(library);
+        return true;
+#endif
+    }
+
+    void refused(const std::string &path, const std::string &reason) {
+        const auto loaded{Plugins::load(path)};
+        check(!loaded && loaded.error().code == Errors::Code::plugin, path + " is refused, " + reason);
+        check(Plugins::find("REFUSED_IDENTITY", Plugins::Kind::real) == nullptr,
+              path + " registered nothing, " + reason);
+        check(!mapped(path), path + " is closed, " + reason);
+    }
+}
+
+int main(const int argc, const char *argv[]) {
+    if (argc != 4) {
+        check(false, "plugin_test takes the paths of the sample plugin and of the two refused plugins");
+        return mmqli::tests::finish();
+    }
+    const std::string sample{argv[1]};
+    const auto loaded{Plugins::load(sample)};
+    check(loaded && *loaded == 3, "the sample plugin registers SINC, HERMITE and JOUKOWSKI");
+    check(mapped(sample), "the sample plugin stays loaded");
+
+    answers("SINC 0", "1");
+    float1000 sinc{0.5};
+    mpfr_sin(sinc.backend().data(), sinc.backend().data(), MPFR_RNDN);
+    sinc *= 2;
+    answers("SINC 0.5", mmqli::core::Core::to_str(sinc));
+    answers("HERMITE 3,0.5", "-5"); // 8x^3 - 12x
+    answers("JOUKOWSKI 1+1i", "1.5+0.5i"); // z + (a - bi) / (a^2 + b^2)
+    answers("SINC [0,0]", "[1,1]");
+
+    fails("HERMITE -1,0.5", Errors::Code::domain);
+    fails("HERMITE 2.5,0.5", Errors::Code::domain);
+    fails("HERMITE 200000,0.5", Errors::Code::domain); // above the largest degree, refused by the function
+    fails("JOUKOWSKI 0+0i", Errors::Code::domain);
+    fails("SINC 1,2");
+    fails("HERMITE 3");
+
+    refused(argv[2], "built for another interface");
+    refused(argv[3], "registering SINC again");
+    return mmqli::tests::finish();
+}
@@ -0,0 +1,59 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "../vresolver/VResolver.hpp"
+#include "check.hpp"
+
+/**
+ * The errors of the evaluation are reported where their query is written. The queries of every kind are evaluated
+ * kind by kind, in another order than they are written, and the error of each of them carries the index of its query
+ * in the source and the column of its first operand, not the index of its result.
+ */
+namespace {
+    using mmqli::tests::check;
+    namespace Errors = mmqli::core::error;
+
+    struct Expected {
+        std::size_t query;
+        std::size_t column;
+    };
+
+    const std::vector<std::string> queries{
+        "ADD 1,2",                       // answered
+        "DIVIDE [1,2],[0,1]",            // real batch
+        "DIVIDE 1+1i,0+0i",              // complex
+        "INVERSE [[1,2],[2,4]]",         // real matrix
+        "DIVIDE 1.5,0",                  // real
+        "DIVIDE [1+1i,2],[0+0i,1]",      // complex batch
+        "INVERSE [[1+1i,2],[2+2i,4]]",   // complex matrix
+        "DET [[1,2]]",                   // real matrix
+        "MULTIPLY 2,3",                  // answered
+    };
+
+    const std::vector<Expected> failing{{1, 8}, {2, 8}, {3, 9}, {4, 8}, {5, 8}, {6, 9}, {7, 5}};
+}
+
+int main() {
+    Parser parser(tokenize(queries));
+    check(parser.parse_Errors().empty(), "every query is parsed");
+    mmqli::core::Core core(parser.parse_RealNums(), parser.parse_cmplxNums(), parser.parse_RealBatches(),
+                           parser.parse_cmplxBatches(), parser.parse_RealMatrices(), parser.parse_cmplxMatrices(),
+                           parser.parse_PointSets(), parser.parse_ExactNums());
+    core.locate(parser.parse_Sources());
+    const auto results{core.evaluate()};
+    check(results.size() == queries.size(), "every query is answered");
+
+    std::vector<Errors::Position> errors;
+    for (const auto &result: results)
+        if (!result)
+            errors.push_back(result.error().where);
+    check(errors.size() == failing.size(), std::to_string(errors.size()) + " queries failed");
+    for (const auto &[query, column]: failing) {
+        bool found{false};
+        for (const auto &where: errors)
+            found = found || (where.query == query && where.column == column);
+        check(found, queries[query] + " fails at query " + std::to_string(query) + ", column " +
+                     std::to_string(column));
+    }
+    return mmqli::tests::finish();
+}
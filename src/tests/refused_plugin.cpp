@@ -0,0 +1,40 @@
+#include "../plugins/mmqlc_plugin.h"
+
+/**
+ * The plugins plugin_test expects mmqlc to refuse, built from this file twice: with MMQLC_REFUSED_ABI it is built for
+ * another version of the plugin interface, with MMQLC_REFUSED_DUPLICATE it registers SINC, which the sample plugin
+ * registers first.
+ */
+namespace {
+    int identity(mpfr_ptr result, const mpfr_srcptr *operands) {
+        mpfr_set(result, operands[0], MPFR_RNDN);
+        return 0;
+    }
+}
+
+extern "C" {
+#if WIN32
+__declspec(dllexport)
+#endif
+unsigned mmqlc_plugin_abi_version(void) {
+#ifdef MMQLC_REFUSED_ABI
+    return MMQLC_PLUGIN_ABI_VERSION + 1;
+#else
+    return MMQLC_PLUGIN_ABI_VERSION;
+#endif
+}
+
+#if WIN32
+__declspec(dllexport)
+#endif
+int mmqlc_plugin_init(const mmqlc_host *host) {
+    const mmqlc_function functions[]{
+        {"REFUSED_IDENTITY", 1, MMQLC_REAL, identity, nullptr, {MMQLC_DOMAIN_ANY, MMQLC_DOMAIN_ANY}, "x"},
+        {"SINC", 1, MMQLC_REAL, identity, nullptr, {MMQLC_DOMAIN_ANY, MMQLC_DOMAIN_ANY}, "x"},
+    };
+    for (const mmqlc_function &function: functions)
+        if (host->register_function(host->context, &function) != 0)
+            return 1;
+    return 0;
+}
+}
@@ -3,59 +3,78 @@
 
 #include "../core/Core.hpp"
 
-inline std::unordered_map<std::string, std::string> find_and_resolve_vars(
+/**
+ * Resolves the variable definitions of @p queries on top of @p varMAP. A definition whose query cannot be evaluated
+ * yields its error, at the index of the definition and the column in the definition, and nothing is resolved.
+ */
+inline mmqli::core::error::Result<std::unordered_map<std::string, std::string> > find_and_resolve_vars(
     const std::vector<std::string> &queries, const std::unordered_map<std::string, std::string> &varMAP = {}) {
+    namespace Errors = mmqli::core::error;
     std::unordered_map<std::string, std::string> resolvedVarMap = varMAP;
     std::smatch matches;
-    auto resolveVarS = [&](const std::string &varQuery) {
-        // resolves variables with simple queries.
-        const auto varToken = tokenize({varQuery});
-        const auto varParse = std::make_unique<Parser>(varToken);
-        const auto varResolved = std::make_unique<Core>(varParse->parse_RealNums(),
-                                                        varParse->parse_cmplxNums());
-        std::string res = varResolved->calculateAnswers()[0];
-        if (const size_t pos = res.find('='); pos != std::string::npos) {
-            res = res.substr(pos + 2);
-            res.pop_back(); // remove newline character at the end !.
-        }
-        return res;
-    };
-    auto resolveVarQ = [&](const std::string &varQuery, const std::unordered_map<std::string, std::string> &varMap) {
+    auto resolveVarQ = [&](const std::string &varQuery,
+                           const std::unordered_map<std::string, std::string> &varMap) -> Errors::Result<std::string> {
         // resolves variables with query involving variables
-        const auto varToken = tokenize({varQuery}, varMap);
-        const auto varParse = std::make_unique<Parser>(varToken);
-        const auto varResolved = std::make_unique<Core>(varParse->parse_RealNums(),
-                                                        varParse->parse_cmplxNums());
-        std::string res = varResolved->calculateAnswers()[0];
+        Parser varParse(tokenize({varQuery}, varMap));
+        if (auto errors = varParse.parse_Errors(); !errors.empty())
+            return std::unexpected{std::move(errors.front())};
+        mmqli::core::Core varResolved(varParse.parse_RealNums(), varParse.parse_cmplxNums(),
+                                      varParse.parse_RealBatches(), varParse.parse_cmplxBatches(),
+                                      varParse.parse_RealMatrices(), varParse.parse_cmplxMatrices(),
+                                      varParse.parse_PointSets(), varParse.parse_ExactNums());
+        varResolved.locate(varParse.parse_Sources());
+        auto answers = varResolved.evaluate();
+        if (answers.empty())
+            return Errors::fail(Errors::Code::syntax, "Syntax Fault: MmQLC failed to process " + varQuery);
+        if (!answers[0])
+            return std::unexpected{std::move(answers[0].error())};
+        std::string res = std::move(*answers[0]);
         if (const size_t pos = res.find('='); pos != std::string::npos) {
             res = res.substr(pos + 2);
             res.pop_back(); // remove newline character at the end !.
         }
         return res;
     };
-    for (const auto &q: queries) {
+    auto resolveVarS = [&](const std::string &varQuery) {
+        // resolves variables with simple queries.
+        return resolveVarQ(varQuery, {});
+    };
+    for (std::size_t index = 0; index < queries.size(); ++index) {
+        const std::string &q = queries[index];
         if (q.rfind("SET", 0) != 0)
             continue;
+        // the error of a query of a definition, placed in the definition.
+        auto located = [&](Errors::Error error) {
+            error.where.query = index;
+            if (error.where.column != 0)
+                error.where.column += static_cast<std::size_t>(matches.position(2));
+            return std::unexpected{std::move(error)};
+        };
+        Errors::Result<std::string> varValue;
         if (std::regex_match(q, matches, grammar::variables::realVar) || std::regex_match(
                 q, matches, grammar::variables::complexVar)) {
-            resolvedVarMap[matches[1].str()] = matches[2].str();
+            varValue = matches[2].str();
         } else if (std::regex_match(q, matches, grammar::variables::realVarS) || std::regex_match(
                        q, matches, grammar::variables::complexVarS)) {
-            const std::string varName = matches[1].str();
-            const std::string varValue = resolveVarS(matches[2].str());
-            resolvedVarMap[varName] = varValue;
+            varValue = resolveVarS(matches[2].str());
         } else if (std::regex_match(q, matches, grammar::variables::realVarD) || std::regex_match(
                        q, matches, grammar::variables::complexVarD)) {
-            const std::string varName = matches[1].str();
-            const std::string varValue = resolveVarS(matches[2].str());
-            resolvedVarMap[varName] = varValue;
+            varValue = resolveVarS(matches[2].str());
         } else if (std::regex_match(q, matches, grammar::variables::QueryVarS) || std::regex_match(
                        q, matches, grammar::variables::QueryVarD)) {
-            const std::string varName = matches[1].str();
-            const std::string varValue = resolveVarQ(matches[2].str(), resolvedVarMap);
-            resolvedVarMap[varName] = varValue;
+            varValue = resolveVarQ(matches[2].str(), resolvedVarMap);
+        } else if (std::regex_match(q, matches, grammar::variables::literalVar)) {
+            // lists, vectors and matrices are stored as their literal and substituted by the lexer.
+            std::string literal = matches[2].str();
+            std::erase_if(literal, [](const unsigned char c) { return std::isspace(c); });
+            varValue = std::move(literal);
+        } else if (std::regex_match(q, matches, grammar::variables::literalQueryVar)) {
+            varValue = resolveVarS(matches[2].str());
         } else
-            throw std::runtime_error("\nError:Variable rules violated !");
+            return Errors::fail(Errors::Code::syntax, "Variable rules violated !", {index, 1});
+        if (!varValue)
+            return located(std::move(varValue.error()));
+        resolvedVarMap[matches[1].str()] = std::move(*varValue);
     }
     return resolvedVarMap;
 }